@@ -0,0 +1,581 @@
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Network.hpp>
+#include <algorithm>
+#include <cstdlib>
+#include <iostream>
+#include <string>
+#include <vector>
+
+
+////////////////////////////////////////////////////////////
+/// Print a result as a line of comma-separated values
+///
+////////////////////////////////////////////////////////////
+void report(const std::string& benchmark, const std::string& metric, double value, const std::string& unit)
+{
+    std::cout << benchmark << ',' << metric << ',' << value << ',' << unit << std::endl;
+}
+
+
+////////////////////////////////////////////////////////////
+/// Compute a rate from a count and a duration
+///
+////////////////////////////////////////////////////////////
+double rate(double count, sf::Time duration)
+{
+    return count / std::max(duration.asSeconds(), 1e-6f);
+}
+
+
+////////////////////////////////////////////////////////////
+/// Get a percentile of a set of samples, in microseconds
+///
+////////////////////////////////////////////////////////////
+double percentile(std::vector<sf::Int64>& samples, double ratio)
+{
+    std::size_t index = static_cast<std::size_t>(ratio * (samples.size() - 1));
+    std::nth_element(samples.begin(), samples.begin() + index, samples.end());
+    return static_cast<double>(samples[index]);
+}
+
+
+////////////////////////////////////////////////////////////
+/// State of a game entity, typical of what games send
+///
+////////////////////////////////////////////////////////////
+struct Entity
+{
+    sf::Uint32  id;
+    float       x, y, z;
+    sf::Int16   angle;
+    bool        visible;
+    std::string name;
+};
+
+std::vector<Entity> makeEntities(std::size_t count)
+{
+    std::vector<Entity> entities(count);
+    for (std::size_t i = 0; i < count; ++i)
+    {
+        entities[i].id      = static_cast<sf::Uint32>(i * 37);
+        entities[i].x       = static_cast<float>(i % 100) * 3.5f;
+        entities[i].y       = static_cast<float>(i % 7) * -12.25f;
+        entities[i].z       = 1.5f;
+        entities[i].angle   = static_cast<sf::Int16>(i * 11 % 360);
+        entities[i].visible = (i % 3) != 0;
+        entities[i].name    = "entity";
+    }
+
+    return entities;
+}
+
+
+////////////////////////////////////////////////////////////
+/// Measure the serialization rates of sf::Packet
+///
+////////////////////////////////////////////////////////////
+void benchmarkPacket()
+{
+    const std::size_t iterations = 20000;
+    std::vector<Entity> entities = makeEntities(32);
+
+    // Field by field serialization
+    sf::Packet packet;
+    sf::Clock clock;
+    for (std::size_t i = 0; i < iterations; ++i)
+    {
+        packet.clear();
+        for (std::vector<Entity>::const_iterator it = entities.begin(); it != entities.end(); ++it)
+            packet << it->id << it->x << it->y << it->z << it->angle << it->visible << it->name;
+    }
+    sf::Time duration = clock.getElapsedTime();
+    report("packet", "serialize", rate(iterations * entities.size(), duration), "entities/s");
+    report("packet", "serialize_bandwidth", rate(iterations * packet.getDataSize(), duration) / 1e6, "MB/s");
+    report("packet", "entity_size", static_cast<double>(packet.getDataSize()) / entities.size(), "bytes");
+
+    // Field by field deserialization
+    Entity entity;
+    clock.restart();
+    for (std::size_t i = 0; i < iterations; ++i)
+    {
+        sf::Packet copy = packet;
+        for (std::size_t j = 0; j < entities.size(); ++j)
+            copy >> entity.id >> entity.x >> entity.y >> entity.z >> entity.angle >> entity.visible >> entity.name;
+    }
+    duration = clock.getElapsedTime();
+    report("packet", "deserialize", rate(iterations * entities.size(), duration), "entities/s");
+
+    // Bulk serialization of arrays
+    std::vector<float> values(4096, 1.f);
+    clock.restart();
+    for (std::size_t i = 0; i < iterations; ++i)
+    {
+        packet.clear();
+        packet.writeArray(&values[0], values.size());
+    }
+    duration = clock.getElapsedTime();
+    report("packet", "write_array", rate(iterations * values.size() * sizeof(float), duration) / 1e6, "MB/s");
+
+    clock.restart();
+    for (std::size_t i = 0; i < iterations; ++i)
+    {
+        sf::Packet copy = packet;
+        copy.readArray(&values[0], values.size());
+    }
+    duration = clock.getElapsedTime();
+    report("packet", "read_array", rate(iterations * values.size() * sizeof(float), duration) / 1e6, "MB/s");
+}
+
+
+////////////////////////////////////////////////////////////
+/// Bit packet giving access to its wire format, like the
+/// sockets have
+///
+////////////////////////////////////////////////////////////
+class WireBitPacket : public sf::BitPacket
+{
+public :
+
+    using sf::BitPacket::onSend;
+    using sf::BitPacket::onReceive;
+};
+
+
+////////////////////////////////////////////////////////////
+/// Measure the size and speed of the sf::BitPacket encoding
+///
+////////////////////////////////////////////////////////////
+void benchmarkBitPacket()
+{
+    const std::size_t iterations = 20000;
+    std::vector<Entity> entities = makeEntities(32);
+
+    // Same entities as the packet benchmark, with compact encodings
+    WireBitPacket packet;
+    std::size_t size = 0;
+    sf::Clock clock;
+    for (std::size_t i = 0; i < iterations; ++i)
+    {
+        packet.clear();
+        for (std::vector<Entity>::const_iterator it = entities.begin(); it != entities.end(); ++it)
+        {
+            packet.writeVarint(it->id);
+            packet.writeFloat(it->x, -1000.f, 1000.f, 20);
+            packet.writeFloat(it->y, -1000.f, 1000.f, 20);
+            packet.writeFloat(it->z, -1000.f, 1000.f, 20);
+            packet.writeBits(static_cast<sf::Uint32>(it->angle), 9);
+            packet.writeBool(it->visible);
+            packet << it->name;
+        }
+        packet.onSend(size);
+    }
+    sf::Time duration = clock.getElapsedTime();
+    report("bitpacket", "serialize", rate(iterations * entities.size(), duration), "entities/s");
+    report("bitpacket", "entity_size", static_cast<double>(size) / entities.size(), "bytes");
+
+    // Decode from the wire format, as a receiver would
+    const char* data = static_cast<const char*>(packet.onSend(size));
+    std::vector<char> wire(data, data + size);
+    Entity entity;
+    sf::Uint32 angle;
+    clock.restart();
+    for (std::size_t i = 0; i < iterations; ++i)
+    {
+        WireBitPacket copy;
+        copy.onReceive(&wire[0], wire.size());
+        for (std::size_t j = 0; j < entities.size(); ++j)
+        {
+            copy.readVarint(entity.id);
+            copy.readFloat(entity.x, -1000.f, 1000.f, 20);
+            copy.readFloat(entity.y, -1000.f, 1000.f, 20);
+            copy.readFloat(entity.z, -1000.f, 1000.f, 20);
+            copy.readBits(angle, 9);
+            copy.readBool(entity.visible);
+            copy >> entity.name;
+        }
+    }
+    duration = clock.getElapsedTime();
+    report("bitpacket", "deserialize", rate(iterations * entities.size(), duration), "entities/s");
+}
+
+
+////////////////////////////////////////////////////////////
+/// Connect a pair of TCP sockets over the loopback interface
+///
+////////////////////////////////////////////////////////////
+bool connectPair(sf::TcpListener& listener, sf::TcpSocket& client, sf::TcpSocket& server)
+{
+    if (client.connect(sf::IpAddress::LocalHost, listener.getLocalPort()) != sf::Socket::Done)
+        return false;
+
+    return listener.accept(server) == sf::Socket::Done;
+}
+
+
+////////////////////////////////////////////////////////////
+/// Receiving side of the TCP benchmarks
+///
+////////////////////////////////////////////////////////////
+struct TcpPeer
+{
+    sf::TcpSocket* socket;
+    std::size_t    count;
+    bool           echo;
+};
+
+void runTcpPeer(TcpPeer* peer)
+{
+    sf::Packet packet;
+    for (std::size_t i = 0; i < peer->count; ++i)
+    {
+        if (peer->socket->receive(packet) != sf::Socket::Done)
+            return;
+        if (peer->echo && (peer->socket->send(packet) != sf::Socket::Done))
+            return;
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+/// Measure the throughput and round-trip latency of TcpSocket
+///
+////////////////////////////////////////////////////////////
+void benchmarkTcp(sf::TcpListener& listener)
+{
+    // Throughput of framed packets, for several packet sizes
+    const std::size_t sizes[] = {64, 1024, 16384};
+    for (std::size_t i = 0; i < sizeof(sizes) / sizeof(*sizes); ++i)
+    {
+        sf::TcpSocket client;
+        sf::TcpSocket server;
+        if (!connectPair(listener, client, server))
+            return;
+
+        const std::size_t count = 64 * 1024 * 1024 / sizes[i] / 4;
+        TcpPeer peer = {&server, count, false};
+        sf::Thread thread(&runTcpPeer, &peer);
+
+        std::vector<char> payload(sizes[i], 'x');
+        sf::Packet packet;
+        packet.append(&payload[0], payload.size());
+
+        sf::Clock clock;
+        thread.launch();
+        for (std::size_t j = 0; j < count; ++j)
+        {
+            if (client.send(packet) != sf::Socket::Done)
+                break;
+        }
+        thread.wait();
+        sf::Time duration = clock.getElapsedTime();
+
+        std::string name = "tcp_throughput_" + std::string(sizes[i] == 64 ? "64" : sizes[i] == 1024 ? "1024" : "16384");
+        report(name, "packets", rate(count, duration), "packets/s");
+        report(name, "bandwidth", rate(count * (sizes[i] + 4), duration) / 1e6, "MB/s");
+    }
+
+    // Round-trip latency of small packets
+    sf::TcpSocket client;
+    sf::TcpSocket server;
+    if (!connectPair(listener, client, server))
+        return;
+
+    const std::size_t count = 10000;
+    TcpPeer peer = {&server, count, true};
+    sf::Thread thread(&runTcpPeer, &peer);
+    thread.launch();
+
+    std::vector<sf::Int64> samples;
+    samples.reserve(count);
+    sf::Packet packet;
+    sf::Clock clock;
+    for (std::size_t i = 0; i < count; ++i)
+    {
+        packet.clear();
+        packet << static_cast<sf::Uint32>(i);
+
+        clock.restart();
+        if ((client.send(packet) != sf::Socket::Done) || (client.receive(packet) != sf::Socket::Done))
+            break;
+        samples.push_back(clock.getElapsedTime().asMicroseconds());
+    }
+    thread.wait();
+
+    if (!samples.empty())
+    {
+        report("tcp_latency", "p50", percentile(samples, 0.5), "us");
+        report("tcp_latency", "p99", percentile(samples, 0.99), "us");
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+/// Receiving side of the UDP benchmarks
+///
+////////////////////////////////////////////////////////////
+struct UdpReceiver
+{
+    sf::UdpSocket* socket;
+    std::size_t    count;
+    bool           batched;
+    std::size_t    received;
+    sf::Time       duration;
+};
+
+void runUdpReceiver(UdpReceiver* receiver)
+{
+    // Stop when everything was received, or when the sender is done and datagrams were lost
+    sf::SocketSelector selector;
+    selector.add(*receiver->socket);
+
+    const std::size_t batchSize = 64;
+    std::vector<sf::Packet> packets(batchSize);
+    std::vector<sf::UdpSocket::BatchEntry> entries(batchSize);
+    for (std::size_t i = 0; i < batchSize; ++i)
+        entries[i].packet = &packets[i];
+
+    sf::Clock clock;
+    receiver->received = 0;
+    while ((receiver->received < receiver->count) && selector.wait(sf::milliseconds(200)))
+    {
+        if (receiver->batched)
+        {
+            std::size_t received = 0;
+            receiver->socket->receive(&entries[0], batchSize, received);
+            receiver->received += received;
+        }
+        else
+        {
+            sf::IpAddress sender;
+            unsigned short port;
+            if (receiver->socket->receive(packets[0], sender, port) == sf::Socket::Done)
+                ++receiver->received;
+        }
+
+        if (receiver->received == 1)
+            clock.restart();
+    }
+    receiver->duration = clock.getElapsedTime();
+}
+
+
+////////////////////////////////////////////////////////////
+/// Measure the datagram rates of UdpSocket, one by one and batched
+///
+////////////////////////////////////////////////////////////
+void benchmarkUdp()
+{
+    const std::size_t count = 200000;
+    const std::size_t batchSize = 64;
+
+    for (int batched = 0; batched < 2; ++batched)
+    {
+        sf::UdpSocket receiverSocket;
+        sf::UdpSocket senderSocket;
+        receiverSocket.setReceiveBufferSize(4 * 1024 * 1024);
+        if (receiverSocket.bind(sf::Socket::AnyPort) != sf::Socket::Done)
+            return;
+        unsigned short port = receiverSocket.getLocalPort();
+
+        UdpReceiver receiver = {&receiverSocket, count, batched != 0, 0, sf::Time::Zero};
+        sf::Thread thread(&runUdpReceiver, &receiver);
+        thread.launch();
+
+        std::vector<sf::Packet> packets(batchSize);
+        std::vector<sf::UdpSocket::BatchEntry> entries(batchSize);
+        for (std::size_t i = 0; i < batchSize; ++i)
+        {
+            std::vector<char> payload(64, 'x');
+            packets[i].append(&payload[0], payload.size());
+            entries[i].packet = &packets[i];
+            entries[i].remoteAddress = sf::IpAddress::LocalHost;
+            entries[i].remotePort = port;
+        }
+
+        sf::Clock clock;
+        std::size_t sent = 0;
+        while (sent < count)
+        {
+            if (batched)
+            {
+                std::size_t done = 0;
+                senderSocket.send(&entries[0], std::min(batchSize, count - sent), done);
+                sent += done;
+                if (done == 0)
+                    break;
+            }
+            else
+            {
+                if (senderSocket.send(packets[0], sf::IpAddress::LocalHost, port) != sf::Socket::Done)
+                    break;
+                ++sent;
+            }
+        }
+        sf::Time duration = clock.getElapsedTime();
+        thread.wait();
+
+        std::string name = batched ? "udp_batched" : "udp_single";
+        report(name, "sent", rate(sent, duration), "datagrams/s");
+        report(name, "received", rate(receiver.received, receiver.duration), "datagrams/s");
+        report(name, "loss", sent ? 100.0 * (sent - receiver.received) / sent : 0.0, "%");
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+/// Measure how many fragmented unreliable packets of a
+/// ReliableUdpChannel get through when datagrams are reordered
+///
+////////////////////////////////////////////////////////////
+void benchmarkReliableUdp()
+{
+    const int jitters[] = {0, 20};
+    for (std::size_t i = 0; i < sizeof(jitters) / sizeof(*jitters); ++i)
+    {
+        sf::UdpSocket senderSocket;
+        sf::UdpSocket receiverSocket;
+        if ((senderSocket.bind(sf::Socket::AnyPort) != sf::Socket::Done) ||
+            (receiverSocket.bind(sf::Socket::AnyPort) != sf::Socket::Done))
+            return;
+
+        sf::ReliableUdpChannel sender(senderSocket, sf::IpAddress::LocalHost, receiverSocket.getLocalPort());
+        sf::ReliableUdpChannel receiver(receiverSocket, sf::IpAddress::LocalHost, senderSocket.getLocalPort());
+
+        // No loss: the jitter only reorders the datagrams
+        sf::ReliableUdpChannel::Simulator simulator;
+        simulator.setLatency(sf::milliseconds(5), sf::milliseconds(jitters[i]));
+        sender.setSimulator(&simulator);
+
+        // Send packets big enough to be split into several fragments
+        const std::size_t count = 200;
+        std::vector<char> payload(4000, 'x');
+        std::size_t received = 0;
+        sf::Clock clock;
+        for (std::size_t j = 0; j < count; ++j)
+        {
+            sf::Packet packet;
+            packet.append(&payload[0], payload.size());
+            sender.send(packet, sf::ReliableUdpChannel::Unreliable);
+            sender.update();
+            receiver.update();
+            while (receiver.receive(packet))
+                ++received;
+            sf::sleep(sf::milliseconds(1));
+        }
+
+        // Let the delayed datagrams arrive
+        while (clock.getElapsedTime() < sf::milliseconds(static_cast<sf::Int32>(count) + 5 + jitters[i] + 100))
+        {
+            sender.update();
+            receiver.update();
+            sf::Packet packet;
+            while (receiver.receive(packet))
+                ++received;
+            sf::sleep(sf::milliseconds(1));
+        }
+
+        std::string name = jitters[i] ? "reliable_udp_jitter_20ms" : "reliable_udp_jitter_0ms";
+        report(name, "unreliable_fragmented_delivered", 100.0 * received / count, "%");
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+/// Measure the cost of waking up a SocketSelector on one
+/// active connection, depending on the number of connections
+///
+////////////////////////////////////////////////////////////
+void benchmarkSelector(sf::TcpListener& listener)
+{
+    const std::size_t connections[] = {1, 16, 128, 256};
+    for (std::size_t i = 0; i < sizeof(connections) / sizeof(*connections); ++i)
+    {
+        // Connect the clients
+        std::size_t count = connections[i];
+        std::vector<sf::TcpSocket*> clients;
+        std::vector<sf::TcpSocket*> servers;
+        sf::SocketSelector selector;
+        for (std::size_t j = 0; j < count; ++j)
+        {
+            clients.push_back(new sf::TcpSocket);
+            servers.push_back(new sf::TcpSocket);
+            if (!connectPair(listener, *clients.back(), *servers.back()))
+                break;
+            selector.add(*servers.back());
+        }
+
+        // Make one client at a time send a byte, and find it through the selector
+        const std::size_t iterations = 5000;
+        sf::Time scanTime = sf::Time::Zero;
+        sf::Time listTime = sf::Time::Zero;
+        char byte = 0;
+        std::size_t received = 0;
+        for (std::size_t j = 0; (j < iterations) && (servers.size() == count); ++j)
+        {
+            std::size_t index = (j * 7919) % count;
+            clients[index]->send(&byte, 1);
+
+            // Find the ready socket by testing all of them, or through the ready list
+            sf::Clock clock;
+            selector.wait();
+            sf::TcpSocket* ready = NULL;
+            if (j % 2 == 0)
+            {
+                for (std::size_t k = 0; k < count; ++k)
+                {
+                    if (selector.isReady(*servers[k]))
+                        ready = servers[k];
+                }
+                scanTime += clock.getElapsedTime();
+            }
+            else
+            {
+                if (!selector.getReadySockets().empty())
+                    ready = static_cast<sf::TcpSocket*>(selector.getReadySockets().front());
+                listTime += clock.getElapsedTime();
+            }
+
+            if (ready)
+                ready->receive(&byte, 1, received);
+        }
+
+        std::string name = "selector_" + std::string(count == 1 ? "1" : count == 16 ? "16" : count == 128 ? "128" : "256");
+        report(name, "wait_and_scan", scanTime.asMicroseconds() * 2.0 / iterations, "us");
+        report(name, "wait_and_ready_list", listTime.asMicroseconds() * 2.0 / iterations, "us");
+
+        for (std::size_t j = 0; j < clients.size(); ++j)
+        {
+            delete clients[j];
+            delete servers[j];
+        }
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+/// Entry point of application
+///
+/// \return Application exit code
+///
+////////////////////////////////////////////////////////////
+int main()
+{
+    // All the socket benchmarks run over the loopback interface
+    sf::TcpListener listener;
+    if (listener.listen(sf::Socket::AnyPort) != sf::Socket::Done)
+        return EXIT_FAILURE;
+
+    // Results are printed as comma-separated values, to be easily compared between runs
+    std::cout << "benchmark,metric,value,unit" << std::endl;
+    benchmarkPacket();
+    benchmarkBitPacket();
+    benchmarkTcp(listener);
+    benchmarkUdp();
+    benchmarkReliableUdp();
+    benchmarkSelector(listener);
+
+    return EXIT_SUCCESS;
+}
@@ -30,13 +30,18 @@
 ////////////////////////////////////////////////////////////
 #include <SFML/Audio/Export.hpp>
 #include <SFML/Audio/SoundSource.hpp>
-#include <SFML/System/Thread.hpp>
+#include <SFML/System/Mutex.hpp>
 #include <SFML/System/Time.hpp>
 #include <cstdlib>
 
 
 namespace sf
 {
+namespace priv
+{
+    class SoundStreamScheduler;
+}
+
 ////////////////////////////////////////////////////////////
 /// \brief Abstract base class for streamed audio sources
 ///
@@ -67,8 +72,9 @@ public :
     /// This function starts the stream if it was stopped, resumes
     /// it if it was paused, and restarts it from beginning if it
     /// was it already playing.
-    /// This function uses its own thread so that it doesn't block
-    /// the rest of the program while the stream is played.
+    /// The stream is serviced by a background thread shared by
+    /// all the streams, so that it doesn't block the rest of the
+    /// program while it is played.
     ///
     /// \see pause, stop
     ///
@@ -175,6 +181,100 @@ public :
     ////////////////////////////////////////////////////////////
     bool getLoop() const;
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Set the number of audio buffers queued by the stream
+    ///
+    /// More buffers make the stream more robust against a busy
+    /// system, at the cost of more latency between the source
+    /// and what is heard. The count is clamped to [2, 32].
+    /// If the stream is playing, the queue is resized gradually
+    /// as buffers are played. In adaptive mode, this is the
+    /// minimum number of buffers.
+    /// The default buffer count is 3.
+    ///
+    /// \param count Number of buffers
+    ///
+    /// \see getBufferCount, setAdaptiveBuffering
+    ///
+    ////////////////////////////////////////////////////////////
+    void setBufferCount(unsigned int count);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the number of audio buffers queued by the stream
+    ///
+    /// \return Number of buffers
+    ///
+    /// \see setBufferCount
+    ///
+    ////////////////////////////////////////////////////////////
+    unsigned int getBufferCount() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Set the duration of the chunks provided by the stream source
+    ///
+    /// This is a hint for derived classes, which should size the
+    /// chunks that they return from onGetData accordingly
+    /// (sf::Music does). The audio latency of the stream is
+    /// roughly the chunk duration multiplied by the buffer count.
+    /// The duration is clamped to at least 1 millisecond.
+    /// The default chunk duration is 1 second.
+    ///
+    /// \param duration Duration of a chunk
+    ///
+    /// \see getChunkDuration, setBufferCount
+    ///
+    ////////////////////////////////////////////////////////////
+    void setChunkDuration(Time duration);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the duration of the chunks provided by the stream source
+    ///
+    /// \return Duration of a chunk
+    ///
+    /// \see setChunkDuration
+    ///
+    ////////////////////////////////////////////////////////////
+    Time getChunkDuration() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Enable or disable adaptive buffering
+    ///
+    /// In adaptive mode, the stream queues one more buffer every
+    /// time it underruns, and gives one back after having played
+    /// 10 seconds without underrun, never going below the count
+    /// set with setBufferCount.
+    /// Adaptive buffering is disabled by default.
+    ///
+    /// \param adaptive True to enable adaptive buffering, false to disable it
+    ///
+    /// \see isAdaptiveBuffering, getUnderrunCount
+    ///
+    ////////////////////////////////////////////////////////////
+    void setAdaptiveBuffering(bool adaptive);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Tell whether or not adaptive buffering is enabled
+    ///
+    /// \return True if adaptive buffering is enabled, false otherwise
+    ///
+    /// \see setAdaptiveBuffering
+    ///
+    ////////////////////////////////////////////////////////////
+    bool isAdaptiveBuffering() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the number of underruns of the stream
+    ///
+    /// An underrun happens when the queued audio has all been
+    /// played before the stream source could provide more, which
+    /// produces an audible gap. The count accumulates over the
+    /// lifetime of the stream.
+    ///
+    /// \return Number of underruns
+    ///
+    ////////////////////////////////////////////////////////////
+    unsigned int getUnderrunCount() const;
+
 protected :
 
     enum BufferEnd
@@ -213,7 +313,11 @@ protected :
     ///
     /// This function must be overriden by derived classes to provide
     /// the audio samples to play. It is called continuously by the
-    /// streaming loop, in a separate thread.
+    /// streaming loop, in the shared streaming thread.
+    /// As this thread services all the streams in turn, this
+    /// function must return quickly: it must not wait for data
+    /// to become available (return a short chunk of silence
+    /// instead), otherwise the other streams starve.
     /// The source can choose to stop the streaming loop at any time, by
     /// returning false to the caller.
     ///
@@ -263,14 +367,40 @@ protected :
 
 private :
 
+    friend class priv::SoundStreamScheduler;
+
     ////////////////////////////////////////////////////////////
-    /// \brief Function called as the entry point of the thread
+    /// \brief Create the buffers, fill the queue and start playing
     ///
-    /// This function starts the streaming loop, and returns
-    /// only when the sound is stopped.
+    /// This function is called by the streaming thread when it
+    /// starts servicing the stream.
     ///
     ////////////////////////////////////////////////////////////
-    void streamData();
+    void startStreaming();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Run one iteration of the streaming loop
+    ///
+    /// This function refills the buffers that have been played,
+    /// and computes how long the stream can wait before its
+    /// next refill without starving.
+    ///
+    /// \param wait Receives the time until the next refill is needed
+    ///             (left unchanged if the stream is paused)
+    ///
+    /// \return True if the stream is still playing, false if it is over
+    ///
+    ////////////////////////////////////////////////////////////
+    bool updateStreaming(Time& wait);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Stop playing and release the buffers
+    ///
+    /// This function is called by the streaming thread when it
+    /// stops servicing the stream.
+    ///
+    ////////////////////////////////////////////////////////////
+    void stopStreaming();
 
     ////////////////////////////////////////////////////////////
     /// \brief Fill a new buffer with audio samples, and append
@@ -280,7 +410,7 @@ private :
     /// consumed; it fills it again and inserts it back into the
     /// playing queue.
     ///
-    /// \param bufferNum Number of the buffer to fill (in [0, BufferCount])
+    /// \param bufferNum Number of the buffer to fill (in [0, m_allocatedBuffers])
     ///
     /// \return True if the stream source has requested to stop, false otherwise
     ///
@@ -306,23 +436,38 @@ private :
     ////////////////////////////////////////////////////////////
     void clearQueue();
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Allocate and queue buffers until the queue reaches its target size
+    ///
+    ////////////////////////////////////////////////////////////
+    void growQueue();
+
     enum
     {
-        BufferCount = 3 ///< Number of audio buffers used by the streaming loop
+        MaxBufferCount = 32 ///< Maximum number of audio buffers used by the streaming loop
     };
 
     ////////////////////////////////////////////////////////////
     // Member data
     ////////////////////////////////////////////////////////////
-    Thread        m_thread;                  ///< Thread running the background tasks
-    bool          m_isStreaming;             ///< Streaming state (true = playing, false = stopped)
-    unsigned int  m_buffers[BufferCount];    ///< Sound buffers used to store temporary audio data
-    unsigned int  m_channelCount;            ///< Number of channels (1 = mono, 2 = stereo, ...)
-    unsigned int  m_sampleRate;              ///< Frequency (samples / second)
-    Uint32        m_format;                  ///< Format of the internal sound buffers
-    bool          m_loop;                    ///< Loop flag (true to loop, false to play once)
-    Uint64        m_samplesProcessed;        ///< Number of buffers processed since beginning of the stream
-    BufferEnd     m_endBuffers[BufferCount]; ///< Each buffer is marked as "end buffer" or not, for proper duration calculation
+    Mutex         m_streamMutex;                   ///< Held by the streaming thread while it services the stream
+    bool          m_isStreaming;                   ///< Streaming state (true = playing, false = stopped)
+    bool          m_requestStop;                   ///< Has the stream source run out of data?
+    unsigned int  m_buffers[MaxBufferCount];       ///< Sound buffers used to store temporary audio data
+    std::size_t   m_bufferSamples[MaxBufferCount]; ///< Number of samples currently queued in each buffer
+    unsigned int  m_allocatedBuffers;              ///< Number of buffers currently allocated by the streaming loop
+    unsigned int  m_targetBuffers;                 ///< Number of buffers that the streaming loop aims for
+    unsigned int  m_bufferCount;                   ///< Number of buffers requested by the user
+    Time          m_chunkDuration;                 ///< Duration of the chunks provided by the stream source
+    bool          m_adaptive;                      ///< Adaptive buffering flag
+    unsigned int  m_underrunCount;                 ///< Number of underruns since the stream was created
+    Uint64        m_stableSamples;                 ///< Number of samples played since the last underrun or shrink
+    unsigned int  m_channelCount;                  ///< Number of channels (1 = mono, 2 = stereo, ...)
+    unsigned int  m_sampleRate;                    ///< Frequency (samples / second)
+    Uint32        m_format;                        ///< Format of the internal sound buffers
+    bool          m_loop;                          ///< Loop flag (true to loop, false to play once)
+    Uint64        m_samplesProcessed;              ///< Number of buffers processed since beginning of the stream
+    BufferEnd     m_endBuffers[MaxBufferCount];    ///< Each buffer is marked as "end buffer" or not, for proper duration calculation
 };
 
 } // namespace sf
@@ -356,10 +501,13 @@ private :
 /// \li onGetData fills a new chunk of audio data to be played
 /// \li onSeek changes the current playing position in the source
 ///
-/// It is important to note that each SoundStream is played in its
-/// own separate thread, so that the streaming loop doesn't block the
-/// rest of the program. In particular, the OnGetData and OnSeek
-/// virtual functions may sometimes be called from this separate thread.
+/// It is important to note that SoundStreams are played from a
+/// background thread shared by all the streams, so that the streaming
+/// loop doesn't block the rest of the program. In particular, the
+/// OnGetData and OnSeek virtual functions may sometimes be called
+/// from this separate thread. Since it is shared, onGetData must
+/// never block waiting for data: a stream that does so delays all
+/// the other ones.
 /// It is important to keep this in mind, because you may have to take
 /// care of synchronization issues if you share data between threads.
 ///
@@ -0,0 +1,117 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2014 Laurent Gomila (laurent.gom@gmail.com)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+
+#ifndef SFML_RENDERSTATS_HPP
+#define SFML_RENDERSTATS_HPP
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Graphics/Export.hpp>
+#include <SFML/System/Time.hpp>
+
+
+namespace sf
+{
+////////////////////////////////////////////////////////////
+/// \brief Rendering statistics of a single frame
+///
+////////////////////////////////////////////////////////////
+struct SFML_GRAPHICS_API RenderStats
+{
+    ////////////////////////////////////////////////////////////
+    /// \brief Default constructor
+    ///
+    /// Constructs empty statistics, with all counters set to 0.
+    ///
+    ////////////////////////////////////////////////////////////
+    RenderStats();
+
+    ////////////////////////////////////////////////////////////
+    // Member data
+    ////////////////////////////////////////////////////////////
+    Uint64       frame;            ///< Index of the frame, counted since statistics were enabled
+    unsigned int drawCalls;        ///< Number of OpenGL draw calls issued
+    Uint64       vertices;         ///< Number of vertices drawn
+    Uint64       bytesUploaded;    ///< Number of bytes of vertex data sent from client memory
+    unsigned int viewChanges;      ///< Number of times the projection was updated
+    unsigned int blendChanges;     ///< Number of times the blending mode was changed
+    unsigned int textureChanges;   ///< Number of times the bound texture was changed
+    unsigned int shaderChanges;    ///< Number of times a shader was bound or unbound
+    unsigned int redundantChanges; ///< Number of state changes skipped because the state was already set
+    bool         gpuTimeAvailable; ///< Does the system support GPU timer queries?
+    Time         gpuTime;          ///< GPU time spent on frame gpuFrame
+    Uint64       gpuFrame;         ///< Index of the frame that gpuTime was measured on
+};
+
+} // namespace sf
+
+
+#endif // SFML_RENDERSTATS_HPP
+
+
+////////////////////////////////////////////////////////////
+/// \class sf::RenderStats
+/// \ingroup graphics
+///
+/// sf::RenderStats is a snapshot of what a render target did
+/// during one frame: how many draw calls and vertices it
+/// submitted, how many OpenGL state changes these required
+/// and how much vertex data was streamed to the driver.
+/// redundantChanges counts the state changes that the target's
+/// cache eliminated, which is a good hint of how well draw calls
+/// are sorted.
+///
+/// Statistics are disabled by default; they are enabled with
+/// sf::RenderTarget::setStatsEnabled, and a new snapshot is
+/// published every time the target is displayed.
+///
+/// The GPU time is measured with asynchronous timer queries.
+/// To avoid stalling the pipeline, the results are only read
+/// once the GPU has finished the frame, which is usually a
+/// couple of frames later: gpuTime therefore refers to frame
+/// gpuFrame, not to the current one. When timer queries are
+/// not supported, gpuTimeAvailable is false and gpuTime stays 0.
+///
+/// Usage example:
+/// \code
+/// window.setStatsEnabled(true);
+///
+/// while (window.isOpen())
+/// {
+///     window.clear();
+///     window.draw(...);
+///     window.display();
+///
+///     const sf::RenderStats& stats = window.getStats();
+///     telemetry.record(stats.frame, stats.drawCalls, stats.vertices);
+///     if (stats.gpuTimeAvailable)
+///         telemetry.recordGpu(stats.gpuFrame, stats.gpuTime.asMicroseconds());
+/// }
+/// \endcode
+///
+/// \see sf::RenderTarget
+///
+////////////////////////////////////////////////////////////
@@ -35,6 +35,7 @@
 #include <SFML/Graphics/Transform.hpp>
 #include <SFML/Graphics/BlendMode.hpp>
 #include <SFML/Graphics/RenderStates.hpp>
+#include <SFML/Graphics/RenderStats.hpp>
 #include <SFML/Graphics/PrimitiveType.hpp>
 #include <SFML/Graphics/Vertex.hpp>
 #include <SFML/System/NonCopyable.hpp>
@@ -323,6 +324,44 @@ public :
     ////////////////////////////////////////////////////////////
     void resetGLStates();
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Enable or disable the collection of rendering statistics
+    ///
+    /// When enabled, the target counts the draw calls, vertices
+    /// and state changes of each frame, and measures its GPU time
+    /// if the system supports timer queries. Statistics are
+    /// disabled by default.
+    ///
+    /// \param enabled True to enable statistics, false to disable them
+    ///
+    /// \see getStats
+    ///
+    ////////////////////////////////////////////////////////////
+    void setStatsEnabled(bool enabled);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Tell whether rendering statistics are enabled
+    ///
+    /// \return True if statistics are enabled
+    ///
+    /// \see setStatsEnabled
+    ///
+    ////////////////////////////////////////////////////////////
+    bool isStatsEnabled() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the statistics of the last displayed frame
+    ///
+    /// The snapshot is updated every time the target is
+    /// displayed (Window::display, RenderTexture::display).
+    ///
+    /// \return Statistics of the last complete frame
+    ///
+    /// \see setStatsEnabled
+    ///
+    ////////////////////////////////////////////////////////////
+    const RenderStats& getStats() const;
+
 protected :
 
     ////////////////////////////////////////////////////////////
@@ -340,14 +379,48 @@ protected :
     ////////////////////////////////////////////////////////////
     void initialize();
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Close the current frame of rendering statistics
+    ///
+    /// The derived classes must call this function when
+    /// a frame is complete, just before presenting it.
+    ///
+    ////////////////////////////////////////////////////////////
+    void finishStatsFrame();
+
 private:
 
+    friend class StaticVertexArray;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Draw primitives stored in an OpenGL vertex buffer
+    ///
+    /// The buffer must contain tightly packed sf::Vertex elements.
+    ///
+    /// \param buffer      OpenGL identifier of the vertex buffer
+    /// \param vertexCount Number of vertices in the buffer
+    /// \param type        Type of primitives to draw
+    /// \param states      Render states to use for drawing
+    ///
+    ////////////////////////////////////////////////////////////
+    void drawBuffer(unsigned int buffer, unsigned int vertexCount,
+                    PrimitiveType type, const RenderStates& states);
+
     ////////////////////////////////////////////////////////////
     /// \brief Apply the current view
     ///
     ////////////////////////////////////////////////////////////
     void applyCurrentView();
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Apply the view, blending mode, texture and shader
+    ///        that a draw call requires
+    ///
+    /// \param states Render states used by the draw call
+    ///
+    ////////////////////////////////////////////////////////////
+    void applyStates(const RenderStates& states);
+
     ////////////////////////////////////////////////////////////
     /// \brief Apply a new blending mode
     ///
@@ -380,6 +453,18 @@ private:
     ////////////////////////////////////////////////////////////
     void applyShader(const Shader* shader);
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Start measuring the GPU time of the current frame
+    ///
+    ////////////////////////////////////////////////////////////
+    void beginGpuTimer();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Read back the results of the finished GPU timer queries
+    ///
+    ////////////////////////////////////////////////////////////
+    void readGpuTimers();
+
     ////////////////////////////////////////////////////////////
     /// \brief Activate the target for rendering
     ///
@@ -402,12 +487,38 @@ private:
     {
         enum {VertexCacheSize = 4};
 
-        bool      glStatesSet;    ///< Are our internal GL states set yet?
-        bool      viewChanged;    ///< Has the current view changed since last draw?
-        BlendMode lastBlendMode;  ///< Cached blending mode
-        Uint64    lastTextureId;  ///< Cached texture
-        bool      useVertexCache; ///< Did we previously use the vertex cache?
-        Vertex    vertexCache[VertexCacheSize]; ///< Pre-transformed vertices cache
+        bool          glStatesSet;     ///< Are our internal GL states set yet?
+        bool          viewChanged;     ///< Has the current view changed since last draw?
+        BlendMode     lastBlendMode;   ///< Cached blending mode
+        Uint64        lastTextureId;   ///< Cached texture
+        bool          transformSet;    ///< Is lastTransform the current model-view matrix?
+        Transform     lastTransform;   ///< Cached model-view matrix
+        bool          projectionSet;   ///< Is lastProjection the current projection matrix?
+        Transform     lastProjection;  ///< Cached projection matrix
+        bool          viewportSet;     ///< Is lastViewport the current viewport?
+        IntRect       lastViewport;    ///< Cached viewport, in OpenGL coordinates
+        unsigned int  lastArrayBuffer; ///< Vertex buffer the array pointers refer to (0 for client memory)
+        const Vertex* lastArrayData;   ///< Client-side vertices the array pointers refer to
+        Vertex        vertexCache[VertexCacheSize]; ///< Pre-transformed vertices cache
+    };
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Rendering statistics and GPU timer queries
+    ///
+    ////////////////////////////////////////////////////////////
+    struct StatsState
+    {
+        enum {TimerQueryCount = 4};
+
+        bool         enabled;                       ///< Are statistics collected?
+        RenderStats  current;                       ///< Statistics of the frame being rendered
+        RenderStats  last;                          ///< Statistics of the last complete frame
+        unsigned int queries[TimerQueryCount];      ///< Ring of OpenGL timer query objects
+        Uint64       queryFrames[TimerQueryCount];  ///< Frame measured by each query
+        bool         queryPending[TimerQueryCount]; ///< Is each query waiting for its result?
+        unsigned int queryIndex;                    ///< Query to use for the current frame
+        bool         timerStarted;                  ///< Was the timer requested for the current frame?
+        bool         timerRunning;                  ///< Is a timer query currently active?
     };
 
     ////////////////////////////////////////////////////////////
@@ -416,6 +527,7 @@ private:
     View        m_defaultView; ///< Default view
     View        m_view;        ///< Current view
     StatesCache m_cache;       ///< Render states cache
+    StatsState  m_stats;       ///< Rendering statistics
 };
 
 } // namespace sf
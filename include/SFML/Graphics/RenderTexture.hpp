@@ -31,6 +31,7 @@
 #include <SFML/Graphics/Export.hpp>
 #include <SFML/Graphics/Texture.hpp>
 #include <SFML/Graphics/RenderTarget.hpp>
+#include <vector>
 
 
 namespace sf
@@ -48,6 +49,19 @@ class SFML_GRAPHICS_API RenderTexture : public RenderTarget
 {
 public :
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Pixel formats of the target textures
+    ///
+    ////////////////////////////////////////////////////////////
+    enum Format
+    {
+        Rgba8,   ///< 8 bits per channel RGBA (default)
+        Rgba16f, ///< 16 bits floating point RGBA, for HDR rendering
+        Rgba32f, ///< 32 bits floating point RGBA
+        R8,      ///< 8 bits single channel
+        Rg16f    ///< 16 bits floating point two channels, for velocity or normal buffers
+    };
+
     ////////////////////////////////////////////////////////////
     /// \brief Default constructor
     ///
@@ -85,6 +99,31 @@ public :
     ////////////////////////////////////////////////////////////
     bool create(unsigned int width, unsigned int height, bool depthBuffer = false);
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Create the render-texture with a specific pixel format
+    ///        and one or more color attachments
+    ///
+    /// All the attachments share the same size and format.
+    /// Drawing with a fragment shader that writes to gl_FragData[i]
+    /// fills the i-th attachment in a single pass; regular
+    /// SFML drawing only writes to the first one.
+    /// Formats other than Rgba8 and multiple attachments require
+    /// support for frame buffer objects, you can check it with
+    /// isFormatAvailable and getMaximumAttachmentCount.
+    ///
+    /// \param width           Width of the render-texture
+    /// \param height          Height of the render-texture
+    /// \param format          Pixel format of the target textures
+    /// \param attachmentCount Number of color attachments
+    /// \param depthBuffer     Do you want this render-texture to have a depth buffer?
+    ///
+    /// \return True if creation has been successful
+    ///
+    /// \see getTexture, getAttachmentCount
+    ///
+    ////////////////////////////////////////////////////////////
+    bool create(unsigned int width, unsigned int height, Format format, unsigned int attachmentCount = 1, bool depthBuffer = false);
+
     ////////////////////////////////////////////////////////////
     /// \brief Enable or disable texture smoothing
     ///
@@ -186,6 +225,49 @@ public :
     ////////////////////////////////////////////////////////////
     const Texture& getTexture() const;
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Get a read-only reference to one of the target textures
+    ///
+    /// Index 0 is the same texture as the one returned by
+    /// getTexture(). If \a index is out of range, an error is
+    /// printed and the first texture is returned.
+    ///
+    /// \param index Index of the color attachment
+    ///
+    /// \return Const reference to the texture
+    ///
+    /// \see getAttachmentCount
+    ///
+    ////////////////////////////////////////////////////////////
+    const Texture& getTexture(unsigned int index) const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the number of color attachments
+    ///
+    /// \return Number of target textures
+    ///
+    ////////////////////////////////////////////////////////////
+    unsigned int getAttachmentCount() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the maximum number of color attachments
+    ///        supported by the system
+    ///
+    /// \return Maximum number of color attachments
+    ///
+    ////////////////////////////////////////////////////////////
+    static unsigned int getMaximumAttachmentCount();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Tell whether the system can render to a pixel format
+    ///
+    /// \param format Pixel format to check
+    ///
+    /// \return True if the format is supported
+    ///
+    ////////////////////////////////////////////////////////////
+    static bool isFormatAvailable(Format format);
+
 private :
 
     ////////////////////////////////////////////////////////////
@@ -201,11 +283,18 @@ private :
     ////////////////////////////////////////////////////////////
     virtual bool activate(bool active);
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Destroy the additional color attachments
+    ///
+    ////////////////////////////////////////////////////////////
+    void destroyAttachments();
+
     ////////////////////////////////////////////////////////////
     // Member data
     ////////////////////////////////////////////////////////////
-    priv::RenderTextureImpl* m_impl;    ///< Platform/hardware specific implementation
-    Texture                  m_texture; ///< Target texture to draw on
+    priv::RenderTextureImpl* m_impl;        ///< Platform/hardware specific implementation
+    Texture                  m_texture;     ///< Target texture to draw on
+    std::vector<Texture*>    m_attachments; ///< Additional color attachments
 };
 
 } // namespace sf
@@ -275,6 +364,22 @@ private :
 /// and regular SFML drawing commands. If you need a depth buffer for
 /// 3D rendering, don't forget to request it when calling RenderTexture::create.
 ///
+/// For deferred or HDR pipelines, a render-texture can also be created
+/// with a floating point format and several color attachments, that
+/// a fragment shader fills at once through gl_FragData:
+/// \code
+/// sf::RenderTexture gbuffer;
+/// if (!gbuffer.create(800, 600, sf::RenderTexture::Rgba16f, 3))
+///     return -1;
+///
+/// gbuffer.clear();
+/// gbuffer.draw(scene, &geometryShader);
+/// gbuffer.display();
+///
+/// const sf::Texture& albedo  = gbuffer.getTexture(0);
+/// const sf::Texture& normals = gbuffer.getTexture(1);
+/// \endcode
+///
 /// \see sf::RenderTarget, sf::RenderWindow, sf::View, sf::Texture
 ///
 ////////////////////////////////////////////////////////////
@@ -149,6 +149,17 @@ protected:
     ////////////////////////////////////////////////////////////
     virtual void onResize();
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Function called before the window displays a frame
+    ///
+    /// This function closes the current frame of rendering
+    /// statistics, if they are enabled.
+    ///
+    /// \see RenderTarget::getStats
+    ///
+    ////////////////////////////////////////////////////////////
+    virtual void onDisplay();
+
 private :
 
     ////////////////////////////////////////////////////////////
@@ -33,6 +33,7 @@
 #include <SFML/Graphics/Color.hpp>
 #include <SFML/Window/GlResource.hpp>
 #include <SFML/System/NonCopyable.hpp>
+#include <SFML/System/Time.hpp>
 #include <SFML/System/Vector2.hpp>
 #include <SFML/System/Vector3.hpp>
 #include <map>
@@ -79,6 +80,27 @@ public :
     ////////////////////////////////////////////////////////////
     static CurrentTextureType CurrentTexture;
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Statistics about the creation of shader programs
+    ///
+    /// \see getStatistics
+    ///
+    ////////////////////////////////////////////////////////////
+    struct SFML_GRAPHICS_API Statistics
+    {
+        ////////////////////////////////////////////////////////////
+        /// \brief Default constructor
+        ///
+        ////////////////////////////////////////////////////////////
+        Statistics();
+
+        unsigned int compiled;    ///< Number of programs compiled from source
+        unsigned int shared;      ///< Number of programs reused from the in-process cache
+        unsigned int loaded;      ///< Number of programs loaded from a binary file
+        unsigned int rejected;    ///< Number of binary files rejected by the driver
+        Time         compileTime; ///< Total time spent creating programs
+    };
+
 public :
 
     ////////////////////////////////////////////////////////////
@@ -491,6 +513,59 @@ public :
     ////////////////////////////////////////////////////////////
     static bool isAvailable();
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the time it took to create the shader program
+    ///
+    /// This is the time spent in the last successful call to
+    /// one of the load functions, including the compilation
+    /// or the loading of the program from the cache.
+    ///
+    /// \return Time spent creating the program
+    ///
+    ////////////////////////////////////////////////////////////
+    Time getCompileTime() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Enable or disable the sharing of identical programs
+    ///
+    /// When enabled, shaders loaded from identical sources share
+    /// a single program object, so each program is only compiled
+    /// once per process. Since the parameters are stored in the
+    /// program, shaders sharing a program share their parameters
+    /// too (except textures, which are bound per shader).
+    /// The sharing is disabled by default.
+    ///
+    /// \param enabled True to share identical programs
+    ///
+    ////////////////////////////////////////////////////////////
+    static void setCacheEnabled(bool enabled);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Set the directory where compiled programs are persisted
+    ///
+    /// When a directory is set and the driver supports program
+    /// binaries (GL_ARB_get_program_binary), each program compiled
+    /// from source is saved there, and loaded back instead of being
+    /// compiled the next time the same sources are loaded.
+    /// Binaries produced by another driver or rejected by the
+    /// current one are ignored, and the program is compiled from
+    /// source again.
+    /// The directory must already exist. Pass an empty string to
+    /// disable the persistence (this is the default).
+    ///
+    /// \param directory Path of the directory
+    ///
+    ////////////////////////////////////////////////////////////
+    static void setCacheDirectory(const std::string& directory);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the statistics about the creation of programs
+    ///
+    /// \return Statistics accumulated since the program started
+    ///
+    ////////////////////////////////////////////////////////////
+    static Statistics getStatistics();
+
 private :
 
     ////////////////////////////////////////////////////////////
@@ -539,6 +614,7 @@ private :
     int          m_currentTexture; ///< Location of the current texture in the shader
     TextureTable m_textures;       ///< Texture variables in the shader, mapped to their location
     ParamTable   m_params;         ///< Parameters location cache
+    Time         m_compileTime;    ///< Time spent creating the program
 };
 
 } // namespace sf
@@ -0,0 +1,267 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2014 Laurent Gomila (laurent.gom@gmail.com)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+
+#ifndef SFML_STATICVERTEXARRAY_HPP
+#define SFML_STATICVERTEXARRAY_HPP
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Graphics/Export.hpp>
+#include <SFML/Graphics/VertexArray.hpp>
+#include <SFML/Window/GlResource.hpp>
+#include <SFML/System/NonCopyable.hpp>
+
+
+namespace sf
+{
+////////////////////////////////////////////////////////////
+/// \brief Set of 2D primitives that can be baked into
+///        graphics memory once it is complete
+///
+////////////////////////////////////////////////////////////
+class SFML_GRAPHICS_API StaticVertexArray : public Drawable, GlResource, NonCopyable
+{
+public :
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Default constructor
+    ///
+    /// Creates an empty vertex array.
+    ///
+    ////////////////////////////////////////////////////////////
+    StaticVertexArray();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Construct the vertex array with a type of primitives
+    ///
+    /// \param type Type of primitives
+    ///
+    ////////////////////////////////////////////////////////////
+    explicit StaticVertexArray(PrimitiveType type);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Destructor
+    ///
+    ////////////////////////////////////////////////////////////
+    ~StaticVertexArray();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Return the vertex count
+    ///
+    /// \return Number of vertices in the array
+    ///
+    ////////////////////////////////////////////////////////////
+    unsigned int getVertexCount() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get a read-only access to a vertex by its index
+    ///
+    /// This function doesn't check \a index, it must be in range
+    /// [0, getVertexCount() - 1]. The behaviour is undefined
+    /// otherwise.
+    ///
+    /// \param index Index of the vertex to get
+    ///
+    /// \return Const reference to the index-th vertex
+    ///
+    /// \see getVertexCount
+    ///
+    ////////////////////////////////////////////////////////////
+    const Vertex& operator [](unsigned int index) const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Clear the vertex array
+    ///
+    /// This function has no effect if the array is baked.
+    ///
+    ////////////////////////////////////////////////////////////
+    void clear();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Resize the vertex array
+    ///
+    /// New vertices are default-constructed, and removed vertices
+    /// are taken from the end of the array.
+    /// This function has no effect if the array is baked.
+    ///
+    /// \param vertexCount New size of the array (number of vertices)
+    ///
+    ////////////////////////////////////////////////////////////
+    void resize(unsigned int vertexCount);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Add a vertex to the array
+    ///
+    /// This function has no effect if the array is baked.
+    ///
+    /// \param vertex Vertex to add
+    ///
+    ////////////////////////////////////////////////////////////
+    void append(const Vertex& vertex);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Add a sequence of vertices to the array
+    ///
+    /// This function has no effect if the array is baked.
+    ///
+    /// \param vertices    Pointer to the vertices to add
+    /// \param vertexCount Number of vertices to add
+    ///
+    ////////////////////////////////////////////////////////////
+    void append(const Vertex* vertices, unsigned int vertexCount);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Set the type of primitives to draw
+    ///
+    /// The default primitive type is sf::Points.
+    /// This function has no effect if the array is baked.
+    ///
+    /// \param type Type of primitive
+    ///
+    ////////////////////////////////////////////////////////////
+    void setPrimitiveType(PrimitiveType type);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the type of primitives drawn by the vertex array
+    ///
+    /// \return Primitive type
+    ///
+    ////////////////////////////////////////////////////////////
+    PrimitiveType getPrimitiveType() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the bounding rectangle of the vertex array
+    ///
+    /// The bounds are maintained while vertices are added, so
+    /// this function never has to iterate over the vertices.
+    ///
+    /// \return Bounding rectangle of the vertex array
+    ///
+    ////////////////////////////////////////////////////////////
+    FloatRect getBounds() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Upload the vertices to graphics memory and make
+    ///        the array immutable
+    ///
+    /// After this call, drawing the array no longer sends its
+    /// vertices to the graphics card. If vertex buffers are
+    /// not supported by the system, the array is still marked
+    /// as baked but keeps being drawn from system memory.
+    ///
+    /// \return True if the vertices were uploaded to a vertex buffer
+    ///
+    /// \see isBaked
+    ///
+    ////////////////////////////////////////////////////////////
+    bool bake();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Tell whether the array has been baked
+    ///
+    /// \return True if bake() was called
+    ///
+    /// \see bake
+    ///
+    ////////////////////////////////////////////////////////////
+    bool isBaked() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Tell whether the system supports baking vertices
+    ///        into graphics memory
+    ///
+    /// \return True if vertex buffers are available
+    ///
+    ////////////////////////////////////////////////////////////
+    static bool isAvailable();
+
+private :
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Draw the vertex array to a render target
+    ///
+    /// \param target Render target to draw to
+    /// \param states Current render states
+    ///
+    ////////////////////////////////////////////////////////////
+    virtual void draw(RenderTarget& target, RenderStates states) const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Check that the array can still be modified
+    ///
+    /// \return True if the array is not baked yet
+    ///
+    ////////////////////////////////////////////////////////////
+    bool checkMutable() const;
+
+    ////////////////////////////////////////////////////////////
+    // Member data
+    ////////////////////////////////////////////////////////////
+    VertexArray  m_vertices; ///< Vertices and cached bounds
+    unsigned int m_buffer;   ///< OpenGL vertex buffer object, or 0 if not uploaded
+    bool         m_isBaked;  ///< Is the array immutable?
+};
+
+} // namespace sf
+
+
+#endif // SFML_STATICVERTEXARRAY_HPP
+
+
+////////////////////////////////////////////////////////////
+/// \class sf::StaticVertexArray
+/// \ingroup graphics
+///
+/// sf::StaticVertexArray is meant for geometry that is built
+/// once and then drawn every frame without changing, like the
+/// tiles of a level. It works like sf::VertexArray until
+/// bake() is called; the vertices are then uploaded to a
+/// vertex buffer object and every subsequent draw only
+/// submits the buffer, without copying vertices.
+///
+/// Once baked, the array is immutable: functions that would
+/// modify it print an error and do nothing.
+///
+/// Like sf::VertexArray, it is not transformable; use the
+/// transform of the render states to move it.
+///
+/// Example:
+/// \code
+/// sf::StaticVertexArray level(sf::Quads);
+/// for (std::size_t i = 0; i < tiles.size(); ++i)
+/// {
+///     level.append(sf::Vertex(...));
+///     ...
+/// }
+/// level.bake();
+///
+/// // in the rendering loop
+/// window.draw(level, &tileset);
+/// \endcode
+///
+/// \see sf::VertexArray, sf::Vertex
+///
+////////////////////////////////////////////////////////////
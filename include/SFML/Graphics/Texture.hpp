@@ -470,6 +470,18 @@ private :
     friend class RenderTexture;
     friend class RenderTarget;
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Create the texture with a specific internal format
+    ///
+    /// \param width          Width of the texture
+    /// \param height         Height of the texture
+    /// \param internalFormat OpenGL internal format of the pixels
+    ///
+    /// \return True if creation was successful
+    ///
+    ////////////////////////////////////////////////////////////
+    bool create(unsigned int width, unsigned int height, unsigned int internalFormat);
+
     ////////////////////////////////////////////////////////////
     /// \brief Get a valid image size according to hardware support
     ///
@@ -166,6 +166,11 @@ public :
     /// This function returns the axis-aligned rectangle that
     /// contains all the vertices of the array.
     ///
+    /// The bounds are cached: they are extended incrementally
+    /// by append and resize, and only recomputed after vertices
+    /// have been accessed through the non-const operator [] or
+    /// removed from the array.
+    ///
     /// \return Bounding rectangle of the vertex array
     ///
     ////////////////////////////////////////////////////////////
@@ -182,13 +187,30 @@ private :
     ////////////////////////////////////////////////////////////
     virtual void draw(RenderTarget& target, RenderStates states) const;
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Extend the cached bounds so that they contain a point
+    ///
+    /// \param position Position of the new vertex
+    /// \param first    True if this is the only vertex of the array
+    ///
+    ////////////////////////////////////////////////////////////
+    void extendBounds(const Vector2f& position, bool first);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Recompute the cached bounds from all the vertices
+    ///
+    ////////////////////////////////////////////////////////////
+    void updateBounds() const;
+
 private:
 
     ////////////////////////////////////////////////////////////
     // Member data
     ////////////////////////////////////////////////////////////
-    std::vector<Vertex> m_vertices;      ///< Vertices contained in the array
-    PrimitiveType       m_primitiveType; ///< Type of primitives to draw
+    std::vector<Vertex> m_vertices;         ///< Vertices contained in the array
+    PrimitiveType       m_primitiveType;    ///< Type of primitives to draw
+    mutable FloatRect   m_bounds;           ///< Cached bounding rectangle of the vertices
+    mutable bool        m_boundsNeedUpdate; ///< Do the cached bounds need to be recomputed?
 };
 
 } // namespace sf
@@ -30,11 +30,21 @@
 ////////////////////////////////////////////////////////////
 
 #include <SFML/System.hpp>
+#include <SFML/Network/BitPacket.hpp>
+#include <SFML/Network/CompressedPacket.hpp>
 #include <SFML/Network/Ftp.hpp>
 #include <SFML/Network/Http.hpp>
 #include <SFML/Network/IpAddress.hpp>
+#include <SFML/Network/NetworkReactor.hpp>
 #include <SFML/Network/Packet.hpp>
+#include <SFML/Network/PacketPool.hpp>
+#include <SFML/Network/ReliableUdpChannel.hpp>
+#include <SFML/Network/Resolver.hpp>
+#include <SFML/Network/Snapshot.hpp>
+#include <SFML/Network/SnapshotDecoder.hpp>
+#include <SFML/Network/SnapshotEncoder.hpp>
 #include <SFML/Network/SocketSelector.hpp>
+#include <SFML/Network/SocketStats.hpp>
 #include <SFML/Network/TcpListener.hpp>
 #include <SFML/Network/TcpSocket.hpp>
 #include <SFML/Network/UdpSocket.hpp>
@@ -0,0 +1,297 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2014 Laurent Gomila (laurent.gom@gmail.com)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+
+#ifndef SFML_BITPACKET_HPP
+#define SFML_BITPACKET_HPP
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Network/Export.hpp>
+#include <SFML/Network/Packet.hpp>
+#include <vector>
+
+
+namespace sf
+{
+////////////////////////////////////////////////////////////
+/// \brief Packet with a compact, bit-packed encoding for
+///        small integers, booleans and ranged floats
+///
+////////////////////////////////////////////////////////////
+class SFML_NETWORK_API BitPacket : public Packet
+{
+public :
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Default constructor
+    ///
+    /// Creates an empty packet.
+    ///
+    ////////////////////////////////////////////////////////////
+    BitPacket();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Clear the packet
+    ///
+    /// After calling Clear, both the regular data and the
+    /// bit-packed data of the packet are empty.
+    ///
+    ////////////////////////////////////////////////////////////
+    void clear();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Test the validity of the packet, for reading
+    ///
+    /// In addition to the checks done by sf::Packet, this
+    /// operator returns false once a bit-packed read failed.
+    ///
+    /// \return True if last data extraction from packet was successful
+    ///
+    ////////////////////////////////////////////////////////////
+    operator BoolType() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Write the lowest bits of an unsigned integer
+    ///
+    /// \param value Value to write
+    /// \param count Number of bits to write, in range [1, 32]
+    ///
+    ////////////////////////////////////////////////////////////
+    BitPacket& writeBits(Uint32 value, unsigned int count);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Write a boolean as a single bit
+    ///
+    /// \param value Value to write
+    ///
+    ////////////////////////////////////////////////////////////
+    BitPacket& writeBool(bool value);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Write an unsigned integer as a variable-length integer
+    ///
+    /// The value is split in groups of 7 bits (LEB128), so
+    /// values below 128 take 1 byte, below 16384 take 2 bytes, etc.
+    ///
+    /// \param value Value to write
+    ///
+    ////////////////////////////////////////////////////////////
+    BitPacket& writeVarint(Uint32 value);
+    BitPacket& writeVarint(Uint64 value);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Write a signed integer as a variable-length integer
+    ///
+    /// The value is zigzag-encoded first, so that values close
+    /// to zero take few bytes whatever their sign.
+    ///
+    /// \param value Value to write
+    ///
+    ////////////////////////////////////////////////////////////
+    BitPacket& writeVarint(Int32 value);
+    BitPacket& writeVarint(Int64 value);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Write a float quantized over a fixed range
+    ///
+    /// The value is clamped to [min, max], and mapped to
+    /// an integer of \a bits bits. The precision of the value
+    /// after reading is (max - min) / (2^bits - 1).
+    ///
+    /// \param value Value to write
+    /// \param min   Lower bound of the range
+    /// \param max   Upper bound of the range
+    /// \param bits  Number of bits to use, in range [1, 32]
+    ///
+    ////////////////////////////////////////////////////////////
+    BitPacket& writeFloat(float value, float min, float max, unsigned int bits);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Read an unsigned integer written with writeBits
+    ///
+    /// \param value Variable to fill
+    /// \param count Number of bits to read, in range [1, 32]
+    ///
+    ////////////////////////////////////////////////////////////
+    BitPacket& readBits(Uint32& value, unsigned int count);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Read a boolean written with writeBool
+    ///
+    /// \param value Variable to fill
+    ///
+    ////////////////////////////////////////////////////////////
+    BitPacket& readBool(bool& value);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Read an integer written with writeVarint
+    ///
+    /// The type of \a value must match the one that was written.
+    ///
+    /// \param value Variable to fill
+    ///
+    ////////////////////////////////////////////////////////////
+    BitPacket& readVarint(Uint32& value);
+    BitPacket& readVarint(Uint64& value);
+    BitPacket& readVarint(Int32& value);
+    BitPacket& readVarint(Int64& value);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Read a float written with writeFloat
+    ///
+    /// \a min, \a max and \a bits must be the same as those
+    /// that were used to write the value.
+    ///
+    /// \param value Variable to fill
+    /// \param min   Lower bound of the range
+    /// \param max   Upper bound of the range
+    /// \param bits  Number of bits used, in range [1, 32]
+    ///
+    ////////////////////////////////////////////////////////////
+    BitPacket& readFloat(float& value, float min, float max, unsigned int bits);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the number of bit-packed bits written in the packet
+    ///
+    /// \return Number of bits
+    ///
+    ////////////////////////////////////////////////////////////
+    std::size_t getBitCount() const;
+
+protected:
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Called before the packet is sent over the network
+    ///
+    /// Puts the bit-packed data in front of the regular data.
+    ///
+    /// \param size Variable to fill with the size of data to send
+    ///
+    /// \return Pointer to the array of bytes to send
+    ///
+    ////////////////////////////////////////////////////////////
+    virtual const void* onSend(std::size_t& size);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Called after the packet is received over the network
+    ///
+    /// Splits the received bytes back into bit-packed data
+    /// and regular data.
+    ///
+    /// \param data Pointer to the received bytes
+    /// \param size Number of bytes
+    ///
+    ////////////////////////////////////////////////////////////
+    virtual void onReceive(const void* data, std::size_t size);
+
+private :
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Write a 64-bits unsigned integer as a varint
+    ///
+    /// \param value Value to write
+    ///
+    ////////////////////////////////////////////////////////////
+    void writeVarint64(Uint64 value);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Read a varint of at most \a maxBits bits
+    ///
+    /// \param value   Variable to fill
+    /// \param maxBits Size of the destination type, in bits
+    ///
+    /// \return True if a valid varint was read
+    ///
+    ////////////////////////////////////////////////////////////
+    bool readVarint64(Uint64& value, unsigned int maxBits);
+
+    ////////////////////////////////////////////////////////////
+    // Member data
+    ////////////////////////////////////////////////////////////
+    std::vector<Uint8> m_bits;        ///< Bit-packed data
+    std::size_t        m_bitWritePos; ///< Number of bits written in m_bits
+    std::size_t        m_bitReadPos;  ///< Current reading position in m_bits, in bits
+    bool               m_bitsValid;   ///< Reading state of the bit-packed data
+    std::vector<char>  m_sendBuffer;  ///< Buffer holding the encoded packet, reused between sends
+};
+
+} // namespace sf
+
+
+#endif // SFML_BITPACKET_HPP
+
+
+////////////////////////////////////////////////////////////
+/// \class sf::BitPacket
+/// \ingroup network
+///
+/// sf::Packet serializes every value at its full width: a
+/// Uint32 always takes 4 bytes, and a bool takes a whole byte.
+/// sf::BitPacket adds a second, bit-packed stream to the packet,
+/// for the values that are usually much smaller than their type:
+/// \li booleans take a single bit
+/// \li integers can be written with an arbitrary number of bits,
+///     or as variable-length integers (LEB128, zigzag-encoded
+///     for signed types)
+/// \li floats can be quantized over a known range, with the
+///     number of bits matching the required precision
+///
+/// The regular sf::Packet operators still work, and write
+/// to the byte-aligned part of the packet; the two parts are
+/// read independently, each in the order it was written.
+///
+/// The bit-packed part is put in front of the regular data in
+/// onSend, and split back in onReceive, so a BitPacket can be
+/// sent and received with sf::TcpSocket and sf::UdpSocket like
+/// any other packet. It must be received in a BitPacket.
+///
+/// Usage example:
+/// \code
+/// sf::BitPacket packet;
+/// packet.writeVarint(entityId)
+///       .writeBool(isJumping)
+///       .writeFloat(angle, 0.f, 360.f, 10)
+///       .writeVarint(health - previousHealth);
+/// packet << playerName;
+/// socket.send(packet);
+///
+/// ...
+///
+/// sf::BitPacket received;
+/// socket.receive(received);
+/// received.readVarint(entityId)
+///         .readBool(isJumping)
+///         .readFloat(angle, 0.f, 360.f, 10)
+///         .readVarint(healthDelta);
+/// if (received >> playerName)
+/// {
+///     // Ok
+/// }
+/// \endcode
+///
+/// \see sf::Packet
+///
+////////////////////////////////////////////////////////////
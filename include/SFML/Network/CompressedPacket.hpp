@@ -0,0 +1,246 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2014 Laurent Gomila (laurent.gom@gmail.com)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+
+#ifndef SFML_COMPRESSEDPACKET_HPP
+#define SFML_COMPRESSEDPACKET_HPP
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Network/Export.hpp>
+#include <SFML/Network/Packet.hpp>
+#include <vector>
+
+
+namespace sf
+{
+////////////////////////////////////////////////////////////
+/// \brief Packet which is compressed before being sent,
+///        and uncompressed after being received
+///
+////////////////////////////////////////////////////////////
+class SFML_NETWORK_API CompressedPacket : public Packet
+{
+public :
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Enumeration of the available codecs
+    ///
+    ////////////////////////////////////////////////////////////
+    enum Codec
+    {
+        Store, ///< No compression, the data is sent as is
+        Lz4    ///< Fast LZ77 compression, using the LZ4 block format
+    };
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Default constructor
+    ///
+    /// \param codec     Codec used to compress the packets
+    /// \param threshold Minimum size of the data to compress, in bytes
+    /// \param streaming True to reuse the history of the previous packets
+    ///
+    /// \see setCodec, setThreshold, setStreaming
+    ///
+    ////////////////////////////////////////////////////////////
+    CompressedPacket(Codec codec = Lz4, std::size_t threshold = 64, bool streaming = false);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Change the codec used to compress the packet
+    ///
+    /// The codec only affects sending: the receiver reads
+    /// the codec from the packet data.
+    ///
+    /// \param codec New codec
+    ///
+    /// \see getCodec
+    ///
+    ////////////////////////////////////////////////////////////
+    void setCodec(Codec codec);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the codec used to compress the packet
+    ///
+    /// \return Current codec
+    ///
+    /// \see setCodec
+    ///
+    ////////////////////////////////////////////////////////////
+    Codec getCodec() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Change the minimum size of the data to compress
+    ///
+    /// Packets smaller than the threshold are sent uncompressed,
+    /// as compressing them would cost time for little or no gain.
+    /// Packets which don't get smaller when compressed are
+    /// always sent uncompressed.
+    ///
+    /// \param threshold Minimum size, in bytes
+    ///
+    /// \see getThreshold
+    ///
+    ////////////////////////////////////////////////////////////
+    void setThreshold(std::size_t threshold);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the minimum size of the data to compress
+    ///
+    /// \return Minimum size, in bytes
+    ///
+    /// \see setThreshold
+    ///
+    ////////////////////////////////////////////////////////////
+    std::size_t getThreshold() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Enable or disable the streaming mode
+    ///
+    /// In streaming mode, the last 64 KB sent (resp. received)
+    /// through this packet are used as a dictionary when
+    /// compressing (resp. uncompressing) the next packet, which
+    /// greatly improves the compression of small, similar packets.
+    /// This requires that all the packets sent with this object
+    /// are received, in the same order, by a single packet object
+    /// also in streaming mode: use it only with sf::TcpSocket,
+    /// and keep one packet object per connection.
+    ///
+    /// Changing the mode resets the history.
+    ///
+    /// \param streaming True to enable the streaming mode
+    ///
+    /// \see isStreaming, resetStream
+    ///
+    ////////////////////////////////////////////////////////////
+    void setStreaming(bool streaming);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Tell whether the streaming mode is enabled
+    ///
+    /// \return True if the streaming mode is enabled
+    ///
+    /// \see setStreaming
+    ///
+    ////////////////////////////////////////////////////////////
+    bool isStreaming() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Forget the history used in streaming mode
+    ///
+    /// This must be done on both sides of the connection,
+    /// for example after reconnecting.
+    ///
+    /// \see setStreaming
+    ///
+    ////////////////////////////////////////////////////////////
+    void resetStream();
+
+protected:
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Compress the packet data before it is sent
+    ///
+    /// \param size Variable to fill with the size of data to send
+    ///
+    /// \return Pointer to the array of bytes to send
+    ///
+    ////////////////////////////////////////////////////////////
+    virtual const void* onSend(std::size_t& size);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Uncompress the packet data after it is received
+    ///
+    /// If the received data is corrupted, the packet is left empty.
+    ///
+    /// \param data Pointer to the received bytes
+    /// \param size Number of bytes
+    ///
+    ////////////////////////////////////////////////////////////
+    virtual void onReceive(const void* data, std::size_t size);
+
+private :
+
+    ////////////////////////////////////////////////////////////
+    // Member data
+    ////////////////////////////////////////////////////////////
+    Codec               m_codec;         ///< Codec used to compress the packets
+    std::size_t         m_threshold;     ///< Minimum size of the data to compress
+    bool                m_streaming;     ///< Is the streaming mode enabled?
+    std::vector<char>   m_output;        ///< Buffer holding the data to send, reused between sends
+    std::vector<Uint32> m_hashTable;     ///< Positions of the last occurrences of 4-bytes sequences
+    std::vector<char>   m_sendHistory;   ///< Last bytes sent, in streaming mode
+    Uint32              m_sendPosition;  ///< Position of the next byte to send in the stream
+    std::vector<char>   m_receiveBuffer; ///< Last bytes received in streaming mode, followed by the uncompressed data
+};
+
+} // namespace sf
+
+
+#endif // SFML_COMPRESSEDPACKET_HPP
+
+
+////////////////////////////////////////////////////////////
+/// \class sf::CompressedPacket
+/// \ingroup network
+///
+/// sf::CompressedPacket is a packet which transparently
+/// compresses its data in onSend, and uncompresses it in
+/// onReceive. It can be used with sf::TcpSocket and
+/// sf::UdpSocket like any other packet, and must be
+/// received in a CompressedPacket.
+///
+/// The built-in LZ4 codec is very fast, both to compress
+/// and to uncompress, and works well on repetitive data such
+/// as maps, text or arrays of similar structures. Packets
+/// smaller than a threshold, or which don't compress, are sent
+/// as they are, with a single byte of overhead.
+///
+/// The buffers and tables used to compress are kept by the
+/// packet and reused: to avoid allocations, keep a packet
+/// object per connection rather than creating one for
+/// every message.
+///
+/// In streaming mode, the history of the previous packets
+/// is used as a dictionary, so that even small messages
+/// which repeat the contents of earlier ones (chat, state
+/// updates) are compressed efficiently. See setStreaming
+/// for the constraints of this mode.
+///
+/// Usage example:
+/// \code
+/// sf::CompressedPacket packet;
+/// packet.writeArray(&tiles[0], tiles.size());
+/// socket.send(packet);
+///
+/// ...
+///
+/// sf::CompressedPacket received;
+/// socket.receive(received);
+/// received.readArray(&tiles[0], tiles.size());
+/// \endcode
+///
+/// \see sf::Packet
+///
+////////////////////////////////////////////////////////////
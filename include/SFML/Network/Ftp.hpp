@@ -30,7 +30,9 @@
 ////////////////////////////////////////////////////////////
 #include <SFML/Network/Export.hpp>
 #include <SFML/Network/TcpSocket.hpp>
+#include <SFML/System/InputStream.hpp>
 #include <SFML/System/NonCopyable.hpp>
+#include <SFML/System/OutputStream.hpp>
 #include <SFML/System/Time.hpp>
 #include <string>
 #include <vector>
@@ -247,6 +249,37 @@ public :
         std::vector<std::string> m_listing; ///< Directory/file names extracted from the data
     };
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Receive the progress of file transfers
+    ///
+    ////////////////////////////////////////////////////////////
+    class SFML_NETWORK_API ProgressListener
+    {
+    public :
+
+        ////////////////////////////////////////////////////////////
+        /// \brief Virtual destructor
+        ///
+        ////////////////////////////////////////////////////////////
+        virtual ~ProgressListener();
+
+        ////////////////////////////////////////////////////////////
+        /// \brief Called each time a part of the file is transferred
+        ///
+        /// \param transferred Number of bytes transferred so far
+        /// \param total       Size of the file, or 0 if it is unknown
+        ///
+        /// \return True to continue, false to abort the transfer
+        ///
+        ////////////////////////////////////////////////////////////
+        virtual bool onProgress(Uint64 transferred, Uint64 total) = 0;
+    };
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Default constructor
+    ///
+    ////////////////////////////////////////////////////////////
+    Ftp();
 
     ////////////////////////////////////////////////////////////
     /// \brief Destructor
@@ -453,16 +486,41 @@ public :
     /// destination path is relative to the current directory
     /// of your application.
     ///
+    /// The file is written progressively as it is received,
+    /// so it is never held entirely in memory. If the download
+    /// fails or is aborted, the incomplete file is removed.
+    ///
     /// \param remoteFile Filename of the distant file to download
     /// \param localPath  The directory in which to put the file on the local computer
     /// \param mode       Transfer mode
+    /// \param listener   Listener notified of the progress of the transfer (can be NULL)
     ///
     /// \return Server response to the request
     ///
     /// \see upload
     ///
     ////////////////////////////////////////////////////////////
-    Response download(const std::string& remoteFile, const std::string& localPath, TransferMode mode = Binary);
+    Response download(const std::string& remoteFile, const std::string& localPath, TransferMode mode = Binary, ProgressListener* listener = NULL);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Download a file from the server to a stream
+    ///
+    /// The filename of the distant file is relative to the
+    /// current working directory of the server. The data is
+    /// written to \a stream progressively, in chunks of the
+    /// size of the transfer buffer.
+    ///
+    /// \param remoteFile Filename of the distant file to download
+    /// \param stream     Stream to write the file to
+    /// \param mode       Transfer mode
+    /// \param listener   Listener notified of the progress of the transfer (can be NULL)
+    ///
+    /// \return Server response to the request
+    ///
+    /// \see upload, setTransferBufferSize
+    ///
+    ////////////////////////////////////////////////////////////
+    Response download(const std::string& remoteFile, OutputStream& stream, TransferMode mode = Binary, ProgressListener* listener = NULL);
 
     ////////////////////////////////////////////////////////////
     /// \brief Upload a file to the server
@@ -472,16 +530,52 @@ public :
     /// remote path is relative to the current directory of the
     /// FTP server.
     ///
+    /// The file is read progressively as it is sent, so it is
+    /// never held entirely in memory.
+    ///
     /// \param localFile  Path of the local file to upload
     /// \param remotePath The directory in which to put the file on the server
     /// \param mode       Transfer mode
+    /// \param listener   Listener notified of the progress of the transfer (can be NULL)
     ///
     /// \return Server response to the request
     ///
     /// \see download
     ///
     ////////////////////////////////////////////////////////////
-    Response upload(const std::string& localFile, const std::string& remotePath, TransferMode mode = Binary);
+    Response upload(const std::string& localFile, const std::string& remotePath, TransferMode mode = Binary, ProgressListener* listener = NULL);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Upload the contents of a stream to the server
+    ///
+    /// The remote file name is relative to the current directory
+    /// of the FTP server. The stream is read from its current
+    /// position until its end, in chunks of the size of the
+    /// transfer buffer.
+    ///
+    /// \param stream     Stream to read the file from
+    /// \param remoteFile Path of the file to create on the server
+    /// \param mode       Transfer mode
+    /// \param listener   Listener notified of the progress of the transfer (can be NULL)
+    ///
+    /// \return Server response to the request
+    ///
+    /// \see download, setTransferBufferSize
+    ///
+    ////////////////////////////////////////////////////////////
+    Response upload(InputStream& stream, const std::string& remoteFile, TransferMode mode = Binary, ProgressListener* listener = NULL);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Change the size of the buffer used for file transfers
+    ///
+    /// Bigger buffers mean fewer system calls and writes to
+    /// the destination, at the cost of memory. The size can't
+    /// be smaller than 64 KB, which is the default.
+    ///
+    /// \param size Size of the buffer, in bytes
+    ///
+    ////////////////////////////////////////////////////////////
+    void setTransferBufferSize(std::size_t size);
 
     ////////////////////////////////////////////////////////////
     /// \brief Send a command to the FTP server
@@ -526,7 +620,8 @@ private:
     ////////////////////////////////////////////////////////////
     // Member data
     ////////////////////////////////////////////////////////////
-    TcpSocket m_commandSocket; ///< Socket holding the control connection with the server
+    TcpSocket   m_commandSocket; ///< Socket holding the control connection with the server
+    std::size_t m_bufferSize;    ///< Size of the buffer used for file transfers
 };
 
 } // namespace sf
@@ -561,7 +656,12 @@ private:
 /// All commands, especially upload and download, may take some
 /// time to complete. This is important to know if you don't want
 /// to block your application while the server is completing
-/// the task.
+/// the task. Transfers can be followed, and aborted, with a
+/// sf::Ftp::ProgressListener.
+///
+/// Files are transferred progressively, without being loaded
+/// in memory; they can also be read from a sf::InputStream or
+/// written to a sf::OutputStream instead of a local file.
 ///
 /// Usage example:
 /// \code
@@ -32,9 +32,11 @@
 #include <SFML/Network/IpAddress.hpp>
 #include <SFML/Network/TcpSocket.hpp>
 #include <SFML/System/NonCopyable.hpp>
+#include <SFML/System/OutputStream.hpp>
 #include <SFML/System/Time.hpp>
 #include <map>
 #include <string>
+#include <vector>
 
 
 namespace sf
@@ -311,9 +313,10 @@ public :
         /// \brief Construct the header from a response string
         ///
         /// This function is used by Http to build the response
-        /// of a request.
+        /// of a request. The body is read separately, according
+        /// to the framing announced by the header.
         ///
-        /// \param data Content of the response to parse
+        /// \param data Status line and header fields of the response
         ///
         ////////////////////////////////////////////////////////////
         void parse(const std::string& data);
@@ -345,6 +348,51 @@ public :
         std::string  m_body;         ///< Body of the response
     };
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Receive the response of a request progressively
+    ///
+    ////////////////////////////////////////////////////////////
+    class SFML_NETWORK_API ResponseHandler
+    {
+    public :
+
+        ////////////////////////////////////////////////////////////
+        /// \brief Virtual destructor
+        ///
+        ////////////////////////////////////////////////////////////
+        virtual ~ResponseHandler();
+
+        ////////////////////////////////////////////////////////////
+        /// \brief Called when the header of the response is received
+        ///
+        /// This function is called before the body is received:
+        /// the status and the header fields (such as
+        /// "Content-Length", to report progress) are available,
+        /// but the body is empty. The default implementation
+        /// accepts the body.
+        ///
+        /// \param response Response, without its body
+        ///
+        /// \return True to receive the body, false to abort
+        ///
+        ////////////////////////////////////////////////////////////
+        virtual bool onHeader(const Response& response);
+
+        ////////////////////////////////////////////////////////////
+        /// \brief Called when a part of the body is received
+        ///
+        /// The body is delivered in order, in chunks of arbitrary
+        /// size, as it is received from the server.
+        ///
+        /// \param data Pointer to the received bytes
+        /// \param size Number of bytes
+        ///
+        /// \return True to continue, false to abort
+        ///
+        ////////////////////////////////////////////////////////////
+        virtual bool onBody(const char* data, std::size_t size) = 0;
+    };
+
     ////////////////////////////////////////////////////////////
     /// \brief Default constructor
     ///
@@ -395,6 +443,8 @@ public :
     /// application, or use a timeout to limit the time to wait. A value
     /// of Time::Zero means that the client will use the system defaut timeout
     /// (which is usually pretty long).
+    /// If the connection is lost before the whole body is received,
+    /// the returned response has the ConnectionFailed status.
     ///
     /// \param request Request to send
     /// \param timeout Maximum time to wait
@@ -404,15 +454,178 @@ public :
     ////////////////////////////////////////////////////////////
     Response sendRequest(const Request& request, Time timeout = Time::Zero);
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Send a HTTP request and stream the server's response
+    ///         to a handler
+    ///
+    /// This function behaves like the other overload, but the
+    /// body of the response is passed to \a handler as it is
+    /// received, instead of being stored in the returned
+    /// response. Thus, the memory used doesn't depend on the
+    /// size of the body.
+    /// If the handler aborts the transfer, the connection
+    /// is closed. If the body is not received entirely, because
+    /// the handler aborted it from onBody or because the
+    /// connection was lost, the returned response has the
+    /// Response::ConnectionFailed status, whatever the status
+    /// sent by the server.
+    ///
+    /// \param request Request to send
+    /// \param handler Handler which receives the response
+    /// \param timeout Maximum time to wait
+    ///
+    /// \return Server's response, with an empty body
+    ///
+    ////////////////////////////////////////////////////////////
+    Response sendRequest(const Request& request, ResponseHandler& handler, Time timeout = Time::Zero);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Send a HTTP request and write the body of the
+    ///         server's response to a stream
+    ///
+    /// The body is written to \a body as it is received, only
+    /// if the response has a success status (2xx); otherwise
+    /// the body is not received.
+    /// If writing to \a body fails, or if the connection is lost
+    /// before the end of the body, the returned response has
+    /// the Response::ConnectionFailed status: what was written
+    /// to the stream is then incomplete.
+    ///
+    /// \param request Request to send
+    /// \param body    Stream to write the body of the response to
+    /// \param timeout Maximum time to wait
+    ///
+    /// \return Server's response, with an empty body
+    ///
+    ////////////////////////////////////////////////////////////
+    Response sendRequest(const Request& request, OutputStream& body, Time timeout = Time::Zero);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Send several HTTP requests and return the server's responses
+    ///
+    /// The requests are sent in order, and \a responses is filled
+    /// with one response per request, in the same order.
+    /// If persistent connections are enabled, consecutive requests
+    /// that are not POST requests are pipelined: they are all sent
+    /// before the responses are read, which saves a round-trip
+    /// per request. If the server closes the connection before
+    /// answering all of them, the remaining requests are sent
+    /// again on a new connection.
+    /// The responses of the requests which could not be sent
+    /// have the ConnectionFailed status.
+    ///
+    /// \param requests  Requests to send
+    /// \param responses Vector to fill with the server's responses
+    /// \param timeout   Maximum time to wait for each connection
+    ///
+    /// \see sendRequest, setKeepAlive
+    ///
+    ////////////////////////////////////////////////////////////
+    void sendRequests(const std::vector<Request>& requests, std::vector<Response>& responses, Time timeout = Time::Zero);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Enable or disable persistent connections
+    ///
+    /// When enabled, the connection to the host is kept open
+    /// after a request (unless the server closes it), and reused
+    /// by the next requests, which saves the cost of connecting
+    /// again. This is disabled by default: the connection is
+    /// closed after each request.
+    ///
+    /// \param enabled True to keep the connection open between requests
+    ///
+    /// \see sendRequests
+    ///
+    ////////////////////////////////////////////////////////////
+    void setKeepAlive(bool enabled);
+
 private :
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Send requests and receive their responses
+    ///
+    /// \param requests  Requests to send
+    /// \param responses Vector to fill with the server's responses
+    /// \param timeout   Maximum time to wait for each connection
+    /// \param handler   Handler which receives the response, or NULL
+    ///                  to store the body in the response
+    ///
+    ////////////////////////////////////////////////////////////
+    void send(const std::vector<Request>& requests, std::vector<Response>& responses, Time timeout, ResponseHandler* handler);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Add the missing mandatory fields to a request and
+    ///        convert it to a string
+    ///
+    /// \param request Request to prepare
+    ///
+    /// \return String containing the request, ready to be sent
+    ///
+    ////////////////////////////////////////////////////////////
+    std::string prepare(const Request& request) const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Read the response to a request from the connection
+    ///
+    /// \param response  Response to fill
+    /// \param isHead    Is the response to a HEAD request (which has no body)?
+    /// \param keepAlive Filled with true if the connection can be reused
+    /// \param handler   Handler which receives the response, or NULL
+    ///
+    /// \return True if at least the header of the response was received
+    ///
+    ////////////////////////////////////////////////////////////
+    bool receiveResponse(Response& response, bool isHead, bool& keepAlive, ResponseHandler* handler);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Read a line from the connection, without its line ending
+    ///
+    /// \param line String to fill
+    ///
+    /// \return True if a complete line was read
+    ///
+    ////////////////////////////////////////////////////////////
+    bool receiveLine(std::string& line);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Read a part of the body from the connection
+    ///
+    /// \param size        Number of bytes to read
+    /// \param untilClosed Ignore \a size and read until the connection is closed
+    /// \param response    Response to append the bytes to, if there's no handler
+    /// \param handler     Handler which receives the bytes, or NULL
+    ///
+    /// \return True if all the bytes were read and accepted
+    ///
+    ////////////////////////////////////////////////////////////
+    bool receiveBody(std::size_t size, bool untilClosed, Response& response, ResponseHandler* handler);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Receive more bytes from the connection into the buffer
+    ///
+    /// \return True if bytes were received, false if the connection
+    ///         was closed or an error occurred
+    ///
+    ////////////////////////////////////////////////////////////
+    bool receiveMore();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Close the connection and drop the buffered data
+    ///
+    ////////////////////////////////////////////////////////////
+    void disconnect();
+
     ////////////////////////////////////////////////////////////
     // Member data
     ////////////////////////////////////////////////////////////
-    TcpSocket      m_connection; ///< Connection to the host
-    IpAddress      m_host;       ///< Web host address
-    std::string    m_hostName;   ///< Web host name
-    unsigned short m_port;       ///< Port used for connection with host
+    TcpSocket         m_connection; ///< Connection to the host
+    IpAddress         m_host;       ///< Web host address
+    std::string       m_hostName;   ///< Web host name
+    unsigned short    m_port;       ///< Port used for connection with host
+    bool              m_keepAlive;  ///< Keep the connection open between requests?
+    bool              m_connected;  ///< Is the connection open?
+    std::vector<char> m_buffer;     ///< Data received but not read yet
+    std::size_t       m_position;   ///< Reading position in m_buffer
 };
 
 } // namespace sf
@@ -453,6 +666,16 @@ private :
 /// sf::Http::Request and return the corresponding sf::Http::Response
 /// from the server.
 ///
+/// Big responses, such as files, can be received progressively
+/// with the overloads of sendRequest which take a
+/// sf::Http::ResponseHandler or a sf::OutputStream: the body
+/// is then never stored entirely in memory.
+///
+/// By default, a new connection is opened for every request.
+/// When many requests are sent to the same host, persistent
+/// connections (see setKeepAlive) avoid the cost of connecting
+/// each time, and sendRequests can pipeline them.
+///
 /// Usage example:
 /// \code
 /// // Create a new HTTP client
@@ -58,6 +58,10 @@ public :
     ///
     /// Here \a address can be either a decimal address
     /// (ex: "192.168.1.56") or a network name (ex: "localhost").
+    /// Network names are looked up in the cache of sf::Resolver
+    /// first; if they are not found, this constructor blocks until
+    /// the name is resolved. Use sf::Resolver::resolveAsync to
+    /// resolve names without blocking.
     ///
     /// \param address IP address or network name
     ///
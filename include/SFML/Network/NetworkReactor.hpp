@@ -0,0 +1,423 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2014 Laurent Gomila (laurent.gom@gmail.com)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+
+#ifndef SFML_NETWORKREACTOR_HPP
+#define SFML_NETWORKREACTOR_HPP
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Network/Export.hpp>
+#include <SFML/Network/Socket.hpp>
+#include <SFML/System/Mutex.hpp>
+#include <SFML/System/NonCopyable.hpp>
+#include <SFML/System/Time.hpp>
+#include <map>
+#include <vector>
+
+
+namespace sf
+{
+namespace priv
+{
+    class ReactorShard;
+}
+
+class IpAddress;
+class Packet;
+class TcpListener;
+class TcpSocket;
+class UdpSocket;
+
+////////////////////////////////////////////////////////////
+/// \brief Event loop that drives listeners and sockets and
+///        dispatches their events to callbacks
+///
+////////////////////////////////////////////////////////////
+class SFML_NETWORK_API NetworkReactor : NonCopyable
+{
+public :
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Receive the events of the sockets of a reactor
+    ///
+    /// The callbacks are called from the thread that runs the
+    /// socket: the thread calling update, or one of the threads
+    /// started by launch. The default implementations do nothing.
+    ///
+    ////////////////////////////////////////////////////////////
+    class SFML_NETWORK_API Handler
+    {
+    public :
+
+        ////////////////////////////////////////////////////////////
+        /// \brief Virtual destructor
+        ///
+        ////////////////////////////////////////////////////////////
+        virtual ~Handler();
+
+        ////////////////////////////////////////////////////////////
+        /// \brief Called when a listener accepts a new connection
+        ///
+        /// The socket is owned by the reactor: it stays valid
+        /// until onDisconnect is called for it, after which it
+        /// is destroyed. It can already be used to send data.
+        /// If it is removed from the reactor instead, the caller
+        /// of remove takes its ownership (see remove).
+        ///
+        /// \param listener Listener that accepted the connection
+        /// \param socket   Socket of the new connection
+        ///
+        ////////////////////////////////////////////////////////////
+        virtual void onAccept(TcpListener& listener, TcpSocket& socket);
+
+        ////////////////////////////////////////////////////////////
+        /// \brief Called when a packet is received on a TCP socket
+        ///
+        /// The packet is reused for the next packets, copy what
+        /// you need to keep.
+        ///
+        /// \param socket Socket that received the packet
+        /// \param packet Received packet
+        ///
+        ////////////////////////////////////////////////////////////
+        virtual void onPacket(TcpSocket& socket, Packet& packet);
+
+        ////////////////////////////////////////////////////////////
+        /// \brief Called when a packet is received on a UDP socket
+        ///
+        /// The packet is reused for the next packets, copy what
+        /// you need to keep.
+        ///
+        /// \param socket Socket that received the packet
+        /// \param packet Received packet
+        /// \param sender Address of the peer that sent the packet
+        /// \param port   Port of the peer that sent the packet
+        ///
+        ////////////////////////////////////////////////////////////
+        virtual void onPacket(UdpSocket& socket, Packet& packet, const IpAddress& sender, unsigned short port);
+
+        ////////////////////////////////////////////////////////////
+        /// \brief Called when a TCP connection is closed
+        ///
+        /// This function is called when the remote peer closes
+        /// the connection, when an error occurs, and when the
+        /// socket is disconnected with NetworkReactor::disconnect.
+        /// The socket is no longer watched by the reactor; if it
+        /// was created by the reactor, it is destroyed right after
+        /// this call.
+        ///
+        /// \param socket Socket of the closed connection
+        ///
+        ////////////////////////////////////////////////////////////
+        virtual void onDisconnect(TcpSocket& socket);
+
+        ////////////////////////////////////////////////////////////
+        /// \brief Called when the send queue of a TCP socket is empty again
+        ///
+        /// When the remote peer doesn't receive as fast as the data
+        /// is sent, the data is queued in the socket and written as
+        /// soon as possible (see TcpSocket::getQueuedBytes). This
+        /// function is called once all the queued data has been
+        /// written, which is the time to resume sending if you
+        /// stopped because the queue was growing.
+        ///
+        /// \param socket Socket whose send queue is empty
+        ///
+        ////////////////////////////////////////////////////////////
+        virtual void onWritable(TcpSocket& socket);
+    };
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Construct the reactor
+    ///
+    /// \param handler Handler receiving the events of the sockets
+    ///
+    ////////////////////////////////////////////////////////////
+    explicit NetworkReactor(Handler& handler);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Destructor
+    ///
+    /// Stops the threads and destroys the sockets created by
+    /// the reactor, without calling the handler.
+    ///
+    ////////////////////////////////////////////////////////////
+    ~NetworkReactor();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Start watching a listener for incoming connections
+    ///
+    /// The listener must be listening, and must stay alive until
+    /// it is removed or the reactor is destroyed. It is switched
+    /// to non-blocking mode.
+    ///
+    /// \param listener Listener to watch
+    ///
+    /// \see remove
+    ///
+    ////////////////////////////////////////////////////////////
+    void add(TcpListener& listener);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Start watching a connected TCP socket
+    ///
+    /// The socket must stay alive until it is removed, until
+    /// onDisconnect is called for it, or until the reactor is
+    /// destroyed. It is switched to non-blocking mode.
+    ///
+    /// \param socket Socket to watch
+    ///
+    /// \see remove
+    ///
+    ////////////////////////////////////////////////////////////
+    void add(TcpSocket& socket);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Start watching a bound UDP socket
+    ///
+    /// The socket must stay alive until it is removed or the
+    /// reactor is destroyed. It is switched to non-blocking mode.
+    ///
+    /// \param socket Socket to watch
+    ///
+    /// \see remove
+    ///
+    ////////////////////////////////////////////////////////////
+    void add(UdpSocket& socket);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Stop watching a listener or a socket
+    ///
+    /// When this function returns, the reactor no longer uses
+    /// the socket, which can be destroyed. No callback is
+    /// called. This function has no effect if the socket is
+    /// not watched by the reactor.
+    /// A socket created by the reactor for an accepted connection
+    /// is not destroyed by this function: the caller becomes its
+    /// owner, and must destroy it with \c delete when it no longer
+    /// needs it.
+    ///
+    /// \param socket Listener or socket to stop watching
+    ///
+    /// \see add
+    ///
+    ////////////////////////////////////////////////////////////
+    void remove(Socket& socket);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Send a packet to a TCP socket watched by the reactor
+    ///
+    /// This function can be called from any thread. The part of
+    /// the packet that can't be written immediately is queued in
+    /// the socket and written by the reactor when possible,
+    /// followed by a call to onWritable.
+    ///
+    /// \param socket Socket to send the packet to
+    /// \param packet Packet to send
+    ///
+    /// \return Status code
+    ///
+    ////////////////////////////////////////////////////////////
+    Socket::Status send(TcpSocket& socket, Packet& packet);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Close a TCP connection watched by the reactor
+    ///
+    /// The data queued in the socket is written if possible,
+    /// then the socket is disconnected and onDisconnect is
+    /// called from the thread that runs the socket.
+    ///
+    /// \param socket Socket to disconnect
+    ///
+    ////////////////////////////////////////////////////////////
+    void disconnect(TcpSocket& socket);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Wait for events and dispatch them, in the calling thread
+    ///
+    /// This function is meant to be called repeatedly by a
+    /// program that doesn't launch threads for the reactor
+    /// (typically once per frame with a small timeout). All the
+    /// functions of the reactor must then be called from the
+    /// same thread.
+    /// It has no effect if the reactor runs its own threads.
+    ///
+    /// \param timeout Maximum time to wait, (use Time::Zero for infinity)
+    ///
+    /// \return True if some events were dispatched, false otherwise
+    ///
+    /// \see launch
+    ///
+    ////////////////////////////////////////////////////////////
+    bool update(Time timeout = Time::Zero);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Run the reactor in its own threads
+    ///
+    /// Each thread runs its own share of the sockets: listeners
+    /// and UDP sockets are run by the first thread, connections
+    /// go to the thread that has the fewest sockets when they
+    /// are added or accepted. If the reactor was launched with
+    /// more threads before, that many threads are launched again.
+    /// This function has no effect if the threads are already
+    /// running.
+    ///
+    /// \param threadCount Number of threads to launch
+    ///
+    /// \see stop, update
+    ///
+    ////////////////////////////////////////////////////////////
+    void launch(unsigned int threadCount = 1);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Stop the threads of the reactor
+    ///
+    /// This function waits until the threads have finished
+    /// dispatching their current events. The sockets stay
+    /// watched, and can then be driven with update or another
+    /// call to launch. It must not be called from a callback.
+    ///
+    /// \see launch
+    ///
+    ////////////////////////////////////////////////////////////
+    void stop();
+
+private :
+
+    friend class priv::ReactorShard;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Kinds of sockets watched by the reactor
+    ///
+    ////////////////////////////////////////////////////////////
+    enum SocketKind
+    {
+        Listener,   ///< TcpListener accepting connections
+        Connection, ///< Connected TcpSocket
+        Datagram    ///< Bound UdpSocket
+    };
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Start watching a socket
+    ///
+    /// \param socket  Socket to watch
+    /// \param kind    Kind of the socket
+    /// \param owned   Was the socket created by the reactor?
+    /// \param current Shard calling this function, or NULL if called by the user
+    ///
+    ////////////////////////////////////////////////////////////
+    void addSocket(Socket& socket, SocketKind kind, bool owned, priv::ReactorShard* current);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Forget the shard of a socket
+    ///
+    /// \param socket Socket to forget
+    ///
+    ////////////////////////////////////////////////////////////
+    void forgetSocket(Socket& socket);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Find the shard that runs a socket
+    ///
+    /// \param socket Socket to look for
+    ///
+    /// \return Shard of the socket, or NULL if it is not watched
+    ///
+    ////////////////////////////////////////////////////////////
+    priv::ReactorShard* findShard(Socket& socket) const;
+
+    ////////////////////////////////////////////////////////////
+    // Member data
+    ////////////////////////////////////////////////////////////
+    Handler&                               m_handler; ///< Handler receiving the events
+    std::vector<priv::ReactorShard*>       m_shards;  ///< Shards of the reactor, one per thread
+    std::map<Socket*, priv::ReactorShard*> m_owners;  ///< Shard that runs each socket
+    bool                                   m_running; ///< Are the threads running?
+    mutable Mutex                          m_mutex;   ///< Mutex protecting the shards and owners
+};
+
+} // namespace sf
+
+
+#endif // SFML_NETWORKREACTOR_HPP
+
+
+////////////////////////////////////////////////////////////
+/// \class sf::NetworkReactor
+/// \ingroup network
+///
+/// sf::NetworkReactor replaces the hand-written loop around a
+/// sf::SocketSelector: it owns the registrations of listeners
+/// and sockets, accepts incoming connections, receives the
+/// packets, writes the data that could not be sent immediately,
+/// and reports all of this to a handler.
+///
+/// All the sockets are used in non-blocking mode, so one thread
+/// serves any number of slow clients. Only the sockets that are
+/// ready are visited on each wake-up.
+///
+/// The reactor can run in the thread of the program, with
+/// update, or in its own threads with launch. With several
+/// threads, the connections are spread across the threads
+/// (each one has its own selector), and the callbacks of
+/// different connections may be called concurrently; the
+/// callbacks of a given connection are always called from
+/// the same thread.
+///
+/// Usage example:
+/// \code
+/// class Server : public sf::NetworkReactor::Handler
+/// {
+/// public :
+///
+///     Server() : reactor(*this)
+///     {
+///         listener.listen(55001);
+///         reactor.add(listener);
+///     }
+///
+///     virtual void onAccept(sf::TcpListener&, sf::TcpSocket& socket)
+///     {
+///         std::cout << "New client: " << socket.getRemoteAddress() << std::endl;
+///     }
+///
+///     virtual void onPacket(sf::TcpSocket& socket, sf::Packet& packet)
+///     {
+///         // Echo the packet
+///         reactor.send(socket, packet);
+///     }
+///
+///     sf::TcpListener     listener;
+///     sf::NetworkReactor  reactor;
+/// };
+///
+/// Server server;
+/// server.reactor.launch(4);
+/// \endcode
+///
+/// \see sf::SocketSelector, sf::TcpSocket
+///
+////////////////////////////////////////////////////////////
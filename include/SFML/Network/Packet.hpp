@@ -46,6 +46,8 @@ class UdpSocket;
 ////////////////////////////////////////////////////////////
 class SFML_NETWORK_API Packet
 {
+protected :
+
     // A bool-like type that cannot be converted to integer or pointer types
     typedef bool (Packet::*BoolType)(std::size_t);
 
@@ -76,6 +78,21 @@ public :
     ////////////////////////////////////////////////////////////
     void append(const void* data, std::size_t sizeInBytes);
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Reserve memory for the data of the packet
+    ///
+    /// This function doesn't change the contents of the packet,
+    /// it only makes sure that up to \a sizeInBytes bytes can be
+    /// written without any reallocation. Memory reserved by a
+    /// packet is kept when it is cleared.
+    ///
+    /// \param sizeInBytes Number of bytes to reserve
+    ///
+    /// \see append, clear
+    ///
+    ////////////////////////////////////////////////////////////
+    void reserve(std::size_t sizeInBytes);
+
     ////////////////////////////////////////////////////////////
     /// \brief Clear the packet
     ///
@@ -208,10 +225,60 @@ public:
     Packet& operator <<(const std::wstring& data);
     Packet& operator <<(const String&       data);
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Write an array of values into the packet
+    ///
+    /// The values are converted to network byte order and
+    /// appended in a single pass, which is much faster than
+    /// writing them one by one. The number of elements is not
+    /// written, you must write it yourself if the receiver
+    /// doesn't know it.
+    ///
+    /// \param data  Pointer to the first element of the array
+    /// \param count Number of elements to write
+    ///
+    /// \return Reference to the packet
+    ///
+    /// \see readArray
+    ///
+    ////////////////////////////////////////////////////////////
+    Packet& writeArray(const Int8*   data, std::size_t count);
+    Packet& writeArray(const Uint8*  data, std::size_t count);
+    Packet& writeArray(const Int16*  data, std::size_t count);
+    Packet& writeArray(const Uint16* data, std::size_t count);
+    Packet& writeArray(const Int32*  data, std::size_t count);
+    Packet& writeArray(const Uint32* data, std::size_t count);
+    Packet& writeArray(const float*  data, std::size_t count);
+    Packet& writeArray(const double* data, std::size_t count);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Read an array of values from the packet
+    ///
+    /// If the packet doesn't contain \a count more elements,
+    /// nothing is read and the packet becomes invalid.
+    ///
+    /// \param data  Pointer to the array to fill
+    /// \param count Number of elements to read
+    ///
+    /// \return Reference to the packet
+    ///
+    /// \see writeArray
+    ///
+    ////////////////////////////////////////////////////////////
+    Packet& readArray(Int8*   data, std::size_t count);
+    Packet& readArray(Uint8*  data, std::size_t count);
+    Packet& readArray(Int16*  data, std::size_t count);
+    Packet& readArray(Uint16* data, std::size_t count);
+    Packet& readArray(Int32*  data, std::size_t count);
+    Packet& readArray(Uint32* data, std::size_t count);
+    Packet& readArray(float*  data, std::size_t count);
+    Packet& readArray(double* data, std::size_t count);
+
 protected:
 
     friend class TcpSocket;
     friend class UdpSocket;
+    friend class ReliableUdpChannel;
 
     ////////////////////////////////////////////////////////////
     /// \brief Called before the packet is sent over the network
@@ -273,12 +340,74 @@ private :
     ////////////////////////////////////////////////////////////
     bool checkSize(std::size_t size);
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Check if the packet can extract a given number of elements
+    ///
+    /// Unlike checkSize(count * size), this function can't be
+    /// fooled by a count (e.g. read from the packet) whose size
+    /// in bytes overflows.
+    /// This function updates accordingly the state of the packet.
+    ///
+    /// \param count Number of elements to check
+    /// \param size  Size of an element, in bytes
+    ///
+    /// \return True if \a count elements can be read from the packet
+    ///
+    ////////////////////////////////////////////////////////////
+    bool checkCount(std::size_t count, std::size_t size);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Grow the packet and return the new area to write to
+    ///
+    /// \param size Number of bytes to append
+    ///
+    /// \return Pointer to the first appended byte
+    ///
+    ////////////////////////////////////////////////////////////
+    char* grow(std::size_t size);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Append an array of 16 or 32 bits values in network byte order
+    ///
+    /// \param data  Pointer to the first element of the array
+    /// \param count Number of elements to write
+    ///
+    ////////////////////////////////////////////////////////////
+    template <typename T>
+    void writeSwapped(const T* data, std::size_t count);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Extract an array of 16 or 32 bits values in network byte order
+    ///
+    /// \param data  Pointer to the array to fill
+    /// \param count Number of elements to read
+    ///
+    ////////////////////////////////////////////////////////////
+    template <typename T>
+    void readSwapped(T* data, std::size_t count);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Fill the packet with a buffer of received data
+    ///
+    /// The buffer is passed to onReceive; if the default
+    /// implementation is used and the packet is empty, the
+    /// packet takes the buffer by swapping it with its own
+    /// storage instead of copying it. Either way, the contents
+    /// of \a buffer are unspecified after the call, but its
+    /// memory can be reused to receive the next packet.
+    ///
+    /// \param buffer Non-empty buffer containing the received bytes
+    ///
+    ////////////////////////////////////////////////////////////
+    void receiveBuffer(std::vector<char>& buffer);
+
     ////////////////////////////////////////////////////////////
     // Member data
     ////////////////////////////////////////////////////////////
-    std::vector<char> m_data;    ///< Data stored in the packet
-    std::size_t       m_readPos; ///< Current reading position in the packet
-    bool              m_isValid; ///< Reading state of the packet
+    std::vector<char>  m_data;          ///< Data stored in the packet
+    std::size_t        m_readPos;       ///< Current reading position in the packet
+    bool               m_isValid;       ///< Reading state of the packet
+    std::vector<char>* m_receiveBuffer; ///< Buffer being handed over by receiveBuffer, if any
 };
 
 } // namespace sf
@@ -0,0 +1,168 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2014 Laurent Gomila (laurent.gom@gmail.com)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+
+#ifndef SFML_PACKETPOOL_HPP
+#define SFML_PACKETPOOL_HPP
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Network/Export.hpp>
+#include <SFML/System/Mutex.hpp>
+#include <SFML/System/NonCopyable.hpp>
+#include <vector>
+
+
+namespace sf
+{
+class Packet;
+
+////////////////////////////////////////////////////////////
+/// \brief Thread-safe pool of recycled packets
+///
+////////////////////////////////////////////////////////////
+class SFML_NETWORK_API PacketPool : NonCopyable
+{
+public :
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Default constructor
+    ///
+    /// \param maxPackets      Maximum number of idle packets kept by the pool
+    /// \param initialCapacity Number of bytes reserved in each new packet
+    ///
+    ////////////////////////////////////////////////////////////
+    PacketPool(std::size_t maxPackets = 1024, std::size_t initialCapacity = 0);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Destructor
+    ///
+    /// Destroys all the idle packets. Packets that are still
+    /// acquired are not owned by the pool anymore, and must
+    /// be destroyed by the caller.
+    ///
+    ////////////////////////////////////////////////////////////
+    ~PacketPool();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get an empty packet
+    ///
+    /// The packet is taken from the idle ones if possible, so that
+    /// the memory that it reserved in a previous use is recycled;
+    /// otherwise a new packet is allocated.
+    /// The packet must be given back with release when it is
+    /// no longer needed.
+    ///
+    /// \return Pointer to an empty packet
+    ///
+    /// \see release
+    ///
+    ////////////////////////////////////////////////////////////
+    Packet* acquire();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Give a packet back to the pool
+    ///
+    /// The packet is cleared, its memory is kept for the next
+    /// call to acquire. If the pool already holds its maximum
+    /// number of idle packets, the packet is destroyed.
+    /// The packet must have been obtained with acquire, and
+    /// must not be used after this call.
+    ///
+    /// \param packet Packet to give back (can be NULL)
+    ///
+    /// \see acquire
+    ///
+    ////////////////////////////////////////////////////////////
+    void release(Packet* packet);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Allocate idle packets in advance
+    ///
+    /// \param count Number of idle packets that the pool should hold
+    ///
+    ////////////////////////////////////////////////////////////
+    void preallocate(std::size_t count);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the number of idle packets in the pool
+    ///
+    /// \return Number of packets ready to be acquired without allocation
+    ///
+    ////////////////////////////////////////////////////////////
+    std::size_t getIdleCount() const;
+
+private :
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Create a new packet with the initial capacity
+    ///
+    /// \return New packet
+    ///
+    ////////////////////////////////////////////////////////////
+    Packet* create() const;
+
+    ////////////////////////////////////////////////////////////
+    // Member data
+    ////////////////////////////////////////////////////////////
+    std::vector<Packet*> m_idle;            ///< Packets ready to be reused
+    std::size_t          m_maxPackets;      ///< Maximum number of idle packets
+    std::size_t          m_initialCapacity; ///< Number of bytes reserved in new packets
+    mutable Mutex        m_mutex;           ///< Mutex protecting the idle packets
+};
+
+} // namespace sf
+
+
+#endif // SFML_PACKETPOOL_HPP
+
+
+////////////////////////////////////////////////////////////
+/// \class sf::PacketPool
+/// \ingroup network
+///
+/// Building many small packets every frame, and destroying
+/// them once they are sent, costs one or more allocations
+/// per packet. sf::PacketPool keeps the packets that are
+/// released, together with the memory that they reserved,
+/// and hands them out again to the next callers.
+///
+/// The pool can be shared between threads: acquire and
+/// release are protected by a mutex, held only for the time
+/// needed to take or put back a pointer.
+///
+/// Usage example:
+/// \code
+/// sf::PacketPool pool(4096, 256);
+///
+/// sf::Packet* packet = pool.acquire();
+/// *packet << type << x << y;
+/// socket.send(*packet, address, port);
+/// pool.release(packet);
+/// \endcode
+///
+/// \see sf::Packet
+///
+////////////////////////////////////////////////////////////
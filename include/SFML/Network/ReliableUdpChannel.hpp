@@ -0,0 +1,505 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2014 Laurent Gomila (laurent.gom@gmail.com)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+
+#ifndef SFML_RELIABLEUDPCHANNEL_HPP
+#define SFML_RELIABLEUDPCHANNEL_HPP
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Network/Export.hpp>
+#include <SFML/Network/IpAddress.hpp>
+#include <SFML/Network/Socket.hpp>
+#include <SFML/System/Clock.hpp>
+#include <SFML/System/NonCopyable.hpp>
+#include <SFML/System/Time.hpp>
+#include <deque>
+#include <map>
+#include <vector>
+
+
+namespace sf
+{
+class Packet;
+class UdpSocket;
+
+////////////////////////////////////////////////////////////
+/// \brief Reliable and ordered delivery of packets over a UDP socket
+///
+////////////////////////////////////////////////////////////
+class SFML_NETWORK_API ReliableUdpChannel : NonCopyable
+{
+public :
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Delivery guarantees of a packet
+    ///
+    ////////////////////////////////////////////////////////////
+    enum Delivery
+    {
+        Unreliable,     ///< Sent once, may be lost or received out of order
+        Reliable,       ///< Resent until acknowledged, received as soon as it arrives
+        ReliableOrdered ///< Resent until acknowledged, received after the previous packets of its stream
+    };
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Simulate the packet loss and the latency of a network
+    ///
+    /// A simulator is applied to the datagrams sent by a channel.
+    /// The default implementation draws the losses and the delays
+    /// from a pseudo-random generator with a fixed seed, so a test
+    /// with the same sequence of calls gives the same losses.
+    /// Override isLost and getDelay to script the conditions
+    /// exactly.
+    ///
+    ////////////////////////////////////////////////////////////
+    class SFML_NETWORK_API Simulator
+    {
+    public :
+
+        ////////////////////////////////////////////////////////////
+        /// \brief Default constructor
+        ///
+        /// The default simulator loses nothing and adds no delay.
+        ///
+        ////////////////////////////////////////////////////////////
+        Simulator();
+
+        ////////////////////////////////////////////////////////////
+        /// \brief Virtual destructor
+        ///
+        ////////////////////////////////////////////////////////////
+        virtual ~Simulator();
+
+        ////////////////////////////////////////////////////////////
+        /// \brief Set the ratio of datagrams that are lost
+        ///
+        /// \param ratio Ratio of lost datagrams, between 0 and 1
+        ///
+        ////////////////////////////////////////////////////////////
+        void setPacketLoss(float ratio);
+
+        ////////////////////////////////////////////////////////////
+        /// \brief Set the delay added to the datagrams
+        ///
+        /// Each datagram is delayed by \a latency plus a random
+        /// part up to \a jitter, so a jitter makes datagrams
+        /// arrive out of order.
+        ///
+        /// \param latency Delay added to every datagram
+        /// \param jitter  Maximum random delay added on top of the latency
+        ///
+        ////////////////////////////////////////////////////////////
+        void setLatency(Time latency, Time jitter = Time::Zero);
+
+        ////////////////////////////////////////////////////////////
+        /// \brief Restart the pseudo-random generator
+        ///
+        /// \param seed New seed of the generator
+        ///
+        ////////////////////////////////////////////////////////////
+        void setSeed(Uint32 seed);
+
+        ////////////////////////////////////////////////////////////
+        /// \brief Decide whether a datagram is lost
+        ///
+        /// \param size Size of the datagram, in bytes
+        ///
+        /// \return True to drop the datagram
+        ///
+        ////////////////////////////////////////////////////////////
+        virtual bool isLost(std::size_t size);
+
+        ////////////////////////////////////////////////////////////
+        /// \brief Get the delay of a datagram that is not lost
+        ///
+        /// \param size Size of the datagram, in bytes
+        ///
+        /// \return Time to wait before the datagram is sent
+        ///
+        ////////////////////////////////////////////////////////////
+        virtual Time getDelay(std::size_t size);
+
+    protected :
+
+        ////////////////////////////////////////////////////////////
+        /// \brief Draw a pseudo-random number
+        ///
+        /// \return Number between 0 and 1
+        ///
+        ////////////////////////////////////////////////////////////
+        float random();
+
+    private :
+
+        ////////////////////////////////////////////////////////////
+        // Member data
+        ////////////////////////////////////////////////////////////
+        Uint32 m_state;   ///< State of the pseudo-random generator
+        float  m_loss;    ///< Ratio of lost datagrams
+        Time   m_latency; ///< Delay added to every datagram
+        Time   m_jitter;  ///< Maximum random delay added on top of the latency
+    };
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Construct the channel
+    ///
+    /// The socket must be bound, and must stay alive as long
+    /// as the channel uses it. It is switched to non-blocking
+    /// mode. Several channels can share the same socket (see update).
+    ///
+    /// \param socket        Socket to send and receive the datagrams with
+    /// \param remoteAddress Address of the remote peer
+    /// \param remotePort    Port of the remote peer
+    ///
+    ////////////////////////////////////////////////////////////
+    ReliableUdpChannel(UdpSocket& socket, const IpAddress& remoteAddress, unsigned short remotePort);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Queue a packet for sending
+    ///
+    /// The packet is sent by the next call to update, along
+    /// with the other queued packets. Packets bigger than the
+    /// maximum datagram size are split into fragments, which
+    /// are reassembled by the remote channel.
+    /// Each stream has its own ordering, so a lost packet only
+    /// delays the ordered packets of its own stream.
+    ///
+    /// \param packet   Packet to send
+    /// \param delivery Delivery guarantees of the packet
+    /// \param stream   Stream of the packet
+    ///
+    /// \return Done if the packet was queued, NotReady if too many
+    ///         reliable packets of the stream are still unacknowledged,
+    ///         Error if the packet is too big
+    ///
+    /// \see receive, update
+    ///
+    ////////////////////////////////////////////////////////////
+    Socket::Status send(Packet& packet, Delivery delivery = ReliableOrdered, Uint8 stream = 0);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the next received packet
+    ///
+    /// \param packet Packet to fill with the received data
+    ///
+    /// \return True if a packet was received, false if there's none
+    ///
+    /// \see send, update
+    ///
+    ////////////////////////////////////////////////////////////
+    bool receive(Packet& packet);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Exchange the datagrams of the channel
+    ///
+    /// This function must be called regularly (typically once
+    /// per frame): it receives the pending datagrams of the
+    /// remote peer, sends the queued packets, the acknowledgements
+    /// and the retransmissions. It never blocks.
+    ///
+    /// If the socket is shared by several channels, receive the
+    /// datagrams yourself, give them to the channel of their
+    /// sender with processDatagram, and pass false to let the
+    /// channel only send.
+    ///
+    /// \param receiveDatagrams True to receive the pending datagrams from the socket
+    ///
+    /// \return Status of the last socket operation
+    ///
+    ////////////////////////////////////////////////////////////
+    Socket::Status update(bool receiveDatagrams = true);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Handle a datagram received from the remote peer
+    ///
+    /// \param data Pointer to the bytes of the datagram
+    /// \param size Number of bytes
+    ///
+    /// \see update
+    ///
+    ////////////////////////////////////////////////////////////
+    void processDatagram(const void* data, std::size_t size);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Set the maximum size of the datagrams sent by the channel
+    ///
+    /// Datagrams that don't fit the path MTU are fragmented by IP,
+    /// and lost entirely when one of their fragments is lost; the
+    /// default of 1200 bytes fits almost every network.
+    ///
+    /// \param size Maximum size of a datagram, in bytes
+    ///
+    ////////////////////////////////////////////////////////////
+    void setMaximumDatagramSize(std::size_t size);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Set a simulator applied to the datagrams sent by the channel
+    ///
+    /// The simulator must stay alive as long as the channel
+    /// uses it.
+    ///
+    /// \param simulator Simulator to use, or NULL to disable the simulation
+    ///
+    ////////////////////////////////////////////////////////////
+    void setSimulator(Simulator* simulator);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the smoothed round-trip time to the remote peer
+    ///
+    /// \return Estimated round-trip time
+    ///
+    ////////////////////////////////////////////////////////////
+    Time getRoundTripTime() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the number of fragments waiting for an acknowledgement
+    ///
+    /// \return Number of unacknowledged reliable fragments
+    ///
+    ////////////////////////////////////////////////////////////
+    std::size_t getUnacknowledgedCount() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the time elapsed since the last datagram of the remote peer
+    ///
+    /// Use it to detect that the remote peer is gone. The channel
+    /// sends nothing while it has nothing to send or acknowledge,
+    /// so an idle peer must send a small packet from time to time
+    /// to be known alive.
+    ///
+    /// \return Time since the last received datagram
+    ///
+    ////////////////////////////////////////////////////////////
+    Time getTimeSinceLastReceive() const;
+
+private :
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Part of a packet, small enough to fit in a datagram
+    ///
+    ////////////////////////////////////////////////////////////
+    struct Fragment
+    {
+        Uint8             delivery; ///< Delivery guarantees of the packet
+        Uint8             stream;   ///< Stream of the packet
+        Uint16            id;       ///< Sequence number of the packet in its stream
+        Uint16            index;    ///< Index of the fragment in the packet
+        Uint16            count;    ///< Number of fragments of the packet
+        std::vector<char> data;     ///< Data of the fragment
+        Time              sentTime; ///< Last time the fragment was sent
+    };
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Packet being reassembled by the receiver
+    ///
+    ////////////////////////////////////////////////////////////
+    struct Assembly
+    {
+        Assembly();
+
+        std::vector<std::vector<char> > fragments; ///< Received fragments
+        std::vector<bool>               present;   ///< Which fragments were received
+        std::size_t                     received;  ///< Number of received fragments
+        bool                            ordered;   ///< Must the packet be received in order?
+        bool                            delivered; ///< Was the packet given to the user?
+    };
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Sequencing state of a stream
+    ///
+    ////////////////////////////////////////////////////////////
+    struct Stream
+    {
+        Stream();
+
+        Uint16                     nextSendId;       ///< Sequence number of the next reliable packet to send
+        Uint16                     nextUnreliableId; ///< Sequence number of the next unreliable packet to send
+        Uint16                     oldestUnacked;    ///< Oldest reliable packet that may still be unacknowledged
+        std::map<Uint16, Uint16>   unacked;          ///< Number of unacknowledged fragments of each reliable packet
+        Uint16                     nextReceiveId;    ///< Next reliable packet expected in order
+        std::map<Uint16, Assembly> incoming;         ///< Reliable packets received ahead of the expected one
+        std::map<Uint16, Assembly> unreliable;       ///< Unreliable packets being reassembled
+    };
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Record of a sent datagram, kept until it is acknowledged
+    ///
+    ////////////////////////////////////////////////////////////
+    struct SentDatagram
+    {
+        Uint16              sequence;  ///< Sequence number of the datagram
+        bool                valid;     ///< Is the record in use?
+        Time                sentTime;  ///< Time the datagram was sent
+        std::vector<Uint64> fragments; ///< Keys of the reliable fragments carried by the datagram
+    };
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Datagram held back by the simulator
+    ///
+    ////////////////////////////////////////////////////////////
+    struct DelayedDatagram
+    {
+        Time              sendTime; ///< Time at which the datagram must be sent
+        std::vector<char> data;     ///< Data of the datagram
+    };
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Send a datagram, through the simulator if any
+    ///
+    /// \param data Datagram to send
+    ///
+    /// \return Status code
+    ///
+    ////////////////////////////////////////////////////////////
+    Socket::Status sendDatagram(const std::vector<char>& data);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Build and send the datagrams carrying the given fragments
+    ///
+    /// \param fragments Fragments to send
+    /// \param now       Current time
+    ///
+    /// \return Status code
+    ///
+    ////////////////////////////////////////////////////////////
+    Socket::Status sendFragments(const std::vector<Fragment*>& fragments, Time now);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Mark a sent datagram as received by the remote peer
+    ///
+    /// \param sequence Sequence number of the datagram
+    /// \param now      Current time
+    ///
+    ////////////////////////////////////////////////////////////
+    void acknowledge(Uint16 sequence, Time now);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Handle a fragment received from the remote peer
+    ///
+    /// \param fragment Received fragment
+    ///
+    ////////////////////////////////////////////////////////////
+    void receiveFragment(Fragment& fragment);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Give a reassembled packet to the user
+    ///
+    /// \param assembly Reassembled packet
+    ///
+    ////////////////////////////////////////////////////////////
+    void deliver(Assembly& assembly);
+
+    ////////////////////////////////////////////////////////////
+    // Member data
+    ////////////////////////////////////////////////////////////
+    UdpSocket&                      m_socket;          ///< Socket sending and receiving the datagrams
+    IpAddress                       m_remoteAddress;   ///< Address of the remote peer
+    unsigned short                  m_remotePort;      ///< Port of the remote peer
+    std::size_t                     m_maxDatagramSize; ///< Maximum size of the datagrams
+    Simulator*                      m_simulator;       ///< Simulator applied to the sent datagrams, if any
+    Clock                           m_clock;           ///< Clock giving the current time of the channel
+    Stream                          m_streams[256];    ///< Sequencing state of the streams
+    std::deque<Fragment>            m_outgoing;        ///< Fragments waiting to be sent for the first time
+    std::map<Uint64, Fragment>      m_unacked;         ///< Reliable fragments waiting for an acknowledgement
+    std::vector<SentDatagram>       m_sentDatagrams;   ///< Records of the recently sent datagrams
+    std::deque<DelayedDatagram>     m_delayed;         ///< Datagrams held back by the simulator
+    std::deque<std::vector<char> >  m_received;        ///< Packets received and not yet read by the user
+    Uint16                          m_localSequence;   ///< Sequence number of the next datagram to send
+    Uint16                          m_remoteSequence;  ///< Most recent sequence number received from the remote peer
+    Uint32                          m_receivedBits;    ///< Reception of the 32 datagrams before the most recent one
+    bool                            m_ackPending;      ///< Must an acknowledgement be sent?
+    bool                            m_hasReceived;     ///< Was any datagram received yet?
+    Time                            m_lastReceive;     ///< Time of the last received datagram
+    Time                            m_smoothedRtt;     ///< Smoothed round-trip time
+    Time                            m_rttVariation;    ///< Variation of the round-trip time
+    std::vector<char>               m_buffer;          ///< Buffer receiving the datagrams
+};
+
+} // namespace sf
+
+
+#endif // SFML_RELIABLEUDPCHANNEL_HPP
+
+
+////////////////////////////////////////////////////////////
+/// \class sf::ReliableUdpChannel
+/// \ingroup network
+///
+/// sf::UdpSocket only sends raw datagrams, which may be lost,
+/// duplicated or received out of order, while sf::TcpSocket
+/// delays every packet behind a lost one. sf::ReliableUdpChannel
+/// sits in between: each packet chooses its own guarantees.
+///
+/// \li Unreliable packets are sent once (positions, inputs)
+/// \li Reliable packets are resent until acknowledged, but are
+///     received as soon as they arrive (events whose order doesn't matter)
+/// \li ReliableOrdered packets are also received after all the
+///     previous packets of their stream (chat, game state changes)
+///
+/// Every datagram carries a sequence number, and acknowledges
+/// the most recent datagram received from the remote peer plus
+/// the 32 before it; a lost acknowledgement is thus repeated
+/// by the next datagrams. The round-trip time is measured from
+/// the acknowledgements, and a reliable packet is resent when
+/// it isn't acknowledged after about one round-trip time plus
+/// four times its variation.
+///
+/// Packets are sent on one of 256 streams, each with its own
+/// ordering: a lost packet of one stream doesn't delay the
+/// others. Packets bigger than the maximum datagram size are
+/// fragmented and reassembled transparently.
+///
+/// The channel doesn't handle connections: it talks to a single
+/// remote peer, which must run a channel too. Both peers must call
+/// update regularly. For tests, a simulator can drop and delay
+/// the datagrams sent by a channel, even over the loopback.
+///
+/// Usage example:
+/// \code
+/// sf::UdpSocket socket;
+/// socket.bind(55002);
+///
+/// sf::ReliableUdpChannel channel(socket, server, 55001);
+///
+/// // Send the position of the player, then a chat message
+/// sf::Packet position;
+/// position << x << y;
+/// channel.send(position, sf::ReliableUdpChannel::Unreliable, 1);
+///
+/// sf::Packet message;
+/// message << "Hello!";
+/// channel.send(message);
+///
+/// // In the main loop
+/// channel.update();
+/// sf::Packet packet;
+/// while (channel.receive(packet))
+///     handle(packet);
+/// \endcode
+///
+/// \see sf::UdpSocket, sf::Packet
+///
+////////////////////////////////////////////////////////////
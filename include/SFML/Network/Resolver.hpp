@@ -0,0 +1,271 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2014 Laurent Gomila (laurent.gom@gmail.com)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+
+#ifndef SFML_RESOLVER_HPP
+#define SFML_RESOLVER_HPP
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Network/Export.hpp>
+#include <SFML/Network/IpAddress.hpp>
+#include <SFML/System/Time.hpp>
+#include <string>
+
+
+namespace sf
+{
+namespace priv
+{
+    class ResolveRequest;
+}
+
+////////////////////////////////////////////////////////////
+/// \brief Resolve host names synchronously or asynchronously,
+///        with a shared cache
+///
+////////////////////////////////////////////////////////////
+class SFML_NETWORK_API Resolver
+{
+public :
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Handle to the result of an asynchronous resolution
+    ///
+    ////////////////////////////////////////////////////////////
+    class SFML_NETWORK_API Result
+    {
+    public :
+
+        ////////////////////////////////////////////////////////////
+        /// \brief Default constructor
+        ///
+        /// Creates an empty result, which is ready and holds
+        /// IpAddress::None.
+        ///
+        ////////////////////////////////////////////////////////////
+        Result();
+
+        ////////////////////////////////////////////////////////////
+        /// \brief Copy constructor
+        ///
+        /// Both results share the same resolution.
+        ///
+        /// \param copy Instance to copy
+        ///
+        ////////////////////////////////////////////////////////////
+        Result(const Result& copy);
+
+        ////////////////////////////////////////////////////////////
+        /// \brief Destructor
+        ///
+        /// Destroying a result doesn't cancel the resolution,
+        /// which still fills the cache when it completes.
+        ///
+        ////////////////////////////////////////////////////////////
+        ~Result();
+
+        ////////////////////////////////////////////////////////////
+        /// \brief Overload of assignment operator
+        ///
+        /// \param right Instance to assign
+        ///
+        /// \return Reference to self
+        ///
+        ////////////////////////////////////////////////////////////
+        Result& operator =(const Result& right);
+
+        ////////////////////////////////////////////////////////////
+        /// \brief Tell whether the resolution is complete
+        ///
+        /// This function never blocks.
+        ///
+        /// \return True if the address is available
+        ///
+        ////////////////////////////////////////////////////////////
+        bool isReady() const;
+
+        ////////////////////////////////////////////////////////////
+        /// \brief Wait until the resolution is complete
+        ///
+        /// \param timeout Maximum time to wait (Time::Zero to wait without limit)
+        ///
+        /// \return True if the address is available
+        ///
+        ////////////////////////////////////////////////////////////
+        bool wait(Time timeout = Time::Zero) const;
+
+        ////////////////////////////////////////////////////////////
+        /// \brief Get the resolved address
+        ///
+        /// This function waits until the resolution is complete.
+        ///
+        /// \return Resolved address, or IpAddress::None if the
+        ///         host could not be resolved
+        ///
+        ////////////////////////////////////////////////////////////
+        IpAddress getAddress() const;
+
+    private :
+
+        friend class Resolver;
+
+        ////////////////////////////////////////////////////////////
+        /// \brief Construct the result from a pending request
+        ///
+        /// \param request Request to share (its reference count
+        ///                must already account for this result)
+        ///
+        ////////////////////////////////////////////////////////////
+        explicit Result(priv::ResolveRequest* request);
+
+        ////////////////////////////////////////////////////////////
+        // Member data
+        ////////////////////////////////////////////////////////////
+        priv::ResolveRequest* m_request; ///< Shared state of the resolution
+    };
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Type of the functions which turn a host name into an address
+    ///
+    ////////////////////////////////////////////////////////////
+    typedef IpAddress (*Function)(const std::string& host);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Resolve an address, blocking until it is available
+    ///
+    /// Addresses in decimal notation ("192.168.1.56") are
+    /// converted directly. Host names are looked up in the
+    /// cache first, and resolved if they are not found.
+    ///
+    /// \param host Address or host name to resolve
+    ///
+    /// \return Resolved address, or IpAddress::None if the
+    ///         host could not be resolved
+    ///
+    ////////////////////////////////////////////////////////////
+    static IpAddress resolve(const std::string& host);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Start resolving an address in the background
+    ///
+    /// The resolution is done by a pool of worker threads.
+    /// Addresses in decimal notation and host names found in
+    /// the cache give an immediately ready result. Concurrent
+    /// requests for the same host share the same resolution.
+    ///
+    /// \param host Address or host name to resolve
+    ///
+    /// \return Handle to the result of the resolution
+    ///
+    ////////////////////////////////////////////////////////////
+    static Result resolveAsync(const std::string& host);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Change how long resolutions are kept in the cache
+    ///
+    /// The system functions don't report the TTL of DNS records,
+    /// so a fixed duration is used. Setting a duration to
+    /// Time::Zero disables the corresponding cache.
+    /// By default, resolved hosts are kept 5 minutes and hosts
+    /// which could not be resolved are kept 10 seconds.
+    ///
+    /// \param positive Duration for hosts that were resolved
+    /// \param negative Duration for hosts that could not be resolved
+    ///
+    ////////////////////////////////////////////////////////////
+    static void setCacheDuration(Time positive, Time negative);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Remove all the hosts from the cache
+    ///
+    ////////////////////////////////////////////////////////////
+    static void clearCache();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Change the maximum number of worker threads
+    ///
+    /// Worker threads are started when asynchronous requests
+    /// are pending, and stop when there is nothing left to
+    /// resolve. The default maximum is 4.
+    ///
+    /// \param count Maximum number of worker threads (at least 1)
+    ///
+    ////////////////////////////////////////////////////////////
+    static void setWorkerCount(unsigned int count);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Replace the function which resolves host names
+    ///
+    /// This allows to use a local stub instead of the system
+    /// resolver, for example in tests. Addresses in decimal
+    /// notation never reach this function.
+    /// Changing the function clears the cache.
+    ///
+    /// \param function Function to use, or NULL to restore the system resolver
+    ///
+    ////////////////////////////////////////////////////////////
+    static void setFunction(Function function);
+};
+
+} // namespace sf
+
+
+#endif // SFML_RESOLVER_HPP
+
+
+////////////////////////////////////////////////////////////
+/// \class sf::Resolver
+/// \ingroup network
+///
+/// Resolving a host name may take a long time, up to several
+/// seconds when the DNS server is slow or unreachable.
+/// sf::Resolver provides a non-blocking alternative:
+/// resolveAsync returns immediately with a handle, which can
+/// be polled with isReady or waited for with wait.
+///
+/// All the resolutions go through a cache shared by the
+/// whole program, including the ones done by the sf::IpAddress
+/// constructors and sf::Http::setHost. Repeated lookups of the
+/// same host are thus answered immediately for the duration
+/// of the cache.
+///
+/// Usage example:
+/// \code
+/// sf::Resolver::Result result = sf::Resolver::resolveAsync("www.sfml-dev.org");
+///
+/// while (!result.isReady())
+/// {
+///     // keep the application running...
+/// }
+///
+/// sf::IpAddress address = result.getAddress();
+/// if (address != sf::IpAddress::None)
+///     socket.connect(address, 80);
+/// \endcode
+///
+/// \see sf::IpAddress
+///
+////////////////////////////////////////////////////////////
@@ -0,0 +1,286 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2014 Laurent Gomila (laurent.gom@gmail.com)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+
+#ifndef SFML_SNAPSHOT_HPP
+#define SFML_SNAPSHOT_HPP
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Network/Export.hpp>
+#include <SFML/Config.hpp>
+#include <vector>
+
+
+namespace sf
+{
+////////////////////////////////////////////////////////////
+/// \brief State of a set of entities at a given time,
+///        made of numeric fields
+///
+////////////////////////////////////////////////////////////
+class SFML_NETWORK_API Snapshot
+{
+public :
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Default constructor
+    ///
+    /// Creates an empty snapshot.
+    ///
+    ////////////////////////////////////////////////////////////
+    Snapshot();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Remove all the entities of the snapshot
+    ///
+    ////////////////////////////////////////////////////////////
+    void clear();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Set the value of a field of an entity
+    ///
+    /// The entity is created if it doesn't exist yet. Fields are
+    /// indexed from 0 to 254; the fields between the last one
+    /// and \a field are created with a value of 0.
+    ///
+    /// \param entity Identifier of the entity
+    /// \param field  Index of the field
+    /// \param value  New value of the field
+    ///
+    /// \see getField
+    ///
+    ////////////////////////////////////////////////////////////
+    void setField(Uint32 entity, unsigned int field, Uint32 value);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Set the value of a signed field of an entity
+    ///
+    /// \param entity Identifier of the entity
+    /// \param field  Index of the field
+    /// \param value  New value of the field
+    ///
+    /// \see getSignedField
+    ///
+    ////////////////////////////////////////////////////////////
+    void setField(Uint32 entity, unsigned int field, Int32 value);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Set the value of a floating point field of an entity
+    ///
+    /// The value is stored bit for bit, so it is transmitted
+    /// without any loss of precision.
+    ///
+    /// \param entity Identifier of the entity
+    /// \param field  Index of the field
+    /// \param value  New value of the field
+    ///
+    /// \see getFloatField
+    ///
+    ////////////////////////////////////////////////////////////
+    void setField(Uint32 entity, unsigned int field, float value);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the value of a field of an entity
+    ///
+    /// \param entity Identifier of the entity
+    /// \param field  Index of the field
+    ///
+    /// \return Value of the field, or 0 if it doesn't exist
+    ///
+    /// \see setField
+    ///
+    ////////////////////////////////////////////////////////////
+    Uint32 getField(Uint32 entity, unsigned int field) const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the value of a signed field of an entity
+    ///
+    /// \param entity Identifier of the entity
+    /// \param field  Index of the field
+    ///
+    /// \return Value of the field, or 0 if it doesn't exist
+    ///
+    /// \see setField
+    ///
+    ////////////////////////////////////////////////////////////
+    Int32 getSignedField(Uint32 entity, unsigned int field) const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the value of a floating point field of an entity
+    ///
+    /// \param entity Identifier of the entity
+    /// \param field  Index of the field
+    ///
+    /// \return Value of the field, or 0 if it doesn't exist
+    ///
+    /// \see setField
+    ///
+    ////////////////////////////////////////////////////////////
+    float getFloatField(Uint32 entity, unsigned int field) const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Remove an entity from the snapshot
+    ///
+    /// \param entity Identifier of the entity to remove
+    ///
+    ////////////////////////////////////////////////////////////
+    void removeEntity(Uint32 entity);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Tell whether the snapshot contains an entity
+    ///
+    /// \param entity Identifier of the entity
+    ///
+    /// \return True if the entity exists in the snapshot
+    ///
+    ////////////////////////////////////////////////////////////
+    bool hasEntity(Uint32 entity) const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the number of entities in the snapshot
+    ///
+    /// \return Number of entities
+    ///
+    /// \see getEntityId
+    ///
+    ////////////////////////////////////////////////////////////
+    std::size_t getEntityCount() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the identifier of an entity of the snapshot
+    ///
+    /// Entities are sorted by increasing identifier.
+    ///
+    /// \param index Index of the entity, in [0, getEntityCount() - 1]
+    ///
+    /// \return Identifier of the entity
+    ///
+    /// \see getEntityCount
+    ///
+    ////////////////////////////////////////////////////////////
+    Uint32 getEntityId(std::size_t index) const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the number of fields of an entity
+    ///
+    /// \param entity Identifier of the entity
+    ///
+    /// \return Number of fields, or 0 if the entity doesn't exist
+    ///
+    ////////////////////////////////////////////////////////////
+    std::size_t getFieldCount(Uint32 entity) const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the sequence number of the snapshot
+    ///
+    /// The sequence number is assigned by sf::SnapshotEncoder
+    /// when the snapshot is sent, and restored by
+    /// sf::SnapshotDecoder when it is received. It is the number
+    /// that the receiver acknowledges to the sender.
+    ///
+    /// \return Sequence number, or 0 if the snapshot was neither sent nor received
+    ///
+    ////////////////////////////////////////////////////////////
+    Uint32 getSequence() const;
+
+private :
+
+    friend class SnapshotEncoder;
+    friend class SnapshotDecoder;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Fields of an entity
+    ///
+    ////////////////////////////////////////////////////////////
+    struct Entity
+    {
+        Uint32              id;     ///< Identifier of the entity
+        std::vector<Uint32> fields; ///< Values of the fields
+    };
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Find an entity
+    ///
+    /// \param entity Identifier of the entity
+    ///
+    /// \return Pointer to the entity, or NULL if it doesn't exist
+    ///
+    ////////////////////////////////////////////////////////////
+    const Entity* findEntity(Uint32 entity) const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Find an entity, creating it if it doesn't exist
+    ///
+    /// \param entity Identifier of the entity
+    ///
+    /// \return Reference to the entity
+    ///
+    ////////////////////////////////////////////////////////////
+    Entity& insertEntity(Uint32 entity);
+
+    ////////////////////////////////////////////////////////////
+    // Member data
+    ////////////////////////////////////////////////////////////
+    std::vector<Entity> m_entities; ///< Entities, sorted by identifier
+    Uint32              m_sequence; ///< Sequence number of the snapshot
+};
+
+} // namespace sf
+
+
+#endif // SFML_SNAPSHOT_HPP
+
+
+////////////////////////////////////////////////////////////
+/// \class sf::Snapshot
+/// \ingroup network
+///
+/// sf::Snapshot holds the state of a set of entities, for
+/// example the players and projectiles of a game at a given
+/// tick. Each entity is identified by a 32-bit number, and
+/// is made of up to 255 numeric fields (integers or floats).
+///
+/// Snapshots are not sent directly: sf::SnapshotEncoder writes
+/// the difference between a snapshot and one that the
+/// receiver already has into a packet, and sf::SnapshotDecoder
+/// rebuilds the snapshot on the other side. Since most fields
+/// don't change from one snapshot to the next, this is much
+/// smaller than the full state.
+///
+/// Usage example:
+/// \code
+/// sf::Snapshot snapshot;
+/// for (std::size_t i = 0; i < players.size(); ++i)
+/// {
+///     snapshot.setField(players[i].id, 0, players[i].x);
+///     snapshot.setField(players[i].id, 1, players[i].y);
+///     snapshot.setField(players[i].id, 2, players[i].health);
+/// }
+/// \endcode
+///
+/// \see sf::SnapshotEncoder, sf::SnapshotDecoder
+///
+////////////////////////////////////////////////////////////
@@ -0,0 +1,130 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2014 Laurent Gomila (laurent.gom@gmail.com)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+
+#ifndef SFML_SNAPSHOTDECODER_HPP
+#define SFML_SNAPSHOTDECODER_HPP
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Network/Export.hpp>
+#include <SFML/Network/Snapshot.hpp>
+#include <vector>
+
+
+namespace sf
+{
+class Packet;
+
+////////////////////////////////////////////////////////////
+/// \brief Rebuilds the snapshots written by sf::SnapshotEncoder
+///
+////////////////////////////////////////////////////////////
+class SFML_NETWORK_API SnapshotDecoder
+{
+public :
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Default constructor
+    ///
+    /// The history must be at least as large as the one of
+    /// the encoder.
+    ///
+    /// \param historySize Number of received snapshots kept as possible baselines
+    ///
+    ////////////////////////////////////////////////////////////
+    SnapshotDecoder(std::size_t historySize = 32);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Read a snapshot from a packet
+    ///
+    /// The snapshot is rebuilt from the baseline that it was
+    /// written against, and kept as a possible baseline for
+    /// the next ones. The data is extracted from the packet.
+    ///
+    /// This function fails if the data is invalid, or if the
+    /// baseline is not in the history anymore.
+    ///
+    /// \param packet   Packet to read
+    /// \param snapshot Snapshot to fill
+    ///
+    /// \return True if the snapshot was read successfully
+    ///
+    ////////////////////////////////////////////////////////////
+    bool decode(Packet& packet, Snapshot& snapshot);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Forget all the received snapshots
+    ///
+    ////////////////////////////////////////////////////////////
+    void reset();
+
+private :
+
+    ////////////////////////////////////////////////////////////
+    // Member data
+    ////////////////////////////////////////////////////////////
+    std::vector<Snapshot> m_history; ///< Ring of the last received snapshots, indexed by sequence number
+};
+
+} // namespace sf
+
+
+#endif // SFML_SNAPSHOTDECODER_HPP
+
+
+////////////////////////////////////////////////////////////
+/// \class sf::SnapshotDecoder
+/// \ingroup network
+///
+/// sf::SnapshotDecoder is the receiving side of
+/// sf::SnapshotEncoder. It keeps a ring of the last received
+/// snapshots, so that the differences written by the encoder
+/// can be applied to the baseline that they refer to.
+///
+/// After a snapshot is decoded, its sequence number must
+/// be sent back to the encoder, so that the next snapshots
+/// are written against it.
+///
+/// Usage example:
+/// \code
+/// sf::Snapshot snapshot;
+/// if (decoder.decode(packet, snapshot))
+/// {
+///     sf::Packet ack;
+///     ack << MessageAck << snapshot.getSequence();
+///     socket.send(ack, server, port);
+///
+///     for (std::size_t i = 0; i < snapshot.getEntityCount(); ++i)
+///     {
+///         sf::Uint32 id = snapshot.getEntityId(i);
+///         updatePlayer(id, snapshot.getFloatField(id, 0), snapshot.getFloatField(id, 1));
+///     }
+/// }
+/// \endcode
+///
+/// \see sf::Snapshot, sf::SnapshotEncoder
+///
+////////////////////////////////////////////////////////////
@@ -0,0 +1,154 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2014 Laurent Gomila (laurent.gom@gmail.com)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+
+#ifndef SFML_SNAPSHOTENCODER_HPP
+#define SFML_SNAPSHOTENCODER_HPP
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Network/Export.hpp>
+#include <SFML/Network/Snapshot.hpp>
+#include <utility>
+#include <vector>
+
+
+namespace sf
+{
+class Packet;
+
+////////////////////////////////////////////////////////////
+/// \brief Writes snapshots into packets as differences with
+///        the last snapshot acknowledged by the receiver
+///
+////////////////////////////////////////////////////////////
+class SFML_NETWORK_API SnapshotEncoder
+{
+public :
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Default constructor
+    ///
+    /// \param historySize Number of sent snapshots kept as possible baselines
+    ///
+    ////////////////////////////////////////////////////////////
+    SnapshotEncoder(std::size_t historySize = 32);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Write a snapshot into a packet
+    ///
+    /// The snapshot is given the next sequence number, and
+    /// written as a difference with the most recent acknowledged
+    /// snapshot: only the fields that changed, the new entities
+    /// and the removed ones. If no snapshot was acknowledged, or
+    /// if the acknowledged one is older than the history, the
+    /// whole snapshot is written.
+    /// The data is appended to the packet.
+    ///
+    /// \param snapshot Snapshot to write
+    /// \param packet   Packet to fill
+    ///
+    /// \return Sequence number of the written snapshot
+    ///
+    /// \see acknowledge
+    ///
+    ////////////////////////////////////////////////////////////
+    Uint32 encode(const Snapshot& snapshot, Packet& packet);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Tell that the receiver got a snapshot
+    ///
+    /// The next snapshots are written as differences with this
+    /// one. Acknowledgements of snapshots older than the current
+    /// baseline, or that were not sent, are ignored.
+    ///
+    /// \param sequence Sequence number of the received snapshot
+    ///
+    ////////////////////////////////////////////////////////////
+    void acknowledge(Uint32 sequence);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Forget all the sent snapshots
+    ///
+    /// The next snapshot is written in full. This is typically
+    /// needed when the receiver changes, or lost its state.
+    ///
+    ////////////////////////////////////////////////////////////
+    void reset();
+
+private :
+
+    ////////////////////////////////////////////////////////////
+    // Member data
+    ////////////////////////////////////////////////////////////
+    std::vector<Snapshot>                                         m_history;      ///< Ring of the last sent snapshots, indexed by sequence number
+    Uint32                                                        m_nextSequence; ///< Sequence number of the next snapshot
+    Uint32                                                        m_baseline;     ///< Sequence number of the last acknowledged snapshot (0 if none)
+    std::vector<std::pair<std::size_t, const Snapshot::Entity*> > m_changed;      ///< Changed entities of the snapshot being written, with their baseline
+    std::vector<Uint32>                                           m_removed;      ///< Removed entities of the snapshot being written
+};
+
+} // namespace sf
+
+
+#endif // SFML_SNAPSHOTENCODER_HPP
+
+
+////////////////////////////////////////////////////////////
+/// \class sf::SnapshotEncoder
+/// \ingroup network
+///
+/// A server usually sends the state of the game to each
+/// client many times per second, while most of this state
+/// doesn't change between two sends. sf::SnapshotEncoder
+/// only writes what changed since the last snapshot that the
+/// client acknowledged; each entity that changed is written
+/// as its identifier, a bitmask of the changed fields and
+/// their new values.
+///
+/// The encoder keeps a ring of the last sent snapshots, so
+/// there must be one encoder per receiver. The receiver
+/// decodes the packets with a sf::SnapshotDecoder, and sends
+/// back the sequence numbers of the snapshots that it
+/// received, through the application protocol; these are
+/// given to acknowledge. As long as no acknowledgement comes
+/// back, the snapshots are written against the last
+/// acknowledged one, so lost packets never break the chain.
+///
+/// Usage example:
+/// \code
+/// // On the server, for each client
+/// sf::Packet packet;
+/// packet << MessageSnapshot;
+/// client.encoder.encode(snapshot, packet);
+/// socket.send(packet, client.address, client.port);
+///
+/// // When the client acknowledges a snapshot
+/// client.encoder.acknowledge(sequence);
+/// \endcode
+///
+/// \see sf::Snapshot, sf::SnapshotDecoder
+///
+////////////////////////////////////////////////////////////
@@ -30,6 +30,7 @@
 ////////////////////////////////////////////////////////////
 #include <SFML/Network/Export.hpp>
 #include <SFML/Network/SocketHandle.hpp>
+#include <SFML/Network/SocketStats.hpp>
 #include <SFML/System/NonCopyable.hpp>
 #include <vector>
 
@@ -104,6 +105,124 @@ public :
     ////////////////////////////////////////////////////////////
     bool isBlocking() const;
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Set the size of the system send buffer of the socket
+    ///
+    /// A bigger buffer allows more data to be in flight, which
+    /// improves the throughput of fast connections with a high
+    /// latency; a smaller one limits the amount of outdated data
+    /// queued in the system. The system may adjust the value.
+    /// If the socket is not created yet, the size is applied
+    /// when it is.
+    ///
+    /// \param size Size of the buffer in bytes, or 0 to keep the system default
+    ///
+    /// \see setReceiveBufferSize
+    ///
+    ////////////////////////////////////////////////////////////
+    void setSendBufferSize(std::size_t size);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Set the size of the system receive buffer of the socket
+    ///
+    /// For TCP sockets, this also limits the window advertised to
+    /// the remote host. The system may adjust the value.
+    /// If the socket is not created yet, the size is applied
+    /// when it is.
+    ///
+    /// \param size Size of the buffer in bytes, or 0 to keep the system default
+    ///
+    /// \see setSendBufferSize
+    ///
+    ////////////////////////////////////////////////////////////
+    void setReceiveBufferSize(std::size_t size);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Enable or disable the traffic statistics of the socket
+    ///
+    /// Enabling the statistics resets them. Once disabled, the
+    /// last statistics can still be read, and they remain part
+    /// of the global statistics.
+    /// The statistics can't be enabled if SFML was built without
+    /// them (SFML_NETWORK_STATS CMake option).
+    ///
+    /// \param enabled True to count the traffic of the socket
+    ///
+    /// \see isStatsEnabled, getStats, setDefaultStatsEnabled
+    ///
+    ////////////////////////////////////////////////////////////
+    void setStatsEnabled(bool enabled);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Tell whether the traffic statistics of the socket are enabled
+    ///
+    /// \return True if statistics are enabled, false otherwise
+    ///
+    /// \see setStatsEnabled
+    ///
+    ////////////////////////////////////////////////////////////
+    bool isStatsEnabled() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the traffic statistics of the socket
+    ///
+    /// The counters are read atomically, so this function can
+    /// be called while another thread uses the socket; they
+    /// are then read one by one, and may not all be from the
+    /// same instant.
+    ///
+    /// \return Copy of the statistics counted since they were enabled or reset
+    ///
+    /// \see setStatsEnabled, resetStats
+    ///
+    ////////////////////////////////////////////////////////////
+    SocketStats getStats() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Reset the traffic statistics of the socket
+    ///
+    /// The global statistics are not affected.
+    ///
+    /// \see getStats
+    ///
+    ////////////////////////////////////////////////////////////
+    void resetStats();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Enable or disable the statistics of the sockets created from now on
+    ///
+    /// This is typically called once at startup, so that all
+    /// the sockets of the application are counted in the
+    /// global statistics, including the ones created by
+    /// libraries.
+    /// The statistics can't be enabled if SFML was built without
+    /// them (SFML_NETWORK_STATS CMake option).
+    ///
+    /// \param enabled True to enable the statistics of new sockets
+    ///
+    /// \see setStatsEnabled, getGlobalStats
+    ///
+    ////////////////////////////////////////////////////////////
+    static void setDefaultStatsEnabled(bool enabled);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the traffic statistics of all the sockets
+    ///
+    /// The counters are the sums of the ones of all the sockets
+    /// whose statistics were enabled, including the destroyed
+    /// ones; the peak values are the largest of all the sockets.
+    /// The counters are updated and read atomically, so this
+    /// function can be called while other threads use their
+    /// sockets; the counters are then read one by one, and may
+    /// not all be from the same instant.
+    ///
+    /// \return Global statistics
+    ///
+    /// \see setDefaultStatsEnabled
+    ///
+    ////////////////////////////////////////////////////////////
+    static SocketStats getGlobalStats();
+
 protected :
 
     ////////////////////////////////////////////////////////////
@@ -165,6 +284,83 @@ protected :
     ////////////////////////////////////////////////////////////
     void close();
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Enable or disable the TCP_NODELAY option
+    ///
+    /// This function can only be accessed by derived classes.
+    ///
+    /// \param noDelay True to disable the Nagle algorithm
+    ///
+    ////////////////////////////////////////////////////////////
+    void setNoDelayOption(bool noDelay);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Enable or disable the TCP_CORK (or TCP_NOPUSH) option
+    ///
+    /// This function can only be accessed by derived classes.
+    ///
+    /// \param cork True to hold partial segments until uncorked
+    ///
+    /// \return False if the option is not supported by the system
+    ///
+    ////////////////////////////////////////////////////////////
+    bool setCorkOption(bool cork);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Count data handed to the system
+    ///
+    /// This function can only be accessed by derived classes.
+    ///
+    /// \param requested Number of bytes that were passed to the system
+    /// \param sent      Number of bytes that the system accepted
+    ///
+    ////////////////////////////////////////////////////////////
+    void recordSend(std::size_t requested, std::size_t sent);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Count data received from the system
+    ///
+    /// This function can only be accessed by derived classes.
+    ///
+    /// \param received Number of bytes received
+    ///
+    ////////////////////////////////////////////////////////////
+    void recordReceive(std::size_t received);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Count sent and received packets or datagrams
+    ///
+    /// This function can only be accessed by derived classes.
+    ///
+    /// \param sent     Number of packets sent
+    /// \param received Number of packets received
+    ///
+    ////////////////////////////////////////////////////////////
+    void recordPackets(std::size_t sent, std::size_t received);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Count the status of a failed system call
+    ///
+    /// This function can only be accessed by derived classes.
+    ///
+    /// \param status Status of the operation
+    ///
+    /// \return \a status, unchanged
+    ///
+    ////////////////////////////////////////////////////////////
+    Status recordStatus(Status status);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Update the peaks of the data held by the socket
+    ///
+    /// This function can only be accessed by derived classes.
+    ///
+    /// \param sendQueue     Number of bytes waiting in the send queue
+    /// \param receiveBuffer Number of bytes held for an incomplete packet
+    ///
+    ////////////////////////////////////////////////////////////
+    void recordBufferSizes(std::size_t sendQueue, std::size_t receiveBuffer);
+
 private :
 
     friend class SocketSelector;
@@ -172,9 +368,15 @@ private :
     ////////////////////////////////////////////////////////////
     // Member data
     ////////////////////////////////////////////////////////////
-    Type         m_type;       ///< Type of the socket (TCP or UDP)
-    SocketHandle m_socket;     ///< Socket descriptor
-    bool         m_isBlocking; ///< Current blocking mode of the socket
+    Type         m_type;              ///< Type of the socket (TCP or UDP)
+    SocketHandle m_socket;            ///< Socket descriptor
+    bool         m_isBlocking;        ///< Current blocking mode of the socket
+    std::size_t  m_sendBufferSize;    ///< Size of the system send buffer (0 for default)
+    std::size_t  m_receiveBufferSize; ///< Size of the system receive buffer (0 for default)
+    bool         m_noDelay;           ///< Is the Nagle algorithm disabled (TCP only)?
+    bool         m_cork;              ///< Are partial segments held (TCP only)?
+    bool         m_statsEnabled;      ///< Are the traffic statistics counted?
+    SocketStats  m_stats;             ///< Traffic statistics of the socket
 };
 
 } // namespace sf
@@ -213,6 +415,8 @@ private :
 /// the socket often enough, and cannot afford blocking
 /// this loop.
 ///
+/// Sockets can also count their traffic, see sf::SocketStats.
+///
 /// \see sf::TcpListener, sf::TcpSocket, sf::UdpSocket
 ///
 ////////////////////////////////////////////////////////////
@@ -30,6 +30,7 @@
 ////////////////////////////////////////////////////////////
 #include <SFML/Network/Export.hpp>
 #include <SFML/System/Time.hpp>
+#include <vector>
 
 
 namespace sf
@@ -44,6 +45,38 @@ class SFML_NETWORK_API SocketSelector
 {
 public :
 
+    ////////////////////////////////////////////////////////////
+    /// \brief How the readiness of a socket is reported
+    ///
+    ////////////////////////////////////////////////////////////
+    enum Trigger
+    {
+        LevelTriggered, ///< Reported on every wait as long as there is data to receive
+        EdgeTriggered   ///< Reported only when new data arrives (epoll backend only)
+    };
+
+    ////////////////////////////////////////////////////////////
+    /// \brief System facility used to wait for the sockets
+    ///
+    ////////////////////////////////////////////////////////////
+    enum Backend
+    {
+        Select, ///< Portable select(), limited to FD_SETSIZE handles
+        Epoll   ///< Linux epoll, scales with the number of active sockets
+    };
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Kinds of readiness a socket can be watched for
+    ///
+    /// Values can be combined with the | operator.
+    ///
+    ////////////////////////////////////////////////////////////
+    enum Interest
+    {
+        Receive = 1 << 0, ///< Ready to receive data (or to accept a connection)
+        Send    = 1 << 1  ///< Ready to send data without blocking
+    };
+
     ////////////////////////////////////////////////////////////
     /// \brief Default constructor
     ///
@@ -79,6 +112,31 @@ public :
     ////////////////////////////////////////////////////////////
     void add(Socket& socket);
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Add a new socket to the selector with a specific trigger mode
+    ///
+    /// With the epoll backend, an edge-triggered socket is reported
+    /// ready only once per arrival of new data: you must then
+    /// receive until the socket would block (use a non-blocking
+    /// socket), otherwise the remaining data won't be reported
+    /// again. The select backend always behaves as level-triggered.
+    /// Adding a socket that is already in the selector updates
+    /// its trigger mode and interest.
+    ///
+    /// A level-triggered socket watched for Send is reported on
+    /// every wait as long as its system buffer is not full, so
+    /// it should only be watched for Send while it has queued
+    /// data (see TcpSocket::getQueuedBytes).
+    ///
+    /// \param socket   Reference to the socket to add
+    /// \param trigger  How readiness is reported for this socket
+    /// \param interest Combination of Interest flags to watch
+    ///
+    /// \see remove, clear
+    ///
+    ////////////////////////////////////////////////////////////
+    void add(Socket& socket, Trigger trigger, unsigned int interest = Receive);
+
     ////////////////////////////////////////////////////////////
     /// \brief Remove a socket from the selector
     ///
@@ -108,8 +166,9 @@ public :
     /// \brief Wait until one or more sockets are ready to receive
     ///
     /// This function returns as soon as at least one socket has
-    /// some data available to be received. To know which sockets are
-    /// ready, use the isReady function.
+    /// some data available to be received, or is ready to send
+    /// if it is watched for Send. To know which sockets are
+    /// ready, use the isReady and isReadyToSend functions.
     /// If you use a timeout and no socket is ready before the timeout
     /// is over, the function returns false.
     ///
@@ -136,11 +195,55 @@ public :
     ///
     /// \return True if the socket is ready to read, false otherwise
     ///
-    /// \see isReady
+    /// \see isReadyToSend
     ///
     ////////////////////////////////////////////////////////////
     bool isReady(Socket& socket) const;
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Test a socket to know if it is ready to send data
+    ///
+    /// This function must be used after a call to wait, and only
+    /// reports sockets that are watched for Send. If a socket is
+    /// ready, some data can be sent without blocking: this is the
+    /// time to call TcpSocket::flush.
+    ///
+    /// \param socket Socket to test
+    ///
+    /// \return True if the socket is ready to send, false otherwise
+    ///
+    /// \see isReady
+    ///
+    ////////////////////////////////////////////////////////////
+    bool isReadyToSend(Socket& socket) const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the list of sockets that are ready to receive or send data
+    ///
+    /// This function must be used after a call to wait. Unlike
+    /// testing every socket with isReady, iterating this list
+    /// costs time proportional to the number of ready sockets,
+    /// not to the number of sockets in the selector.
+    /// The list is valid until the next call to wait, remove or clear.
+    ///
+    /// \return Sockets that were found ready by the last wait
+    ///
+    /// \see wait, isReady
+    ///
+    ////////////////////////////////////////////////////////////
+    const std::vector<Socket*>& getReadySockets() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the system facility used by the selector
+    ///
+    /// Epoll is used on Linux, select everywhere else or if
+    /// epoll could not be initialized.
+    ///
+    /// \return Backend of the selector
+    ///
+    ////////////////////////////////////////////////////////////
+    Backend getBackend() const;
+
     ////////////////////////////////////////////////////////////
     /// \brief Overload of assignment operator
     ///
@@ -258,6 +361,33 @@ private :
 /// }
 /// \endcode
 ///
+/// On Linux, selectors are backed by epoll, which is not limited
+/// to FD_SETSIZE handles and whose wake-up cost only depends on the
+/// number of sockets that are ready. For large numbers of sockets,
+/// prefer iterating getReadySockets() to testing every socket
+/// with isReady:
+/// \code
+/// if (selector.wait())
+/// {
+///     const std::vector<sf::Socket*>& ready = selector.getReadySockets();
+///     for (std::size_t i = 0; i < ready.size(); ++i)
+///         handle(*ready[i]);
+/// }
+/// \endcode
+///
+/// A single thread can also serve many slow clients with
+/// non-blocking sockets: sending to them never blocks, the data
+/// that the system can't take is kept in the queue of each socket.
+/// Watch a socket for Send while it has queued data, and flush it
+/// when it is ready:
+/// \code
+/// if (client.getQueuedBytes() > 0)
+///     selector.add(client, sf::SocketSelector::LevelTriggered, sf::SocketSelector::Receive | sf::SocketSelector::Send);
+/// ...
+/// if (selector.isReadyToSend(client) && (client.flush() == sf::Socket::Done))
+///     selector.add(client); // nothing left to send, stop watching for Send
+/// \endcode
+///
 /// \see sf::Socket
 ///
 ////////////////////////////////////////////////////////////
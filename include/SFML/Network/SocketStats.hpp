@@ -0,0 +1,114 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2014 Laurent Gomila (laurent.gom@gmail.com)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+
+#ifndef SFML_SOCKETSTATS_HPP
+#define SFML_SOCKETSTATS_HPP
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Network/Export.hpp>
+#include <SFML/Config.hpp>
+#include <cstddef>
+
+
+namespace sf
+{
+////////////////////////////////////////////////////////////
+/// \brief Traffic counters of a socket, or of all sockets
+///
+////////////////////////////////////////////////////////////
+struct SFML_NETWORK_API SocketStats
+{
+    ////////////////////////////////////////////////////////////
+    /// \brief Default constructor
+    ///
+    /// Constructs empty statistics, with all counters set to 0.
+    ///
+    ////////////////////////////////////////////////////////////
+    SocketStats();
+
+    ////////////////////////////////////////////////////////////
+    // Member data
+    ////////////////////////////////////////////////////////////
+    Uint64      bytesSent;         ///< Number of bytes handed to the system
+    Uint64      bytesReceived;     ///< Number of bytes received from the system
+    Uint64      packetsSent;       ///< Number of packets (TCP) or datagrams (UDP) sent
+    Uint64      packetsReceived;   ///< Number of packets (TCP) or datagrams (UDP) received
+    Uint64      partialSends;      ///< Number of sends that the system only accepted in part
+    Uint64      notReady;          ///< Number of operations that would have blocked
+    Uint64      errors;            ///< Number of operations that failed with an error
+    Uint64      sendQueuePeak;     ///< Largest amount of data waiting in the send queue, in bytes
+    Uint64      receiveBufferPeak; ///< Largest amount of data held for an incomplete packet, in bytes
+};
+
+} // namespace sf
+
+
+#endif // SFML_SOCKETSTATS_HPP
+
+
+////////////////////////////////////////////////////////////
+/// \class sf::SocketStats
+/// \ingroup network
+///
+/// sf::SocketStats tells how much traffic a socket handled
+/// and how it went: the bytes and packets that went through,
+/// how often the system accepted only part of the data or
+/// would have blocked, and how much data the socket had to
+/// hold on its side.
+///
+/// A connection whose send queue keeps growing, or which
+/// often has sends accepted only in part, is sending faster
+/// than its peer consumes; a receive buffer peak close to the
+/// largest packet of the protocol is expected, a much bigger
+/// one hints at an abnormal peer.
+///
+/// Statistics are disabled by default; they are enabled with
+/// sf::Socket::setStatsEnabled, or for all new sockets with
+/// sf::Socket::setDefaultStatsEnabled. sf::Socket::getGlobalStats
+/// sums the statistics of all the sockets, including the ones
+/// that were destroyed; in this case the peak values are the
+/// largest of all the sockets.
+///
+/// Usage example:
+/// \code
+/// sf::Socket::setDefaultStatsEnabled(true);
+/// ...
+///
+/// for (std::size_t i = 0; i < clients.size(); ++i)
+/// {
+///     sf::SocketStats stats = clients[i]->getStats();
+///     if (stats.sendQueuePeak > 1024 * 1024)
+///         log << "slow consumer: " << clients[i]->getRemoteAddress() << std::endl;
+/// }
+///
+/// sf::SocketStats total = sf::Socket::getGlobalStats();
+/// dashboard.record("network.bytes_out", total.bytesSent);
+/// \endcode
+///
+/// \see sf::Socket
+///
+////////////////////////////////////////////////////////////
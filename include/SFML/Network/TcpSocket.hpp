@@ -31,6 +31,7 @@
 #include <SFML/Network/Export.hpp>
 #include <SFML/Network/Socket.hpp>
 #include <SFML/System/Time.hpp>
+#include <SFML/System/Clock.hpp>
 
 
 namespace sf
@@ -124,7 +125,11 @@ public :
     ////////////////////////////////////////////////////////////
     /// \brief Send raw data to the remote peer
     ///
-    /// This function will fail if the socket is not connected.
+    /// In non-blocking mode, the bytes that can't be written
+    /// immediately are kept in the send queue of the socket and
+    /// written by the next calls to send or flush, so this function
+    /// never returns NotReady. This function will fail if the
+    /// socket is not connected.
     ///
     /// \param data Pointer to the sequence of bytes to send
     /// \param size Number of bytes to send
@@ -157,7 +162,11 @@ public :
     ////////////////////////////////////////////////////////////
     /// \brief Send a formatted packet of data to the remote peer
     ///
-    /// This function will fail if the socket is not connected.
+    /// In non-blocking mode, the part of the packet that can't be
+    /// written immediately is kept in the send queue of the socket
+    /// and written by the next calls to send or flush, so this
+    /// function never returns NotReady. This function will fail if
+    /// the socket is not connected.
     ///
     /// \param packet Packet to send
     ///
@@ -184,6 +193,109 @@ public :
     ////////////////////////////////////////////////////////////
     Status receive(Packet& packet);
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Enable or disable the Nagle algorithm
+    ///
+    /// When enabled (which is the default), small writes are sent
+    /// immediately, which gives the lowest latency. When disabled,
+    /// the system may delay small writes to merge them into fewer
+    /// segments. If the socket is not created yet, the option is
+    /// applied when it is.
+    ///
+    /// \param noDelay True to send small writes immediately
+    ///
+    /// \see setCork
+    ///
+    ////////////////////////////////////////////////////////////
+    void setNoDelay(bool noDelay);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Enable or disable corking of the socket
+    ///
+    /// While the socket is corked, the system only sends full
+    /// segments; uncorking it sends what remains immediately.
+    /// This maps to TCP_CORK on Linux and TCP_NOPUSH on BSD
+    /// and Mac OS X, and has no effect on other systems.
+    /// If the socket is not created yet, the option is applied
+    /// when it is.
+    ///
+    /// \param cork True to cork the socket, false to uncork it
+    ///
+    /// \return True if the option is supported by the system
+    ///
+    /// \see setNoDelay
+    ///
+    ////////////////////////////////////////////////////////////
+    bool setCork(bool cork);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Enable or disable the buffered mode
+    ///
+    /// In buffered mode, the data sent with the send functions
+    /// is appended to an output buffer instead of being written
+    /// to the socket; the whole buffer is then written with a
+    /// single system call when flush is called, when it reaches
+    /// \a flushSize bytes, or when a send occurs more than
+    /// \a flushDelay after the oldest buffered data. This
+    /// greatly reduces the number of system calls and segments
+    /// when many small packets are sent in a row.
+    ///
+    /// The delay is only checked by the send functions, there's
+    /// no background thread: you should call flush once you're
+    /// done with a batch of packets (at the end of a frame, for
+    /// example). Disabling the buffered mode flushes the buffer.
+    ///
+    /// \param buffered   True to enable the buffered mode
+    /// \param flushSize  Size of buffered data that triggers a flush
+    /// \param flushDelay Age of buffered data that triggers a flush (0 to disable)
+    ///
+    /// \see isBuffered, flush
+    ///
+    ////////////////////////////////////////////////////////////
+    void setBuffered(bool buffered, std::size_t flushSize = 16384, Time flushDelay = Time::Zero);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Tell whether the socket is in buffered mode
+    ///
+    /// \return True if the socket is buffered, false otherwise
+    ///
+    /// \see setBuffered
+    ///
+    ////////////////////////////////////////////////////////////
+    bool isBuffered() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the number of bytes waiting in the send queue
+    ///
+    /// The send queue holds the data of the buffered mode, and
+    /// in non-blocking mode the data that could not be written
+    /// yet. A growing value means that the remote peer doesn't
+    /// receive as fast as you send: you should then stop sending
+    /// to this socket for a while, or drop the connection.
+    ///
+    /// \return Number of bytes not sent yet
+    ///
+    /// \see flush
+    ///
+    ////////////////////////////////////////////////////////////
+    std::size_t getQueuedBytes() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Write the data of the send queue to the socket
+    ///
+    /// If the socket is in non-blocking mode and not all the
+    /// data could be written, NotReady is returned and the
+    /// remaining data is kept for the next flush: call it again
+    /// when a SocketSelector reports the socket ready to send.
+    /// This function has no effect if the send queue is empty.
+    ///
+    /// \return Status code
+    ///
+    /// \see setBuffered, getQueuedBytes
+    ///
+    ////////////////////////////////////////////////////////////
+    Status flush();
+
 private:
 
     friend class TcpListener;
@@ -201,10 +313,40 @@ private:
         std::vector<char> Data;         ///< Data of the packet
     };
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Append data to the send queue
+    ///
+    /// \param header     Pointer to the bytes to put before the data (can be NULL)
+    /// \param headerSize Number of header bytes
+    /// \param data       Pointer to the bytes to append
+    /// \param size       Number of bytes to append
+    ///
+    ////////////////////////////////////////////////////////////
+    void appendData(const char* header, std::size_t headerSize, const void* data, std::size_t size);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Append data to the send queue, and flush it if needed
+    ///
+    /// \param header     Pointer to the bytes to put before the data (can be NULL)
+    /// \param headerSize Number of header bytes
+    /// \param data       Pointer to the bytes to append
+    /// \param size       Number of bytes to append
+    ///
+    /// \return Status code
+    ///
+    ////////////////////////////////////////////////////////////
+    Status bufferData(const char* header, std::size_t headerSize, const void* data, std::size_t size);
+
     ////////////////////////////////////////////////////////////
     // Member data
     ////////////////////////////////////////////////////////////
-    PendingPacket m_pendingPacket; ///< Temporary data of the packet currently being received
+    PendingPacket     m_pendingPacket; ///< Temporary data of the packet currently being received
+    bool              m_buffered;      ///< Is the socket in buffered mode?
+    std::size_t       m_flushSize;     ///< Size of buffered data that triggers a flush
+    Time              m_flushDelay;    ///< Age of buffered data that triggers a flush
+    std::vector<char> m_sendBuffer;    ///< Send queue: data waiting to be written to the socket
+    std::size_t       m_sendPosition;  ///< Number of bytes of the send queue already written
+    Clock             m_bufferClock;   ///< Clock measuring the age of the queued data
 };
 
 } // namespace sf
@@ -243,6 +385,10 @@ private:
 /// the data that is exchanged. You can look at the sf::Packet
 /// class to get more details about how they work.
 ///
+/// When many small packets are sent in a row, the buffered
+/// mode (see setBuffered) collects them and writes them with
+/// a single system call when flush is called.
+///
 /// The socket is automatically disconnected when it is destroyed,
 /// but if you want to explicitely close the connection while
 /// the socket instance is still alive, you can call disconnect.
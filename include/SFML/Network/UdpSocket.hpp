@@ -30,12 +30,12 @@
 ////////////////////////////////////////////////////////////
 #include <SFML/Network/Export.hpp>
 #include <SFML/Network/Socket.hpp>
+#include <SFML/Network/IpAddress.hpp>
 #include <vector>
 
 
 namespace sf
 {
-class IpAddress;
 class Packet;
 
 ////////////////////////////////////////////////////////////
@@ -54,6 +54,23 @@ public :
         MaxDatagramSize = 65507 ///< The maximum number of bytes that can be sent in a single UDP datagram
     };
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Datagram of a batched send or receive operation
+    ///
+    ////////////////////////////////////////////////////////////
+    struct SFML_NETWORK_API BatchEntry
+    {
+        ////////////////////////////////////////////////////////////
+        /// \brief Default constructor
+        ///
+        ////////////////////////////////////////////////////////////
+        BatchEntry();
+
+        Packet*        packet;        ///< Packet to send, or to fill with the received data
+        IpAddress      remoteAddress; ///< Address of the receiver, or of the sender
+        unsigned short remotePort;    ///< Port of the receiver, or of the sender
+    };
+
     ////////////////////////////////////////////////////////////
     /// \brief Default constructor
     ///
@@ -180,12 +197,118 @@ public :
     ////////////////////////////////////////////////////////////
     Status receive(Packet& packet, IpAddress& remoteAddress, unsigned short& remotePort);
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Send several packets, possibly to different peers
+    ///
+    /// Each entry describes a packet and its receiver. On Linux,
+    /// the whole batch is handed to the system with as few calls
+    /// as possible (sendmmsg); on other systems, the packets are
+    /// sent one by one.
+    /// The function stops at the first datagram that can't be
+    /// sent, \a sent then tells how many entries were sent.
+    ///
+    /// \param entries Array of datagrams to send
+    /// \param count   Number of entries in the array
+    /// \param sent    This variable is filled with the number of packets sent
+    ///
+    /// \return Status code of the first failed send, or Done if all packets were sent
+    ///
+    /// \see receive
+    ///
+    ////////////////////////////////////////////////////////////
+    Status send(BatchEntry* entries, std::size_t count, std::size_t& sent);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Receive several packets at once
+    ///
+    /// In blocking mode, this function waits until at least one
+    /// datagram is available, then receives all the datagrams
+    /// already queued, up to \a count; it never waits for more.
+    /// On Linux, the datagrams are received with as few calls
+    /// as possible (recvmmsg) into a ring of preallocated buffers
+    /// owned by the socket.
+    /// The packets of the entries must be valid; they are filled
+    /// with the received data, and the addresses and ports of the
+    /// entries with the senders.
+    ///
+    /// \param entries  Array of datagrams to fill
+    /// \param count    Maximum number of datagrams to receive
+    /// \param received This variable is filled with the number of packets received
+    ///
+    /// \return Status code
+    ///
+    /// \see send
+    ///
+    ////////////////////////////////////////////////////////////
+    Status receive(BatchEntry* entries, std::size_t count, std::size_t& received);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Join an IPv4 multicast group
+    ///
+    /// Once the socket is a member of the group, it receives the
+    /// datagrams sent to the group address on its bound port.
+    /// Sending to a group doesn't require being a member.
+    /// The socket should be bound before joining a group.
+    ///
+    /// \param group            Address of the group (224.0.0.0 to 239.255.255.255)
+    /// \param interfaceAddress Address of the local interface to join the group on,
+    ///                         IpAddress::None lets the system choose
+    ///
+    /// \return Status code
+    ///
+    /// \see leaveMulticastGroup
+    ///
+    ////////////////////////////////////////////////////////////
+    Status joinMulticastGroup(const IpAddress& group, const IpAddress& interfaceAddress = IpAddress::None);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Leave an IPv4 multicast group
+    ///
+    /// \param group            Address of the group
+    /// \param interfaceAddress Address of the local interface that joined the group
+    ///
+    /// \return Status code
+    ///
+    /// \see joinMulticastGroup
+    ///
+    ////////////////////////////////////////////////////////////
+    Status leaveMulticastGroup(const IpAddress& group, const IpAddress& interfaceAddress = IpAddress::None);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Set the time-to-live of the multicast datagrams sent by the socket
+    ///
+    /// The TTL is the number of routers that a datagram can
+    /// cross: 1, the system default, keeps the datagrams on
+    /// the local network.
+    ///
+    /// \param ttl Time-to-live of the datagrams, in [0, 255]
+    ///
+    /// \return Status code
+    ///
+    ////////////////////////////////////////////////////////////
+    Status setMulticastTtl(unsigned int ttl);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Enable or disable the loopback of multicast datagrams
+    ///
+    /// When the loopback is enabled (the system default), the
+    /// multicast datagrams sent by the socket are also received
+    /// by the members of the group on the local host.
+    ///
+    /// \param enabled True to enable the loopback, false to disable it
+    ///
+    /// \return Status code
+    ///
+    ////////////////////////////////////////////////////////////
+    Status setMulticastLoopback(bool enabled);
+
 private:
 
     ////////////////////////////////////////////////////////////
     // Member data
     ////////////////////////////////////////////////////////////
-    std::vector<char> m_buffer; ///< Temporary buffer holding the received data in Receive(Packet)
+    std::vector<char> m_buffer;      ///< Temporary buffer holding the received data in Receive(Packet)
+    std::vector<char> m_batchBuffer; ///< Ring of datagram buffers used by batched receives
 };
 
 } // namespace sf
@@ -239,6 +362,12 @@ private:
 /// function if necessary, to stop receiving messages or
 /// make the port available for other sockets.
 ///
+/// To send the same data to many hosts of a local network,
+/// a UDP socket can use multicast: the receivers join a
+/// group with joinMulticastGroup, and a single send to the
+/// group address reaches all of them. The memberships and
+/// multicast options are dropped when the socket is unbound.
+///
 /// Usage example:
 /// \code
 /// // ----- The client -----
@@ -278,6 +407,22 @@ private:
 /// socket.send(message.c_str(), message.size() + 1, sender, port);
 /// \endcode
 ///
+/// When many datagrams are exchanged per frame, for example
+/// a server sending snapshots to all its clients, the batched
+/// versions of send and receive save most of the system calls:
+/// \code
+/// std::vector<sf::UdpSocket::BatchEntry> batch(clients.size());
+/// for (std::size_t i = 0; i < clients.size(); ++i)
+/// {
+///     batch[i].packet        = &clients[i].snapshot;
+///     batch[i].remoteAddress = clients[i].address;
+///     batch[i].remotePort    = clients[i].port;
+/// }
+///
+/// std::size_t sent = 0;
+/// socket.send(&batch[0], batch.size(), sent);
+/// \endcode
+///
 /// \see sf::Socket, sf::TcpSocket, sf::Packet
 ///
 ////////////////////////////////////////////////////////////
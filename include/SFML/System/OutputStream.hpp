@@ -0,0 +1,114 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2014 Laurent Gomila (laurent.gom@gmail.com)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+
+#ifndef SFML_OUTPUTSTREAM_HPP
+#define SFML_OUTPUTSTREAM_HPP
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Config.hpp>
+
+
+namespace sf
+{
+////////////////////////////////////////////////////////////
+/// \brief Abstract class for custom file output streams
+///
+////////////////////////////////////////////////////////////
+class OutputStream
+{
+public :
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Virtual destructor
+    ///
+    ////////////////////////////////////////////////////////////
+    virtual ~OutputStream() {}
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Write data to the stream
+    ///
+    /// After writing, the stream's writing position must be
+    /// advanced by the amount of bytes written.
+    ///
+    /// \param data Buffer containing the data to write
+    /// \param size Number of bytes to write
+    ///
+    /// \return The number of bytes actually written, or -1 on error
+    ///
+    ////////////////////////////////////////////////////////////
+    virtual Int64 write(const void* data, Int64 size) = 0;
+};
+
+} // namespace sf
+
+
+#endif // SFML_OUTPUTSTREAM_HPP
+
+
+////////////////////////////////////////////////////////////
+/// \class sf::OutputStream
+/// \ingroup system
+///
+/// This class allows users to define their own destinations
+/// for the data that SFML produces progressively, such as
+/// files downloaded with sf::Http.
+///
+/// Data is written in order, in chunks of arbitrary size,
+/// so that it never has to be held entirely in memory.
+/// Writing fewer bytes than requested is considered as
+/// an error, and stops the operation that produces the data.
+///
+/// Usage example:
+/// \code
+/// // custom stream class that writes to a file
+/// class FileStream : public sf::OutputStream
+/// {
+/// public :
+///
+///     FileStream(const char* filename) : m_file(std::fopen(filename, "wb")) {}
+///
+///     ~FileStream() {if (m_file) std::fclose(m_file);}
+///
+///     Int64 write(const void* data, Int64 size)
+///     {
+///         if (!m_file)
+///             return -1;
+///
+///         return std::fwrite(data, 1, static_cast<std::size_t>(size), m_file);
+///     }
+///
+/// private :
+///
+///     std::FILE* m_file;
+/// };
+///
+/// // now you can download big files without loading them in memory
+/// FileStream file("patch.zip");
+/// http.sendRequest(sf::Http::Request("/patch.zip"), file);
+/// \endcode
+///
+////////////////////////////////////////////////////////////
@@ -456,6 +456,17 @@ protected :
     ////////////////////////////////////////////////////////////
     virtual void onResize();
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Function called before the window displays a frame
+    ///
+    /// This function is called by display() so that derived
+    /// classes can perform custom actions at the end of each
+    /// frame, even when display() is called through a reference
+    /// to the base class.
+    ///
+    ////////////////////////////////////////////////////////////
+    virtual void onDisplay();
+
 private:
 
     ////////////////////////////////////////////////////////////
@@ -30,6 +30,7 @@
 #include <SFML/Audio/SoundFile.hpp>
 #include <SFML/System/Lock.hpp>
 #include <SFML/System/Err.hpp>
+#include <algorithm>
 #include <fstream>
 
 
@@ -178,6 +179,10 @@ bool Music::onGetData(SoundStream::Chunk& data)
 {
     Lock lock(m_mutex);
 
+    // Resize the internal buffer so that it can contain one chunk of audio samples
+    std::size_t chunkFrames = static_cast<std::size_t>(getChunkDuration().asSeconds() * getSampleRate());
+    m_samples.resize(std::max<std::size_t>(chunkFrames, 1) * getChannelCount());
+
     std::size_t toFill = m_samples.size();
     // If the loop end is enabled and imminent, request less data.
     // This will trip an "onLoop()" call from the underlying SoundStream,
@@ -241,9 +246,6 @@ void Music::initialize()
     m_loopStart = 0;
     m_loopEnd = m_sampleCount / m_file->getChannelCount();
 
-    // Resize the internal buffer so that it can contain 1 second of audio samples
-    m_samples.resize(m_file->getSampleRate() * m_file->getChannelCount());
-
     // Initialize the stream
     SoundStream::initialize(m_file->getChannelCount(), m_file->getSampleRate());
 }
@@ -27,21 +27,32 @@
 ////////////////////////////////////////////////////////////
 #include <SFML/Audio/SoundStream.hpp>
 #include <SFML/Audio/AudioDevice.hpp>
+#include <SFML/Audio/SoundStreamScheduler.hpp>
 #include <SFML/Audio/ALCheck.hpp>
-#include <SFML/System/Sleep.hpp>
 #include <SFML/System/Err.hpp>
+#include <algorithm>
 
-#ifdef _MSC_VER
-    #pragma warning(disable : 4355) // 'this' used in base member initializer list
-#endif
+
+namespace
+{
+    // Time played without underrun after which an adaptive stream gives a buffer back
+    const sf::Time stablePeriod = sf::seconds(10);
+}
 
 
 namespace sf
 {
 ////////////////////////////////////////////////////////////
 SoundStream::SoundStream() :
-m_thread          (&SoundStream::streamData, this),
 m_isStreaming     (false),
+m_requestStop     (false),
+m_allocatedBuffers(0),
+m_targetBuffers   (0),
+m_bufferCount     (3),
+m_chunkDuration   (seconds(1)),
+m_adaptive        (false),
+m_underrunCount   (0),
+m_stableSamples   (0),
 m_channelCount    (0),
 m_sampleRate      (0),
 m_format          (0),
@@ -93,16 +104,19 @@ void SoundStream::play()
     if (m_isStreaming)
     {
         alCheck(alSourcePlay(m_source));
+
+        // Let the streaming thread recompute its deadline, it may have been paused for a while
+        priv::SoundStreamScheduler::notify();
         return;
     }
 
     // Move to the beginning
     onSeek(Time::Zero);
 
-    // Start updating the stream in a separate thread to avoid blocking the application
+    // Let the streaming thread update the stream, to avoid blocking the application
     m_samplesProcessed = 0;
     m_isStreaming = true;
-    m_thread.launch();
+    priv::SoundStreamScheduler::add(*this);
 }
 
 
@@ -116,10 +130,10 @@ void SoundStream::pause()
 ////////////////////////////////////////////////////////////
 void SoundStream::stop()
 {
-    // Wait for the thread to terminate
+    // Wait for the streaming thread to release the stream
+    priv::SoundStreamScheduler::remove(*this);
     m_samplesProcessed = 0;
     m_isStreaming = false;
-    m_thread.wait();
 }
 
 
@@ -162,7 +176,7 @@ void SoundStream::setPlayingOffset(Time timeOffset)
     // Restart streaming
     m_samplesProcessed = static_cast<Uint64>(timeOffset.asSeconds() * m_sampleRate * m_channelCount);
     m_isStreaming = true;
-    m_thread.launch();
+    priv::SoundStreamScheduler::add(*this);
 }
 
 
@@ -197,6 +211,55 @@ bool SoundStream::getLoop() const
 }
 
 
+////////////////////////////////////////////////////////////
+void SoundStream::setBufferCount(unsigned int count)
+{
+    m_bufferCount = std::max(2u, std::min(count, static_cast<unsigned int>(MaxBufferCount)));
+}
+
+
+////////////////////////////////////////////////////////////
+unsigned int SoundStream::getBufferCount() const
+{
+    return m_bufferCount;
+}
+
+
+////////////////////////////////////////////////////////////
+void SoundStream::setChunkDuration(Time duration)
+{
+    m_chunkDuration = std::max(duration, milliseconds(1));
+}
+
+
+////////////////////////////////////////////////////////////
+Time SoundStream::getChunkDuration() const
+{
+    return m_chunkDuration;
+}
+
+
+////////////////////////////////////////////////////////////
+void SoundStream::setAdaptiveBuffering(bool adaptive)
+{
+    m_adaptive = adaptive;
+}
+
+
+////////////////////////////////////////////////////////////
+bool SoundStream::isAdaptiveBuffering() const
+{
+    return m_adaptive;
+}
+
+
+////////////////////////////////////////////////////////////
+unsigned int SoundStream::getUnderrunCount() const
+{
+    return m_underrunCount;
+}
+
+
 ////////////////////////////////////////////////////////////
 SoundStream::BufferEnd SoundStream::onLoop()
 {
@@ -213,104 +276,187 @@ Uint64 SoundStream::getLoopSampleOffset()
 
 
 ////////////////////////////////////////////////////////////
-void SoundStream::streamData()
+void SoundStream::startStreaming()
 {
     // Create the buffers
-    alCheck(alGenBuffers(BufferCount, m_buffers));
-    for (int i = 0; i < BufferCount; ++i)
+    m_allocatedBuffers = m_bufferCount;
+    m_targetBuffers = m_bufferCount;
+    m_stableSamples = 0;
+    alCheck(alGenBuffers(m_allocatedBuffers, m_buffers));
+    for (unsigned int i = 0; i < m_allocatedBuffers; ++i)
+    {
         m_endBuffers[i] = NoEnd;
+        m_bufferSamples[i] = 0;
+    }
 
     // Fill the queue
-    bool requestStop = fillQueue();
+    m_requestStop = fillQueue();
 
     // Play the sound
     alCheck(alSourcePlay(m_source));
+}
 
-    while (m_isStreaming)
+
+////////////////////////////////////////////////////////////
+bool SoundStream::updateStreaming(Time& wait)
+{
+    // The stream has been interrupted!
+    bool interrupted = (SoundSource::getStatus() == Stopped);
+    if (interrupted && m_requestStop)
     {
-        // The stream has been interrupted!
-        if (SoundSource::getStatus() == Stopped)
+        // End streaming
+        m_isStreaming = false;
+    }
+
+    // Follow the buffer count requested by the user; in adaptive mode it is only a minimum
+    if (!m_adaptive || (m_targetBuffers < m_bufferCount))
+        m_targetBuffers = m_bufferCount;
+
+    // Get the number of buffers that have been processed (ie. ready for reuse)
+    ALint nbProcessed = 0;
+    alCheck(alGetSourcei(m_source, AL_BUFFERS_PROCESSED, &nbProcessed));
+
+    while (nbProcessed--)
+    {
+        // Pop the first unused buffer from the queue
+        ALuint buffer;
+        alCheck(alSourceUnqueueBuffers(m_source, 1, &buffer));
+
+        // Find its number
+        unsigned int bufferNum = 0;
+        for (unsigned int i = 0; i < m_allocatedBuffers; ++i)
+            if (m_buffers[i] == buffer)
+            {
+                bufferNum = i;
+                break;
+            }
+        m_bufferSamples[bufferNum] = 0;
+
+        // Retrieve its size and add it to the samples count
+        if (m_endBuffers[bufferNum] == FileEnd)
         {
-            if (!requestStop)
+            // This was the last buffer before end-of-file: reset the sample count
+            m_samplesProcessed = 0;
+            m_endBuffers[bufferNum] = NoEnd;
+        }
+        else if (m_endBuffers[bufferNum] == LoopEnd)
+        {
+            // This was the last buffer before a loop point: reset the sample count
+            m_samplesProcessed = getLoopSampleOffset();
+            m_endBuffers[bufferNum] = NoEnd;
+        }
+        else
+        {
+            ALint size, bits;
+            alCheck(alGetBufferi(buffer, AL_SIZE, &size));
+            alCheck(alGetBufferi(buffer, AL_BITS, &bits));
+
+            // Bits can be 0 if the format or parameters are corrupt, avoid division by zero
+            if (bits == 0)
             {
-                // Just continue
-                alCheck(alSourcePlay(m_source));
+                err() << "Bits in sound stream are 0: make sure that the audio format is not corrupt "
+                      << "and initialize() has been called correctly" << std::endl;
+
+                // Abort streaming
+                m_isStreaming = false;
+                m_requestStop = true;
+                break;
             }
             else
             {
-                // End streaming
-                m_isStreaming = false;
+                m_samplesProcessed += size / (bits / 8);
+                m_stableSamples += size / (bits / 8);
             }
         }
 
-        // Get the number of buffers that have been processed (ie. ready for reuse)
-        ALint nbProcessed = 0;
-        alCheck(alGetSourcei(m_source, AL_BUFFERS_PROCESSED, &nbProcessed));
+        // In adaptive mode, give a buffer back once the stream has played long enough without underrun
+        if (m_adaptive && (m_targetBuffers > m_bufferCount) && (m_stableSamples >= static_cast<Uint64>(stablePeriod.asSeconds() * m_sampleRate * m_channelCount)))
+        {
+            --m_targetBuffers;
+            m_stableSamples = 0;
+        }
 
-        while (nbProcessed--)
+        // Release the buffer if the queue is larger than needed
+        if (m_allocatedBuffers > m_targetBuffers)
         {
-            // Pop the first unused buffer from the queue
-            ALuint buffer;
-            alCheck(alSourceUnqueueBuffers(m_source, 1, &buffer));
-
-            // Find its number
-            unsigned int bufferNum = 0;
-            for (int i = 0; i < BufferCount; ++i)
-                if (m_buffers[i] == buffer)
-                {
-                    bufferNum = i;
-                    break;
-                }
-
-            // Retrieve its size and add it to the samples count
-            if (m_endBuffers[bufferNum] == FileEnd)
-            {
-                // This was the last buffer before end-of-file: reset the sample count
-                m_samplesProcessed = 0;
-                m_endBuffers[bufferNum] = NoEnd;
-            }
-            else if (m_endBuffers[bufferNum] == LoopEnd)
-            {
-                // This was the last buffer before a loop point: reset the sample count
-                m_samplesProcessed = getLoopSampleOffset();
-                m_endBuffers[bufferNum] = NoEnd;
-            }
-            else
-            {
-                ALint size, bits;
-                alCheck(alGetBufferi(buffer, AL_SIZE, &size));
-                alCheck(alGetBufferi(buffer, AL_BITS, &bits));
-
-                // Bits can be 0 if the format or parameters are corrupt, avoid division by zero
-                if (bits == 0)
-                {
-                    err() << "Bits in sound stream are 0: make sure that the audio format is not corrupt "
-                          << "and initialize() has been called correctly" << std::endl;
-
-                    // Abort streaming (exit main loop)
-                    m_isStreaming = false;
-                    requestStop = true;
-                    break;
-                }
-                else
-                {
-                    m_samplesProcessed += size / (bits / 8);
-                }
-            }
+            unsigned int last = --m_allocatedBuffers;
+            alCheck(alDeleteBuffers(1, &buffer));
+            m_buffers[bufferNum]       = m_buffers[last];
+            m_endBuffers[bufferNum]    = m_endBuffers[last];
+            m_bufferSamples[bufferNum] = m_bufferSamples[last];
+            continue;
+        }
 
-            // Fill it and push it back into the playing queue
-            if (!requestStop)
-            {
-                if (fillAndPushBuffer(bufferNum))
-                    requestStop = true;
-            }
+        // Fill it and push it back into the playing queue
+        if (!m_requestStop)
+        {
+            if (fillAndPushBuffer(bufferNum))
+                m_requestStop = true;
         }
+    }
 
-        // Leave some time for the other threads if the stream is still playing
-        if (SoundSource::getStatus() != Stopped)
-            sleep(milliseconds(10));
+    if (!m_isStreaming)
+        return false;
+
+    if (interrupted)
+    {
+        // The queue ran dry while the stream source still had data
+        ++m_underrunCount;
+        m_stableSamples = 0;
+        if (m_adaptive && (m_targetBuffers < MaxBufferCount))
+            ++m_targetBuffers;
     }
 
+    // Allocate the buffers that the queue may be missing
+    growQueue();
+
+    // Restart the playback with the refilled queue
+    if (interrupted)
+    {
+        alCheck(alSourcePlay(m_source));
+    }
+
+    // A paused stream doesn't consume anything: keep the caller's default wait
+    Status status = SoundSource::getStatus();
+    if (status == Stopped)
+    {
+        // The queue ran dry while we were refilling it, come back right away
+        wait = Time::Zero;
+    }
+    else if (status == Playing)
+    {
+        // Compute how long the queued audio will last
+        std::size_t queuedSamples = 0;
+        unsigned int queuedBuffers = 0;
+        for (unsigned int i = 0; i < m_allocatedBuffers; ++i)
+        {
+            queuedSamples += m_bufferSamples[i];
+            if (m_bufferSamples[i] > 0)
+                ++queuedBuffers;
+        }
+
+        ALint offset = 0;
+        alCheck(alGetSourcei(m_source, AL_SAMPLE_OFFSET, &offset));
+
+        float remaining = (static_cast<float>(queuedSamples / m_channelCount) - offset) / m_sampleRate;
+        if (remaining < 0.f)
+            remaining = 0.f;
+
+        // Come back when about one buffer has been played, so that the queue stays
+        // nearly full; once the source has no more data, just wait for it to drain
+        if (m_requestStop || (queuedBuffers == 0))
+            wait = seconds(remaining);
+        else
+            wait = seconds(remaining / queuedBuffers);
+    }
+
+    return true;
+}
+
+
+////////////////////////////////////////////////////////////
+void SoundStream::stopStreaming()
+{
     // Stop the playback
     alCheck(alSourceStop(m_source));
 
@@ -319,7 +465,24 @@ void SoundStream::streamData()
 
     // Delete the buffers
     alCheck(alSourcei(m_source, AL_BUFFER, 0));
-    alCheck(alDeleteBuffers(BufferCount, m_buffers));
+    alCheck(alDeleteBuffers(m_allocatedBuffers, m_buffers));
+    m_allocatedBuffers = 0;
+}
+
+
+////////////////////////////////////////////////////////////
+void SoundStream::growQueue()
+{
+    while ((m_allocatedBuffers < m_targetBuffers) && !m_requestStop)
+    {
+        unsigned int bufferNum = m_allocatedBuffers++;
+        alCheck(alGenBuffers(1, &m_buffers[bufferNum]));
+        m_endBuffers[bufferNum] = NoEnd;
+        m_bufferSamples[bufferNum] = 0;
+
+        if (fillAndPushBuffer(bufferNum))
+            m_requestStop = true;
+    }
 }
 
 
@@ -367,6 +530,7 @@ bool SoundStream::fillAndPushBuffer(unsigned int bufferNum)
 
         // Push it into the sound queue
         alCheck(alSourceQueueBuffers(m_source, 1, &buffer));
+        m_bufferSamples[bufferNum] = data.sampleCount;
     }
 
     return requestStop;
@@ -378,7 +542,7 @@ bool SoundStream::fillQueue()
 {
     // Fill and enqueue all the available buffers
     bool requestStop = false;
-    for (int i = 0; (i < BufferCount) && !requestStop; ++i)
+    for (unsigned int i = 0; (i < m_allocatedBuffers) && !requestStop; ++i)
     {
         if (fillAndPushBuffer(i))
             requestStop = true;
@@ -0,0 +1,333 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2014 Laurent Gomila (laurent.gom@gmail.com)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Audio/SoundStreamScheduler.hpp>
+#include <SFML/Audio/SoundStream.hpp>
+#include <SFML/System/Lock.hpp>
+#include <SFML/System/Mutex.hpp>
+#include <SFML/System/NonCopyable.hpp>
+#include <SFML/System/Sleep.hpp>
+#include <SFML/System/Thread.hpp>
+#include <algorithm>
+#include <vector>
+#if defined(SFML_SYSTEM_WINDOWS)
+    #include <windows.h>
+#else
+    #include <pthread.h>
+    #include <sys/time.h>
+    #include <errno.h>
+#endif
+
+
+namespace
+{
+    // Bounds of the time the streaming thread sleeps between two passes
+    const sf::Time minWait = sf::milliseconds(1);
+    const sf::Time maxWait = sf::seconds(1);
+
+    // Auto-reset signal used to wake the streaming thread up before its deadline
+    class WakeSignal : sf::NonCopyable
+    {
+    public :
+
+#if defined(SFML_SYSTEM_WINDOWS)
+
+        WakeSignal()
+        {
+            m_event = CreateEvent(NULL, FALSE, FALSE, NULL);
+        }
+
+        ~WakeSignal()
+        {
+            CloseHandle(m_event);
+        }
+
+        void notify()
+        {
+            SetEvent(m_event);
+        }
+
+        void wait(sf::Time timeout)
+        {
+            WaitForSingleObject(m_event, static_cast<DWORD>(timeout.asMilliseconds()));
+        }
+
+    private :
+
+        HANDLE m_event;
+
+#else
+
+        WakeSignal() :
+        m_signaled(false)
+        {
+            pthread_mutex_init(&m_mutex, NULL);
+            pthread_cond_init(&m_condition, NULL);
+        }
+
+        ~WakeSignal()
+        {
+            pthread_cond_destroy(&m_condition);
+            pthread_mutex_destroy(&m_mutex);
+        }
+
+        void notify()
+        {
+            pthread_mutex_lock(&m_mutex);
+            m_signaled = true;
+            pthread_cond_signal(&m_condition);
+            pthread_mutex_unlock(&m_mutex);
+        }
+
+        void wait(sf::Time timeout)
+        {
+            // pthread_cond_timedwait expects an absolute deadline
+            timeval now;
+            gettimeofday(&now, NULL);
+            sf::Int64 usecs = now.tv_usec + timeout.asMicroseconds();
+
+            timespec deadline;
+            deadline.tv_sec  = now.tv_sec + static_cast<time_t>(usecs / 1000000);
+            deadline.tv_nsec = static_cast<long>(usecs % 1000000) * 1000;
+
+            pthread_mutex_lock(&m_mutex);
+            while (!m_signaled)
+            {
+                if (pthread_cond_timedwait(&m_condition, &m_mutex, &deadline) == ETIMEDOUT)
+                    break;
+            }
+            m_signaled = false;
+            pthread_mutex_unlock(&m_mutex);
+        }
+
+    private :
+
+        pthread_mutex_t m_mutex;
+        pthread_cond_t  m_condition;
+        bool            m_signaled;
+
+#endif
+    };
+
+    // A stream serviced by the streaming thread
+    struct Entry
+    {
+        sf::SoundStream* stream;
+        bool             started;
+        bool             busy;
+    };
+
+    // State shared by the scheduler functions
+    struct SchedulerState
+    {
+        SchedulerState() :
+        thread (NULL),
+        running(false)
+        {
+        }
+
+        sf::Mutex          mutex;   // Protects the list of streams, not the streams themselves
+        std::vector<Entry> streams; // Streams currently playing
+        sf::Thread*        thread;  // Streaming thread, created on first use
+        bool               running; // Is the streaming thread running?
+        WakeSignal         signal;  // Wakes the streaming thread up
+    };
+
+    // Find the entry of a stream, or return the number of entries if there's none
+    std::size_t findStream(const std::vector<Entry>& streams, const sf::SoundStream* stream)
+    {
+        std::size_t index = 0;
+        while ((index < streams.size()) && (streams[index].stream != stream))
+            ++index;
+
+        return index;
+    }
+
+    // The state is allocated once and never destroyed, so that
+    // streams which outlive static destruction can still stop
+    SchedulerState& getState()
+    {
+        static SchedulerState* state = new SchedulerState;
+        return *state;
+    }
+}
+
+
+namespace sf
+{
+namespace priv
+{
+////////////////////////////////////////////////////////////
+void SoundStreamScheduler::add(SoundStream& stream)
+{
+    SchedulerState& state = getState();
+
+    {
+        Lock lock(state.mutex);
+
+        // The stream may still be finishing its previous playback
+        std::size_t index;
+        if (!waitUntilIdle(stream, index))
+        {
+            Entry entry = {&stream, false, false};
+            state.streams.push_back(entry);
+        }
+
+        // Launch the streaming thread if it had nothing left to do
+        if (!state.running)
+        {
+            if (!state.thread)
+                state.thread = new Thread(&SoundStreamScheduler::run);
+
+            state.running = true;
+            state.thread->launch();
+        }
+    }
+
+    // Make sure that the new stream is started right away
+    state.signal.notify();
+}
+
+
+////////////////////////////////////////////////////////////
+void SoundStreamScheduler::remove(SoundStream& stream)
+{
+    SchedulerState& state = getState();
+    Lock lock(state.mutex);
+
+    std::size_t index;
+    if (!waitUntilIdle(stream, index))
+        return;
+
+    if (state.streams[index].started)
+        stream.stopStreaming();
+
+    state.streams.erase(state.streams.begin() + index);
+}
+
+
+////////////////////////////////////////////////////////////
+void SoundStreamScheduler::notify()
+{
+    getState().signal.notify();
+}
+
+
+////////////////////////////////////////////////////////////
+bool SoundStreamScheduler::waitUntilIdle(SoundStream& stream, std::size_t& index)
+{
+    SchedulerState& state = getState();
+
+    for (;;)
+    {
+        index = findStream(state.streams, &stream);
+        if (index == state.streams.size())
+            return false;
+        if (!state.streams[index].busy)
+            return true;
+
+        // The streaming thread owns the mutex of the stream while it services it
+        state.mutex.unlock();
+        {
+            Lock lock(stream.m_streamMutex);
+        }
+
+        // It marks the stream as idle right after releasing it, give it time to do so
+        sleep(milliseconds(1));
+        state.mutex.lock();
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+void SoundStreamScheduler::run()
+{
+    SchedulerState& state = getState();
+    state.mutex.lock();
+
+    for (;;)
+    {
+        Time wait = maxWait;
+
+        // Service all the streams, and find the one closest to starvation
+        std::size_t i = 0;
+        while (i < state.streams.size())
+        {
+            // Only the serviced stream is locked, so that the other ones
+            // can be played or stopped meanwhile
+            SoundStream* stream = state.streams[i].stream;
+            bool started = state.streams[i].started;
+            state.streams[i].busy = true;
+            stream->m_streamMutex.lock();
+            state.mutex.unlock();
+
+            if (!started)
+                stream->startStreaming();
+
+            Time streamWait = maxWait;
+            bool playing = stream->updateStreaming(streamWait);
+            if (!playing)
+            {
+                // The stream is over
+                stream->stopStreaming();
+            }
+
+            // Other entries may have been added or removed meanwhile, but not this one
+            stream->m_streamMutex.unlock();
+            state.mutex.lock();
+            i = findStream(state.streams, stream);
+            if (playing)
+            {
+                state.streams[i].started = true;
+                state.streams[i].busy = false;
+                wait = std::min(wait, streamWait);
+                ++i;
+            }
+            else
+            {
+                state.streams.erase(state.streams.begin() + i);
+            }
+        }
+
+        // Exit when there is nothing left to stream; the next call to add() relaunches us
+        if (state.streams.empty())
+        {
+            state.running = false;
+            state.mutex.unlock();
+            return;
+        }
+
+        // Sleep until the nearest-to-starving stream needs a refill, or until woken up
+        state.mutex.unlock();
+        state.signal.wait(std::max(wait, minWait));
+        state.mutex.lock();
+    }
+}
+
+} // namespace priv
+
+} // namespace sf
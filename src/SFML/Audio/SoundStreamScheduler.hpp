@@ -0,0 +1,116 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2014 Laurent Gomila (laurent.gom@gmail.com)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+#ifndef SFML_SOUNDSTREAMSCHEDULER_HPP
+#define SFML_SOUNDSTREAMSCHEDULER_HPP
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/System/Time.hpp>
+#include <cstddef>
+
+
+namespace sf
+{
+class SoundStream;
+
+namespace priv
+{
+////////////////////////////////////////////////////////////
+/// \brief Single background thread servicing all the
+///        playing sound streams
+///
+////////////////////////////////////////////////////////////
+class SoundStreamScheduler
+{
+public :
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Start servicing a stream
+    ///
+    /// The stream's queue is filled and playback starts from
+    /// the streaming thread, which is launched if needed.
+    ///
+    /// \param stream Stream to add
+    ///
+    ////////////////////////////////////////////////////////////
+    static void add(SoundStream& stream);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Stop servicing a stream
+    ///
+    /// This function blocks until the streaming thread is done
+    /// with the stream, if it is servicing it; the other streams
+    /// don't delay it. When it returns, the stream's playback is
+    /// stopped and its buffers are released.
+    ///
+    /// \param stream Stream to remove
+    ///
+    ////////////////////////////////////////////////////////////
+    static void remove(SoundStream& stream);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Wake the streaming thread up
+    ///
+    /// This function must be called when the state of a stream
+    /// changes in a way that may shorten its next deadline
+    /// (e.g. resuming a paused stream).
+    ///
+    ////////////////////////////////////////////////////////////
+    static void notify();
+
+private :
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Wait until the streaming thread is not servicing a stream
+    ///
+    /// The scheduler's mutex must be locked by the caller; it is
+    /// released while waiting.
+    ///
+    /// \param stream Stream to wait for
+    /// \param index  Receives the index of the stream's entry
+    ///
+    /// \return True if the stream is registered, false otherwise
+    ///
+    ////////////////////////////////////////////////////////////
+    static bool waitUntilIdle(SoundStream& stream, std::size_t& index);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Function called as the entry point of the thread
+    ///
+    /// This function services every stream in turn, then sleeps
+    /// until the nearest-to-starving one needs a refill. Only the
+    /// serviced stream is locked. It returns when no stream is left.
+    ///
+    ////////////////////////////////////////////////////////////
+    static void run();
+};
+
+} // namespace priv
+
+} // namespace sf
+
+
+#endif // SFML_SOUNDSTREAMSCHEDULER_HPP
@@ -65,6 +65,21 @@
     #define GLEXT_glBlendEquation                  glBlendEquationOES
     #define GLEXT_GL_FUNC_ADD                      GL_FUNC_ADD_OES
     #define GLEXT_GL_FUNC_SUBTRACT                 GL_FUNC_SUBTRACT_OES
+    #define GLEXT_vertex_buffer_object             true
+    #define GLEXT_glGenBuffers                     glGenBuffers
+    #define GLEXT_glBindBuffer                     glBindBuffer
+    #define GLEXT_glBufferData                     glBufferData
+    #define GLEXT_glDeleteBuffers                  glDeleteBuffers
+    #define GLEXT_GL_ARRAY_BUFFER                  GL_ARRAY_BUFFER
+    #define GLEXT_GL_STATIC_DRAW                   GL_STATIC_DRAW
+    #define GLEXT_texture_float                    false
+    #define GLEXT_texture_rg                       false
+    #define GLEXT_draw_buffers                     false
+    #define GLEXT_GL_RGBA16F                       0
+    #define GLEXT_GL_RGBA32F                       0
+    #define GLEXT_GL_R8                            0
+    #define GLEXT_GL_RG16F                         0
+    #define GLEXT_timer_query                      false
 
 #else
 
@@ -102,6 +117,33 @@
     #define GLEXT_glBlendEquation                  glBlendEquation
     #define GLEXT_GL_FUNC_ADD                      GL_FUNC_ADD
     #define GLEXT_GL_FUNC_SUBTRACT                 GL_FUNC_SUBTRACT
+    #define GLEXT_vertex_buffer_object             GLEW_ARB_vertex_buffer_object
+    #define GLEXT_glGenBuffers                     glGenBuffersARB
+    #define GLEXT_glBindBuffer                     glBindBufferARB
+    #define GLEXT_glBufferData                     glBufferDataARB
+    #define GLEXT_glDeleteBuffers                  glDeleteBuffersARB
+    #define GLEXT_GL_ARRAY_BUFFER                  GL_ARRAY_BUFFER_ARB
+    #define GLEXT_GL_STATIC_DRAW                   GL_STATIC_DRAW_ARB
+    #define GLEXT_texture_float                    GLEW_ARB_texture_float
+    #define GLEXT_texture_rg                       GLEW_ARB_texture_rg
+    #define GLEXT_draw_buffers                     GLEW_ARB_draw_buffers
+    #define GLEXT_glDrawBuffers                    glDrawBuffersARB
+    #define GLEXT_GL_MAX_COLOR_ATTACHMENTS         GL_MAX_COLOR_ATTACHMENTS_EXT
+    #define GLEXT_GL_MAX_DRAW_BUFFERS              GL_MAX_DRAW_BUFFERS_ARB
+    #define GLEXT_GL_RGBA16F                       GL_RGBA16F_ARB
+    #define GLEXT_GL_RGBA32F                       GL_RGBA32F_ARB
+    #define GLEXT_GL_R8                            GL_R8
+    #define GLEXT_GL_RG16F                         GL_RG16F
+    #define GLEXT_timer_query                      GLEW_ARB_timer_query
+    #define GLEXT_glGenQueries                     glGenQueriesARB
+    #define GLEXT_glDeleteQueries                  glDeleteQueriesARB
+    #define GLEXT_glBeginQuery                     glBeginQueryARB
+    #define GLEXT_glEndQuery                       glEndQueryARB
+    #define GLEXT_glGetQueryObjectiv               glGetQueryObjectivARB
+    #define GLEXT_glGetQueryObjectui64v            glGetQueryObjectui64v
+    #define GLEXT_GL_TIME_ELAPSED                  GL_TIME_ELAPSED
+    #define GLEXT_GL_QUERY_RESULT                  GL_QUERY_RESULT_ARB
+    #define GLEXT_GL_QUERY_RESULT_AVAILABLE        GL_QUERY_RESULT_AVAILABLE_ARB
 
 #endif
 
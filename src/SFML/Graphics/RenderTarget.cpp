@@ -32,6 +32,7 @@
 #include <SFML/Graphics/VertexArray.hpp>
 #include <SFML/Graphics/GLCheck.hpp>
 #include <SFML/System/Err.hpp>
+#include <cstring>
 #include <iostream>
 
 
@@ -67,6 +68,13 @@ namespace
             case sf::BlendMode::Subtract:        return GLEXT_GL_FUNC_SUBTRACT;
         }
     }
+
+
+    // Check whether two transforms have exactly the same matrix.
+    bool equalMatrices(const sf::Transform& left, const sf::Transform& right)
+    {
+        return std::memcmp(left.getMatrix(), right.getMatrix(), 16 * sizeof(float)) == 0;
+    }
 }
 
 
@@ -76,15 +84,34 @@ namespace sf
 RenderTarget::RenderTarget() :
 m_defaultView(),
 m_view       (),
-m_cache      ()
+m_cache      (),
+m_stats      ()
 {
     m_cache.glStatesSet = false;
+    m_cache.transformSet = false;
+    m_cache.projectionSet = false;
+    m_cache.viewportSet = false;
+    m_cache.lastArrayBuffer = 0;
+    m_cache.lastArrayData = NULL;
+
+    m_stats.enabled = false;
+    m_stats.queryIndex = 0;
+    m_stats.timerStarted = false;
+    m_stats.timerRunning = false;
+    for (int i = 0; i < StatsState::TimerQueryCount; ++i)
+    {
+        m_stats.queries[i] = 0;
+        m_stats.queryFrames[i] = 0;
+        m_stats.queryPending[i] = false;
+    }
 }
 
 
 ////////////////////////////////////////////////////////////
 RenderTarget::~RenderTarget()
 {
+    // Timer queries are not shared between contexts: they are
+    // destroyed along with the context of the derived target
 }
 
 
@@ -93,6 +120,9 @@ void RenderTarget::clear(const Color& color)
 {
     if (activate(true))
     {
+        if (m_stats.enabled && !m_stats.timerStarted)
+            beginGpuTimer();
+
         // Unbind texture to fix RenderTexture preventing clear
         applyTexture(NULL);
 
@@ -213,6 +243,9 @@ void RenderTarget::draw(const Vertex* vertices, unsigned int vertexCount,
         if (!m_cache.glStatesSet)
             resetGLStates();
 
+        if (m_stats.enabled && !m_stats.timerStarted)
+            beginGpuTimer();
+
         // Check if the vertex count is low enough so that we can pre-transform them
         bool useVertexCache = (vertexCount <= StatesCache::VertexCacheSize);
         if (useVertexCache)
@@ -227,49 +260,92 @@ void RenderTarget::draw(const Vertex* vertices, unsigned int vertexCount,
             }
 
             // Since vertices are transformed, we must use an identity transform to render them
-            if (!m_cache.useVertexCache)
-                applyTransform(Transform::Identity);
+            applyTransform(Transform::Identity);
         }
         else
         {
             applyTransform(states.transform);
         }
 
-        // Apply the view
-        if (m_cache.viewChanged)
-            applyCurrentView();
-
-        // Apply the blend mode
-        if (states.blendMode != m_cache.lastBlendMode)
-            applyBlendMode(states.blendMode);
-
-        // Apply the texture
-        Uint64 textureId = states.texture ? states.texture->m_cacheId : 0;
-        if (textureId != m_cache.lastTextureId)
-            applyTexture(states.texture);
-
-        // Apply the shader
-        if (states.shader)
-            applyShader(states.shader);
+        // Apply the view, blend mode, texture and shader
+        applyStates(states);
 
         // If we pre-transform the vertices, we must use our internal vertex cache
         if (useVertexCache)
-        {
-            // ... and if we already used it previously, we don't need to set the pointers again
-            if (!m_cache.useVertexCache)
-                vertices = m_cache.vertexCache;
-            else
-                vertices = NULL;
-        }
+            vertices = m_cache.vertexCache;
 
-        // Setup the pointers to the vertices' components
-        if (vertices)
+        // Setup the pointers to the vertices' components, unless they already point to them
+        if (m_cache.lastArrayBuffer || (vertices != m_cache.lastArrayData))
         {
             const char* data = reinterpret_cast<const char*>(vertices);
             glCheck(glVertexPointer(2, GL_FLOAT, sizeof(Vertex), data + 0));
             glCheck(glColorPointer(4, GL_UNSIGNED_BYTE, sizeof(Vertex), data + 8));
             glCheck(glTexCoordPointer(2, GL_FLOAT, sizeof(Vertex), data + 12));
+
+            m_cache.lastArrayBuffer = 0;
+            m_cache.lastArrayData = vertices;
+        }
+        else
+        {
+            m_stats.current.redundantChanges++;
+        }
+
+        // Find the OpenGL primitive type
+        static const GLenum modes[] = {GL_POINTS, GL_LINES, GL_LINE_STRIP, GL_TRIANGLES,
+                                       GL_TRIANGLE_STRIP, GL_TRIANGLE_FAN, GL_QUADS};
+        GLenum mode = modes[type];
+
+        // Draw the primitives
+        glCheck(glDrawArrays(mode, 0, vertexCount));
+        m_stats.current.drawCalls++;
+        m_stats.current.vertices += vertexCount;
+        m_stats.current.bytesUploaded += vertexCount * sizeof(Vertex);
+
+        // Unbind the shader, if any
+        if (states.shader)
+            applyShader(NULL);
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+void RenderTarget::drawBuffer(unsigned int buffer, unsigned int vertexCount,
+                              PrimitiveType type, const RenderStates& states)
+{
+    // Nothing to draw?
+    if (!buffer || (vertexCount == 0))
+        return;
+
+    // GL_QUADS is unavailable on OpenGL ES
+    #ifdef SFML_OPENGL_ES
+        if (type == Quads)
+        {
+            err() << "sf::Quads primitive type is not supported on OpenGL ES platforms, drawing skipped" << std::endl;
+            return;
         }
+    #endif
+
+    if (activate(true))
+    {
+        // First set the persistent OpenGL states if it's the very first call
+        if (!m_cache.glStatesSet)
+            resetGLStates();
+
+        if (m_stats.enabled && !m_stats.timerStarted)
+            beginGpuTimer();
+
+        // The vertices live in GPU memory, so they can't be pre-transformed
+        applyTransform(states.transform);
+
+        // Apply the view, blend mode, texture and shader
+        applyStates(states);
+
+        // Setup the pointers to the vertices' components, as offsets into the buffer
+        const char* data = NULL;
+        glCheck(GLEXT_glBindBuffer(GLEXT_GL_ARRAY_BUFFER, buffer));
+        glCheck(glVertexPointer(2, GL_FLOAT, sizeof(Vertex), data + 0));
+        glCheck(glColorPointer(4, GL_UNSIGNED_BYTE, sizeof(Vertex), data + 8));
+        glCheck(glTexCoordPointer(2, GL_FLOAT, sizeof(Vertex), data + 12));
 
         // Find the OpenGL primitive type
         static const GLenum modes[] = {GL_POINTS, GL_LINES, GL_LINE_STRIP, GL_TRIANGLES,
@@ -278,13 +354,19 @@ void RenderTarget::draw(const Vertex* vertices, unsigned int vertexCount,
 
         // Draw the primitives
         glCheck(glDrawArrays(mode, 0, vertexCount));
+        m_stats.current.drawCalls++;
+        m_stats.current.vertices += vertexCount;
+
+        // Go back to client-side vertex arrays
+        glCheck(GLEXT_glBindBuffer(GLEXT_GL_ARRAY_BUFFER, 0));
 
         // Unbind the shader, if any
         if (states.shader)
             applyShader(NULL);
 
-        // Update the cache
-        m_cache.useVertexCache = useVertexCache;
+        // The pointers now refer to the buffer, so the next client-side draw must set them again
+        m_cache.lastArrayBuffer = buffer;
+        m_cache.lastArrayData = NULL;
     }
 }
 
@@ -371,6 +453,13 @@ void RenderTarget::resetGLStates()
         glCheck(glEnableClientState(GL_TEXTURE_COORD_ARRAY));
         m_cache.glStatesSet = true;
 
+        // Forget the shadowed states, they may have been changed behind our back
+        m_cache.transformSet = false;
+        m_cache.projectionSet = false;
+        m_cache.viewportSet = false;
+        m_cache.lastArrayBuffer = 0;
+        m_cache.lastArrayData = NULL;
+
         // Apply the default SFML states
         applyBlendMode(BlendAlpha);
         applyTransform(Transform::Identity);
@@ -378,14 +467,67 @@ void RenderTarget::resetGLStates()
         if (shaderAvailable)
             applyShader(NULL);
 
-        m_cache.useVertexCache = false;
-
         // Set the default view
         setView(getView());
     }
 }
 
 
+////////////////////////////////////////////////////////////
+void RenderTarget::setStatsEnabled(bool enabled)
+{
+    if (enabled == m_stats.enabled)
+        return;
+
+    if (!enabled && activate(true))
+    {
+    #ifndef SFML_OPENGL_ES
+
+        // Stop the running timer and release the queries
+        if (m_stats.timerRunning)
+        {
+            glCheck(GLEXT_glEndQuery(GLEXT_GL_TIME_ELAPSED));
+        }
+
+        if (m_stats.queries[0])
+        {
+            GLuint queries[StatsState::TimerQueryCount];
+            for (int i = 0; i < StatsState::TimerQueryCount; ++i)
+                queries[i] = static_cast<GLuint>(m_stats.queries[i]);
+            glCheck(GLEXT_glDeleteQueries(StatsState::TimerQueryCount, queries));
+        }
+
+    #endif
+    }
+
+    for (int i = 0; i < StatsState::TimerQueryCount; ++i)
+    {
+        m_stats.queries[i] = 0;
+        m_stats.queryPending[i] = false;
+    }
+    m_stats.queryIndex = 0;
+    m_stats.timerStarted = false;
+    m_stats.timerRunning = false;
+    m_stats.current = RenderStats();
+    m_stats.last = RenderStats();
+    m_stats.enabled = enabled;
+}
+
+
+////////////////////////////////////////////////////////////
+bool RenderTarget::isStatsEnabled() const
+{
+    return m_stats.enabled;
+}
+
+
+////////////////////////////////////////////////////////////
+const RenderStats& RenderTarget::getStats() const
+{
+    return m_stats.last;
+}
+
+
 ////////////////////////////////////////////////////////////
 void RenderTarget::initialize()
 {
@@ -398,22 +540,110 @@ void RenderTarget::initialize()
 }
 
 
+////////////////////////////////////////////////////////////
+void RenderTarget::finishStatsFrame()
+{
+    if (!m_stats.enabled)
+        return;
+
+    if (activate(true))
+    {
+    #ifndef SFML_OPENGL_ES
+
+        // Close the timer of this frame, its result will be read in a later frame
+        if (m_stats.timerRunning)
+        {
+            glCheck(GLEXT_glEndQuery(GLEXT_GL_TIME_ELAPSED));
+            m_stats.queryFrames[m_stats.queryIndex] = m_stats.current.frame;
+            m_stats.queryPending[m_stats.queryIndex] = true;
+            m_stats.queryIndex = (m_stats.queryIndex + 1) % StatsState::TimerQueryCount;
+            m_stats.timerRunning = false;
+        }
+
+    #endif
+
+        readGpuTimers();
+    }
+
+    // Publish the statistics of this frame and start a new one
+    RenderStats& current = m_stats.current;
+    m_stats.last = current;
+    current.frame++;
+    current.drawCalls = 0;
+    current.vertices = 0;
+    current.bytesUploaded = 0;
+    current.viewChanges = 0;
+    current.blendChanges = 0;
+    current.textureChanges = 0;
+    current.shaderChanges = 0;
+    current.redundantChanges = 0;
+    m_stats.timerStarted = false;
+}
+
+
 ////////////////////////////////////////////////////////////
 void RenderTarget::applyCurrentView()
 {
     // Set the viewport
     IntRect viewport = getViewport(m_view);
-    int top = getSize().y - (viewport.top + viewport.height);
-    glCheck(glViewport(viewport.left, top, viewport.width, viewport.height));
+    viewport.top = getSize().y - (viewport.top + viewport.height);
+    if (!m_cache.viewportSet || (viewport != m_cache.lastViewport))
+    {
+        glCheck(glViewport(viewport.left, viewport.top, viewport.width, viewport.height));
+        m_cache.lastViewport = viewport;
+        m_cache.viewportSet = true;
+    }
+    else
+    {
+        m_stats.current.redundantChanges++;
+    }
 
     // Set the projection matrix
-    glCheck(glMatrixMode(GL_PROJECTION));
-    glCheck(glLoadMatrixf(m_view.getTransform().getMatrix()));
+    const Transform& projection = m_view.getTransform();
+    if (!m_cache.projectionSet || !equalMatrices(projection, m_cache.lastProjection))
+    {
+        glCheck(glMatrixMode(GL_PROJECTION));
+        glCheck(glLoadMatrixf(projection.getMatrix()));
+
+        // Go back to model-view mode
+        glCheck(glMatrixMode(GL_MODELVIEW));
 
-    // Go back to model-view mode
-    glCheck(glMatrixMode(GL_MODELVIEW));
+        m_cache.lastProjection = projection;
+        m_cache.projectionSet = true;
+    }
+    else
+    {
+        m_stats.current.redundantChanges++;
+    }
 
     m_cache.viewChanged = false;
+    m_stats.current.viewChanges++;
+}
+
+
+////////////////////////////////////////////////////////////
+void RenderTarget::applyStates(const RenderStates& states)
+{
+    // Apply the view
+    if (m_cache.viewChanged)
+        applyCurrentView();
+
+    // Apply the blend mode
+    if (states.blendMode != m_cache.lastBlendMode)
+        applyBlendMode(states.blendMode);
+    else
+        m_stats.current.redundantChanges++;
+
+    // Apply the texture
+    Uint64 textureId = states.texture ? states.texture->m_cacheId : 0;
+    if (textureId != m_cache.lastTextureId)
+        applyTexture(states.texture);
+    else
+        m_stats.current.redundantChanges++;
+
+    // Apply the shader
+    if (states.shader)
+        applyShader(states.shader);
 }
 
 
@@ -446,15 +676,25 @@ void RenderTarget::applyBlendMode(const BlendMode& mode)
     }
 
     m_cache.lastBlendMode = mode;
+    m_stats.current.blendChanges++;
 }
 
 
 ////////////////////////////////////////////////////////////
 void RenderTarget::applyTransform(const Transform& transform)
 {
+    if (m_cache.transformSet && equalMatrices(transform, m_cache.lastTransform))
+    {
+        m_stats.current.redundantChanges++;
+        return;
+    }
+
     // No need to call glMatrixMode(GL_MODELVIEW), it is always the
     // current mode (for optimization purpose, since it's the most used)
     glCheck(glLoadMatrixf(transform.getMatrix()));
+
+    m_cache.lastTransform = transform;
+    m_cache.transformSet = true;
 }
 
 
@@ -464,6 +704,7 @@ void RenderTarget::applyTexture(const Texture* texture)
     Texture::bind(texture, Texture::Pixels);
 
     m_cache.lastTextureId = texture ? texture->m_cacheId : 0;
+    m_stats.current.textureChanges++;
 }
 
 
@@ -471,6 +712,74 @@ void RenderTarget::applyTexture(const Texture* texture)
 void RenderTarget::applyShader(const Shader* shader)
 {
     Shader::bind(shader);
+
+    m_stats.current.shaderChanges++;
+}
+
+
+////////////////////////////////////////////////////////////
+void RenderTarget::beginGpuTimer()
+{
+    m_stats.timerStarted = true;
+
+#ifndef SFML_OPENGL_ES
+
+    // Make sure that extensions are initialized
+    priv::ensureExtensionsInit();
+
+    m_stats.current.gpuTimeAvailable = GLEXT_timer_query != 0;
+    if (!m_stats.current.gpuTimeAvailable)
+        return;
+
+    // Create the queries on first use
+    if (!m_stats.queries[0])
+    {
+        GLuint queries[StatsState::TimerQueryCount];
+        glCheck(GLEXT_glGenQueries(StatsState::TimerQueryCount, queries));
+        for (int i = 0; i < StatsState::TimerQueryCount; ++i)
+            m_stats.queries[i] = static_cast<unsigned int>(queries[i]);
+    }
+
+    // If the GPU is so far behind that the query of this slot is still
+    // in flight, skip the measurement of this frame rather than waiting
+    if (m_stats.queryPending[m_stats.queryIndex])
+        readGpuTimers();
+    if (m_stats.queryPending[m_stats.queryIndex])
+        return;
+
+    glCheck(GLEXT_glBeginQuery(GLEXT_GL_TIME_ELAPSED, m_stats.queries[m_stats.queryIndex]));
+    m_stats.timerRunning = true;
+
+#endif
+}
+
+
+////////////////////////////////////////////////////////////
+void RenderTarget::readGpuTimers()
+{
+#ifndef SFML_OPENGL_ES
+
+    // Poll the pending queries from the oldest to the most recent,
+    // without ever blocking on a result that is not available yet
+    for (int i = 0; i < StatsState::TimerQueryCount; ++i)
+    {
+        unsigned int index = (m_stats.queryIndex + i) % StatsState::TimerQueryCount;
+        if (!m_stats.queryPending[index])
+            continue;
+
+        GLint available = 0;
+        glCheck(GLEXT_glGetQueryObjectiv(m_stats.queries[index], GLEXT_GL_QUERY_RESULT_AVAILABLE, &available));
+        if (!available)
+            break;
+
+        GLuint64 elapsed = 0;
+        glCheck(GLEXT_glGetQueryObjectui64v(m_stats.queries[index], GLEXT_GL_QUERY_RESULT, &elapsed));
+        m_stats.current.gpuTime = microseconds(static_cast<Int64>(elapsed / 1000));
+        m_stats.current.gpuFrame = m_stats.queryFrames[index];
+        m_stats.queryPending[index] = false;
+    }
+
+#endif
 }
 
 } // namespace sf
@@ -490,7 +799,14 @@ void RenderTarget::applyShader(const Shader* shader)
 //   lead, in worst case, to changing it every 4 vertices.
 //   To avoid that, when the vertex count is low enough, we
 //   pre-transform them and therefore use an identity transform
-//   to render them.
+//   to render them. The last loaded model-view and projection
+//   matrices and viewport are also kept by value, so that
+//   loading the same ones again is skipped.
+//
+// * Vertex pointers
+//   The array pointers are only set again when the source
+//   of the vertices changes: another client-side array, or
+//   a switch between client memory and a vertex buffer.
 //
 // * Blending mode
 //   Since it overloads the == operator, we can easily check
@@ -511,4 +827,13 @@ void RenderTarget::applyShader(const Shader* shader)
 //   do is that we avoid setting a null shader if there was
 //   already none for the previous draw.
 //
+// * Shadowed states
+//   All the cached states are forgotten by resetGLStates,
+//   since user OpenGL code may have changed them.
+//
+// * Statistics
+//   The counters are plain increments done where the OpenGL
+//   calls are actually issued, so that they reflect the work
+//   that survived the caching strategies above.
+//
 ////////////////////////////////////////////////////////////
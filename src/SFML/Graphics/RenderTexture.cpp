@@ -45,18 +45,56 @@ m_impl(NULL)
 RenderTexture::~RenderTexture()
 {
     delete m_impl;
+    destroyAttachments();
 }
 
 
 ////////////////////////////////////////////////////////////
 bool RenderTexture::create(unsigned int width, unsigned int height, bool depthBuffer)
 {
-    // Create the texture
-    if (!m_texture.create(width, height))
+    return create(width, height, Rgba8, 1, depthBuffer);
+}
+
+
+////////////////////////////////////////////////////////////
+bool RenderTexture::create(unsigned int width, unsigned int height, Format format, unsigned int attachmentCount, bool depthBuffer)
+{
+    // Check the requested format and number of attachments
+    if (!isFormatAvailable(format))
+    {
+        err() << "Impossible to create render texture (the requested pixel format is not supported by your system)" << std::endl;
+        return false;
+    }
+    if ((attachmentCount == 0) || (attachmentCount > getMaximumAttachmentCount()))
+    {
+        err() << "Impossible to create render texture (requested " << attachmentCount << " color attachments, "
+              << "maximum is " << getMaximumAttachmentCount() << ")" << std::endl;
+        return false;
+    }
+
+    // Destroy the previous additional attachments
+    destroyAttachments();
+
+    // Create the textures
+    unsigned int internalFormat = priv::RenderTextureImplFBO::getInternalFormat(format);
+    if (!m_texture.create(width, height, internalFormat))
     {
         err() << "Impossible to create render texture (failed to create the target texture)" << std::endl;
         return false;
     }
+    std::vector<unsigned int> textureIds(1, m_texture.m_texture);
+    for (unsigned int i = 1; i < attachmentCount; ++i)
+    {
+        Texture* attachment = new Texture;
+        m_attachments.push_back(attachment);
+        if (!attachment->create(width, height, internalFormat))
+        {
+            err() << "Impossible to create render texture (failed to create the target texture)" << std::endl;
+            destroyAttachments();
+            return false;
+        }
+        textureIds.push_back(attachment->m_texture);
+    }
 
     // We disable smoothing by default for render textures
     setSmooth(false);
@@ -75,8 +113,11 @@ bool RenderTexture::create(unsigned int width, unsigned int height, bool depthBu
     }
 
     // Initialize the render texture
-    if (!m_impl->create(width, height, m_texture.m_texture, depthBuffer))
+    if (!m_impl->create(width, height, textureIds, depthBuffer))
+    {
+        destroyAttachments();
         return false;
+    }
 
     // We can now initialize the render target part
     RenderTarget::initialize();
@@ -89,6 +130,9 @@ bool RenderTexture::create(unsigned int width, unsigned int height, bool depthBu
 void RenderTexture::setSmooth(bool smooth)
 {
     m_texture.setSmooth(smooth);
+
+    for (std::vector<Texture*>::iterator it = m_attachments.begin(); it != m_attachments.end(); ++it)
+        (*it)->setSmooth(smooth);
 }
 
 
@@ -103,6 +147,9 @@ bool RenderTexture::isSmooth() const
 void RenderTexture::setRepeated(bool repeated)
 {
     m_texture.setRepeated(repeated);
+
+    for (std::vector<Texture*>::iterator it = m_attachments.begin(); it != m_attachments.end(); ++it)
+        (*it)->setRepeated(repeated);
 }
 
 
@@ -123,11 +170,16 @@ bool RenderTexture::setActive(bool active)
 ////////////////////////////////////////////////////////////
 void RenderTexture::display()
 {
+    finishStatsFrame();
+
     // Update the target texture
     if (setActive(true))
     {
         m_impl->updateTexture(m_texture.m_texture);
         m_texture.m_pixelsFlipped = true;
+
+        for (std::vector<Texture*>::iterator it = m_attachments.begin(); it != m_attachments.end(); ++it)
+            (*it)->m_pixelsFlipped = true;
     }
 }
 
@@ -146,10 +198,57 @@ const Texture& RenderTexture::getTexture() const
 }
 
 
+////////////////////////////////////////////////////////////
+const Texture& RenderTexture::getTexture(unsigned int index) const
+{
+    if (index == 0)
+        return m_texture;
+
+    if (index > m_attachments.size())
+    {
+        err() << "Render texture attachment index " << index << " is out of range "
+              << "(attachment count is " << getAttachmentCount() << ")" << std::endl;
+        return m_texture;
+    }
+
+    return *m_attachments[index - 1];
+}
+
+
+////////////////////////////////////////////////////////////
+unsigned int RenderTexture::getAttachmentCount() const
+{
+    return static_cast<unsigned int>(m_attachments.size()) + 1;
+}
+
+
+////////////////////////////////////////////////////////////
+unsigned int RenderTexture::getMaximumAttachmentCount()
+{
+    return priv::RenderTextureImplFBO::isAvailable() ? priv::RenderTextureImplFBO::getMaximumAttachmentCount() : 1;
+}
+
+
+////////////////////////////////////////////////////////////
+bool RenderTexture::isFormatAvailable(Format format)
+{
+    return priv::RenderTextureImplFBO::isFormatAvailable(format);
+}
+
+
 ////////////////////////////////////////////////////////////
 bool RenderTexture::activate(bool active)
 {
     return setActive(active);
 }
 
+
+////////////////////////////////////////////////////////////
+void RenderTexture::destroyAttachments()
+{
+    for (std::vector<Texture*>::iterator it = m_attachments.begin(); it != m_attachments.end(); ++it)
+        delete *it;
+    m_attachments.clear();
+}
+
 } // namespace sf
@@ -29,6 +29,7 @@
 // Headers
 ////////////////////////////////////////////////////////////
 #include <SFML/System/NonCopyable.hpp>
+#include <vector>
 
 
 namespace sf
@@ -52,15 +53,18 @@ public :
     ////////////////////////////////////////////////////////////
     /// \brief Create the render texture implementation
     ///
+    /// The first texture is the main target; additional textures,
+    /// if any, are extra color attachments.
+    ///
     /// \param width       Width of the texture to render to
     /// \param height      Height of the texture to render to
-    /// \param textureId   OpenGL identifier of the target texture
+    /// \param textureIds  OpenGL identifiers of the target textures
     /// \param depthBuffer Is a depth buffer requested?
     ///
     /// \return True if creation has been successful
     ///
     ////////////////////////////////////////////////////////////
-    virtual bool create(unsigned int width, unsigned int height, unsigned int textureId, bool depthBuffer) = 0;
+    virtual bool create(unsigned int width, unsigned int height, const std::vector<unsigned int>& textureIds, bool depthBuffer) = 0;
 
     ////////////////////////////////////////////////////////////
     /// \brief Activate or deactivate the render texture for rendering
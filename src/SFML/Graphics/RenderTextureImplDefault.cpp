@@ -55,8 +55,15 @@ RenderTextureImplDefault::~RenderTextureImplDefault()
 
 
 ////////////////////////////////////////////////////////////
-bool RenderTextureImplDefault::create(unsigned int width, unsigned int height, unsigned int, bool depthBuffer)
+bool RenderTextureImplDefault::create(unsigned int width, unsigned int height, const std::vector<unsigned int>& textureIds, bool depthBuffer)
 {
+    // Without frame buffer objects, only a single color target is supported
+    if (textureIds.size() > 1)
+    {
+        err() << "Impossible to create render texture (multiple render targets are not supported by your system)" << std::endl;
+        return false;
+    }
+
     // Store the dimensions
     m_width = width;
     m_height = height;
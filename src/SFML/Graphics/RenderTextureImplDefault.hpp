@@ -65,13 +65,13 @@ private :
     ///
     /// \param width       Width of the texture to render to
     /// \param height      Height of the texture to render to
-    /// \param textureId   OpenGL identifier of the target texture
+    /// \param textureIds  OpenGL identifiers of the target textures
     /// \param depthBuffer Is a depth buffer requested?
     ///
     /// \return True if creation has been successful
     ///
     ////////////////////////////////////////////////////////////
-    virtual bool create(unsigned int width, unsigned int height, unsigned int textureId, bool depthBuffer);
+    virtual bool create(unsigned int width, unsigned int height, const std::vector<unsigned int>& textureIds, bool depthBuffer);
 
     ////////////////////////////////////////////////////////////
     /// \brief Activate or deactivate the render texture for rendering
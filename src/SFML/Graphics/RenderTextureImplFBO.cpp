@@ -29,6 +29,7 @@
 #include <SFML/Graphics/Texture.hpp>
 #include <SFML/Graphics/GLCheck.hpp>
 #include <SFML/System/Err.hpp>
+#include <algorithm>
 
 
 namespace sf
@@ -81,7 +82,68 @@ bool RenderTextureImplFBO::isAvailable()
 
 
 ////////////////////////////////////////////////////////////
-bool RenderTextureImplFBO::create(unsigned int width, unsigned int height, unsigned int textureId, bool depthBuffer)
+unsigned int RenderTextureImplFBO::getMaximumAttachmentCount()
+{
+    if (!isAvailable())
+        return 0;
+
+#ifndef SFML_OPENGL_ES
+
+    if (!GLEXT_draw_buffers)
+        return 1;
+
+    GLint maxAttachments = 1;
+    GLint maxDrawBuffers = 1;
+    glCheck(glGetIntegerv(GLEXT_GL_MAX_COLOR_ATTACHMENTS, &maxAttachments));
+    glCheck(glGetIntegerv(GLEXT_GL_MAX_DRAW_BUFFERS, &maxDrawBuffers));
+
+    GLint count = std::min(maxAttachments, maxDrawBuffers);
+    return count > 1 ? static_cast<unsigned int>(count) : 1;
+
+#else
+
+    return 1;
+
+#endif
+}
+
+
+////////////////////////////////////////////////////////////
+bool RenderTextureImplFBO::isFormatAvailable(RenderTexture::Format format)
+{
+    if (!isAvailable())
+        return format == RenderTexture::Rgba8;
+
+    switch (format)
+    {
+        case RenderTexture::Rgba8:   return true;
+        case RenderTexture::Rgba16f:
+        case RenderTexture::Rgba32f: return GLEXT_texture_float != 0;
+        case RenderTexture::R8:      return GLEXT_texture_rg != 0;
+        case RenderTexture::Rg16f:   return (GLEXT_texture_rg != 0) && (GLEXT_texture_float != 0);
+    }
+
+    return false;
+}
+
+
+////////////////////////////////////////////////////////////
+unsigned int RenderTextureImplFBO::getInternalFormat(RenderTexture::Format format)
+{
+    switch (format)
+    {
+        default:
+        case RenderTexture::Rgba8:   return GL_RGBA;
+        case RenderTexture::Rgba16f: return GLEXT_GL_RGBA16F;
+        case RenderTexture::Rgba32f: return GLEXT_GL_RGBA32F;
+        case RenderTexture::R8:      return GLEXT_GL_R8;
+        case RenderTexture::Rg16f:   return GLEXT_GL_RG16F;
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+bool RenderTextureImplFBO::create(unsigned int width, unsigned int height, const std::vector<unsigned int>& textureIds, bool depthBuffer)
 {
     // Create the context
     m_context = new Context;
@@ -113,8 +175,24 @@ bool RenderTextureImplFBO::create(unsigned int width, unsigned int height, unsig
         glCheck(GLEXT_glFramebufferRenderbuffer(GLEXT_GL_FRAMEBUFFER, GLEXT_GL_DEPTH_ATTACHMENT, GLEXT_GL_RENDERBUFFER, m_depthBuffer));
     }
 
-    // Link the texture to the frame buffer
-    glCheck(GLEXT_glFramebufferTexture2D(GLEXT_GL_FRAMEBUFFER, GLEXT_GL_COLOR_ATTACHMENT0, GL_TEXTURE_2D, textureId, 0));
+    // Link the textures to the frame buffer
+    for (std::size_t i = 0; i < textureIds.size(); ++i)
+    {
+        glCheck(GLEXT_glFramebufferTexture2D(GLEXT_GL_FRAMEBUFFER, GLEXT_GL_COLOR_ATTACHMENT0 + static_cast<GLenum>(i), GL_TEXTURE_2D, textureIds[i], 0));
+    }
+
+#ifndef SFML_OPENGL_ES
+
+    // Route the fragment shader outputs to all the attachments
+    if (textureIds.size() > 1)
+    {
+        std::vector<GLenum> drawBuffers(textureIds.size());
+        for (std::size_t i = 0; i < drawBuffers.size(); ++i)
+            drawBuffers[i] = GLEXT_GL_COLOR_ATTACHMENT0 + static_cast<GLenum>(i);
+        glCheck(GLEXT_glDrawBuffers(static_cast<GLsizei>(drawBuffers.size()), &drawBuffers[0]));
+    }
+
+#endif
 
     // A final check, just to be sure...
     GLenum status = glCheck(GLEXT_glCheckFramebufferStatus(GLEXT_GL_FRAMEBUFFER));
@@ -29,6 +29,7 @@
 // Headers
 ////////////////////////////////////////////////////////////
 #include <SFML/Graphics/RenderTextureImpl.hpp>
+#include <SFML/Graphics/RenderTexture.hpp>
 #include <SFML/Window/Context.hpp>
 #include <SFML/Window/GlResource.hpp>
 
@@ -66,6 +67,35 @@ public :
     ////////////////////////////////////////////////////////////
     static bool isAvailable();
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the maximum number of color attachments
+    ///        that can be written in a single pass
+    ///
+    /// \return Maximum number of color attachments
+    ///
+    ////////////////////////////////////////////////////////////
+    static unsigned int getMaximumAttachmentCount();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Check whether the system supports a pixel format
+    ///
+    /// \param format Pixel format to check
+    ///
+    /// \return True if textures of this format can be rendered to
+    ///
+    ////////////////////////////////////////////////////////////
+    static bool isFormatAvailable(RenderTexture::Format format);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the OpenGL internal format of a pixel format
+    ///
+    /// \param format Pixel format
+    ///
+    /// \return OpenGL internal format
+    ///
+    ////////////////////////////////////////////////////////////
+    static unsigned int getInternalFormat(RenderTexture::Format format);
+
 private :
 
     ////////////////////////////////////////////////////////////
@@ -73,13 +103,13 @@ private :
     ///
     /// \param width       Width of the texture to render to
     /// \param height      Height of the texture to render to
-    /// \param textureId   OpenGL identifier of the target texture
+    /// \param textureIds  OpenGL identifiers of the target textures
     /// \param depthBuffer Is a depth buffer requested?
     ///
     /// \return True if creation has been successful
     ///
     ////////////////////////////////////////////////////////////
-    virtual bool create(unsigned int width, unsigned int height, unsigned int textureId, bool depthBuffer);
+    virtual bool create(unsigned int width, unsigned int height, const std::vector<unsigned int>& textureIds, bool depthBuffer);
 
     ////////////////////////////////////////////////////////////
     /// \brief Activate or deactivate the render texture for rendering
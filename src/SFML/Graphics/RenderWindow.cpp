@@ -114,4 +114,12 @@ void RenderWindow::onResize()
     setView(getView());
 }
 
+
+////////////////////////////////////////////////////////////
+void RenderWindow::onDisplay()
+{
+    // Close the frame of the statistics before the next one starts
+    finishStatsFrame();
+}
+
 } // namespace sf
@@ -27,10 +27,12 @@
 // Headers
 ////////////////////////////////////////////////////////////
 #include <SFML/Graphics/Shader.hpp>
+#include <SFML/Graphics/ShaderCache.hpp>
 #include <SFML/Graphics/Texture.hpp>
 #include <SFML/Graphics/GLCheck.hpp>
 #include <SFML/Window/Context.hpp>
 #include <SFML/System/InputStream.hpp>
+#include <SFML/System/Clock.hpp>
 #include <SFML/System/Err.hpp>
 #include <fstream>
 #include <vector>
@@ -95,12 +97,24 @@ namespace sf
 Shader::CurrentTextureType Shader::CurrentTexture;
 
 
+////////////////////////////////////////////////////////////
+Shader::Statistics::Statistics() :
+compiled   (0),
+shared     (0),
+loaded     (0),
+rejected   (0),
+compileTime()
+{
+}
+
+
 ////////////////////////////////////////////////////////////
 Shader::Shader() :
 m_shaderProgram (0),
 m_currentTexture(-1),
 m_textures      (),
-m_params        ()
+m_params        (),
+m_compileTime   ()
 {
 }
 
@@ -110,9 +124,9 @@ Shader::~Shader()
 {
     ensureGlContext();
 
-    // Destroy effect program
+    // Release the effect program (it may still be used by other shaders)
     if (m_shaderProgram)
-        glCheck(glDeleteObjectARB(m_shaderProgram));
+        priv::ShaderCache::getInstance().release(m_shaderProgram);
 }
 
 
@@ -464,6 +478,34 @@ bool Shader::isAvailable()
 }
 
 
+////////////////////////////////////////////////////////////
+Time Shader::getCompileTime() const
+{
+    return m_compileTime;
+}
+
+
+////////////////////////////////////////////////////////////
+void Shader::setCacheEnabled(bool enabled)
+{
+    priv::ShaderCache::getInstance().setEnabled(enabled);
+}
+
+
+////////////////////////////////////////////////////////////
+void Shader::setCacheDirectory(const std::string& directory)
+{
+    priv::ShaderCache::getInstance().setDirectory(directory);
+}
+
+
+////////////////////////////////////////////////////////////
+Shader::Statistics Shader::getStatistics()
+{
+    return priv::ShaderCache::getInstance().getStatistics();
+}
+
+
 ////////////////////////////////////////////////////////////
 bool Shader::compile(const char* vertexShaderCode, const char* fragmentShaderCode)
 {
@@ -477,14 +519,28 @@ bool Shader::compile(const char* vertexShaderCode, const char* fragmentShaderCod
         return false;
     }
 
+    priv::ShaderCache& cache = priv::ShaderCache::getInstance();
+
     // Destroy the shader if it was already created
     if (m_shaderProgram)
-        glCheck(glDeleteObjectARB(m_shaderProgram));
+        cache.release(m_shaderProgram);
 
     // Reset the internal state
     m_currentTexture = -1;
     m_textures.clear();
     m_params.clear();
+    m_compileTime = Time::Zero;
+
+    Clock clock;
+
+    // Reuse an identical program if one was already built
+    m_shaderProgram = cache.acquire(vertexShaderCode, fragmentShaderCode);
+    if (m_shaderProgram)
+    {
+        m_compileTime = clock.getElapsedTime();
+        cache.addCompileTime(m_compileTime);
+        return true;
+    }
 
     // Create the program
     m_shaderProgram = glCheck(glCreateProgramObjectARB());
@@ -546,6 +602,7 @@ bool Shader::compile(const char* vertexShaderCode, const char* fragmentShaderCod
     }
 
     // Link the program
+    cache.prepare(m_shaderProgram);
     glCheck(glLinkProgramARB(m_shaderProgram));
 
     // Check the link log
@@ -562,10 +619,16 @@ bool Shader::compile(const char* vertexShaderCode, const char* fragmentShaderCod
         return false;
     }
 
+    // Make the program available to the next shaders loaded from the same sources
+    cache.store(vertexShaderCode, fragmentShaderCode, m_shaderProgram);
+
     // Force an OpenGL flush, so that the shader will appear updated
     // in all contexts immediately (solves problems in multi-threaded apps)
     glCheck(glFlush());
 
+    m_compileTime = clock.getElapsedTime();
+    cache.addCompileTime(m_compileTime);
+
     return true;
 }
 
@@ -629,10 +692,22 @@ namespace sf
 Shader::CurrentTextureType Shader::CurrentTexture;
 
 
+////////////////////////////////////////////////////////////
+Shader::Statistics::Statistics() :
+compiled   (0),
+shared     (0),
+loaded     (0),
+rejected   (0),
+compileTime()
+{
+}
+
+
 ////////////////////////////////////////////////////////////
 Shader::Shader() :
 m_shaderProgram (0),
-m_currentTexture(-1)
+m_currentTexture(-1),
+m_compileTime   ()
 {
 }
 
@@ -758,6 +833,32 @@ bool Shader::isAvailable()
 }
 
 
+////////////////////////////////////////////////////////////
+Time Shader::getCompileTime() const
+{
+    return Time::Zero;
+}
+
+
+////////////////////////////////////////////////////////////
+void Shader::setCacheEnabled(bool enabled)
+{
+}
+
+
+////////////////////////////////////////////////////////////
+void Shader::setCacheDirectory(const std::string& directory)
+{
+}
+
+
+////////////////////////////////////////////////////////////
+Shader::Statistics Shader::getStatistics()
+{
+    return Statistics();
+}
+
+
 ////////////////////////////////////////////////////////////
 bool Shader::compile(const char* vertexShaderCode, const char* fragmentShaderCode)
 {
@@ -0,0 +1,367 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2014 Laurent Gomila (laurent.gom@gmail.com)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Graphics/ShaderCache.hpp>
+#include <SFML/Graphics/GLCheck.hpp>
+#include <SFML/System/Lock.hpp>
+#include <SFML/System/Err.hpp>
+#include <fstream>
+#include <vector>
+
+
+#ifndef SFML_OPENGL_ES
+
+namespace
+{
+    // Header written at the beginning of each program binary file
+    struct BinaryHeader
+    {
+        sf::Uint32 magic;      // Identifies the file format
+        sf::Uint64 driverHash; // Driver that produced the binary
+        sf::Uint64 key;        // Hash of the program sources
+        sf::Uint32 format;     // Driver-specific binary format
+        sf::Uint32 length;     // Size of the binary, in bytes
+    };
+
+    const sf::Uint32 binaryMagic = 0x53465042; // "SFPB"
+
+    // Compute the 64-bit FNV-1a hash of a string
+    sf::Uint64 hash(const std::string& data, sf::Uint64 seed = 14695981039346656037ULL)
+    {
+        sf::Uint64 result = seed;
+        for (std::string::const_iterator it = data.begin(); it != data.end(); ++it)
+        {
+            result ^= static_cast<unsigned char>(*it);
+            result *= 1099511628211ULL;
+        }
+
+        return result;
+    }
+
+    // Concatenate the sources of a program into a single string
+    std::string getSources(const char* vertexShaderCode, const char* fragmentShaderCode)
+    {
+        // A missing shader must not be confused with an empty one
+        std::string sources;
+        sources += vertexShaderCode ? 'v' : '-';
+        if (vertexShaderCode)
+            sources += vertexShaderCode;
+        sources += '\0';
+        sources += fragmentShaderCode ? 'f' : '-';
+        if (fragmentShaderCode)
+            sources += fragmentShaderCode;
+
+        return sources;
+    }
+
+    // Get an OpenGL string, even if the driver returns NULL
+    std::string getGlString(GLenum name)
+    {
+        const GLubyte* value = glCheck(glGetString(name));
+        return value ? reinterpret_cast<const char*>(value) : "";
+    }
+}
+
+
+namespace sf
+{
+namespace priv
+{
+////////////////////////////////////////////////////////////
+ShaderCache& ShaderCache::getInstance()
+{
+    static ShaderCache Instance;
+
+    return Instance;
+}
+
+
+////////////////////////////////////////////////////////////
+ShaderCache::ShaderCache() :
+m_mutex     (),
+m_enabled   (false),
+m_directory (),
+m_driverHash(0),
+m_entries   (),
+m_statistics()
+{
+}
+
+
+////////////////////////////////////////////////////////////
+void ShaderCache::setEnabled(bool enabled)
+{
+    Lock lock(m_mutex);
+
+    m_enabled = enabled;
+}
+
+
+////////////////////////////////////////////////////////////
+void ShaderCache::setDirectory(const std::string& directory)
+{
+    Lock lock(m_mutex);
+
+    m_directory = directory;
+}
+
+
+////////////////////////////////////////////////////////////
+unsigned int ShaderCache::acquire(const char* vertexShaderCode, const char* fragmentShaderCode)
+{
+    Lock lock(m_mutex);
+
+    if (!m_enabled && !usesBinaries())
+        return 0;
+
+    std::string sources = getSources(vertexShaderCode, fragmentShaderCode);
+    Uint64 key = hash(sources);
+
+    // Look for an identical program that is already in use
+    if (m_enabled)
+    {
+        std::pair<EntryTable::iterator, EntryTable::iterator> range = m_entries.equal_range(key);
+        for (EntryTable::iterator it = range.first; it != range.second; ++it)
+        {
+            if (it->second.sources == sources)
+            {
+                it->second.refCount++;
+                m_statistics.shared++;
+                return it->second.program;
+            }
+        }
+    }
+
+    // Then try to load a binary of the program from disk
+    unsigned int program = usesBinaries() ? loadBinary(key) : 0;
+    if (program && m_enabled)
+    {
+        Entry entry;
+        entry.sources  = sources;
+        entry.program  = program;
+        entry.refCount = 1;
+        m_entries.insert(std::make_pair(key, entry));
+    }
+
+    return program;
+}
+
+
+////////////////////////////////////////////////////////////
+void ShaderCache::prepare(unsigned int program)
+{
+    Lock lock(m_mutex);
+
+    if (usesBinaries())
+    {
+        glCheck(glProgramParameteri(program, GL_PROGRAM_BINARY_RETRIEVABLE_HINT, GL_TRUE));
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+void ShaderCache::store(const char* vertexShaderCode, const char* fragmentShaderCode, unsigned int program)
+{
+    Lock lock(m_mutex);
+
+    m_statistics.compiled++;
+
+    if (!m_enabled && !usesBinaries())
+        return;
+
+    std::string sources = getSources(vertexShaderCode, fragmentShaderCode);
+    Uint64 key = hash(sources);
+
+    if (usesBinaries())
+        saveBinary(key, program);
+
+    if (m_enabled)
+    {
+        Entry entry;
+        entry.sources  = sources;
+        entry.program  = program;
+        entry.refCount = 1;
+        m_entries.insert(std::make_pair(key, entry));
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+void ShaderCache::release(unsigned int program)
+{
+    Lock lock(m_mutex);
+
+    for (EntryTable::iterator it = m_entries.begin(); it != m_entries.end(); ++it)
+    {
+        if (it->second.program == program)
+        {
+            // Other shaders still use this program
+            if (--it->second.refCount > 0)
+                return;
+
+            m_entries.erase(it);
+            break;
+        }
+    }
+
+    glCheck(glDeleteObjectARB(program));
+}
+
+
+////////////////////////////////////////////////////////////
+void ShaderCache::addCompileTime(Time duration)
+{
+    Lock lock(m_mutex);
+
+    m_statistics.compileTime += duration;
+}
+
+
+////////////////////////////////////////////////////////////
+Shader::Statistics ShaderCache::getStatistics()
+{
+    Lock lock(m_mutex);
+
+    return m_statistics;
+}
+
+
+////////////////////////////////////////////////////////////
+unsigned int ShaderCache::loadBinary(Uint64 key)
+{
+    std::ifstream file(getBinaryPath(key).c_str(), std::ios_base::binary);
+    if (!file)
+        return 0;
+
+    // Read and validate the header; binaries produced by another
+    // driver (or driver version) are simply ignored
+    BinaryHeader header;
+    if (!file.read(reinterpret_cast<char*>(&header), sizeof(header)) ||
+        (header.magic != binaryMagic) || (header.key != key) ||
+        (header.driverHash != m_driverHash) || (header.length == 0))
+        return 0;
+
+    std::vector<char> binary(header.length);
+    if (!file.read(&binary[0], header.length))
+        return 0;
+
+    // Hand the binary to the driver, which may still reject it
+    GLhandleARB program = glCheck(glCreateProgramObjectARB());
+    glCheck(glProgramBinary(program, header.format, &binary[0], header.length));
+
+    GLint success;
+    glCheck(glGetObjectParameterivARB(program, GL_OBJECT_LINK_STATUS_ARB, &success));
+    if (success == GL_FALSE)
+    {
+        glCheck(glDeleteObjectARB(program));
+        m_statistics.rejected++;
+        return 0;
+    }
+
+    m_statistics.loaded++;
+    return program;
+}
+
+
+////////////////////////////////////////////////////////////
+void ShaderCache::saveBinary(Uint64 key, unsigned int program)
+{
+    GLint length = 0;
+    glCheck(glGetProgramiv(program, GL_PROGRAM_BINARY_LENGTH, &length));
+    if (length <= 0)
+        return;
+
+    std::vector<char> binary(length);
+    GLenum format = 0;
+    glCheck(glGetProgramBinary(program, length, NULL, &format, &binary[0]));
+
+    BinaryHeader header;
+    header.magic      = binaryMagic;
+    header.driverHash = m_driverHash;
+    header.key        = key;
+    header.format     = format;
+    header.length     = static_cast<Uint32>(length);
+
+    std::string path = getBinaryPath(key);
+    std::ofstream file(path.c_str(), std::ios_base::binary | std::ios_base::trunc);
+    if (!file.write(reinterpret_cast<const char*>(&header), sizeof(header)) ||
+        !file.write(&binary[0], length))
+    {
+        err() << "Failed to save shader binary to \"" << path << "\"" << std::endl;
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+bool ShaderCache::usesBinaries()
+{
+    if (m_directory.empty())
+        return false;
+
+    // Make sure that extensions are initialized
+    priv::ensureExtensionsInit();
+
+    if (!GLEW_ARB_get_program_binary)
+        return false;
+
+    // Identify the driver, so that binaries are invalidated when it changes
+    if (m_driverHash == 0)
+    {
+        m_driverHash = hash(getGlString(GL_VENDOR));
+        m_driverHash = hash(getGlString(GL_RENDERER), m_driverHash);
+        m_driverHash = hash(getGlString(GL_VERSION), m_driverHash);
+    }
+
+    return true;
+}
+
+
+////////////////////////////////////////////////////////////
+std::string ShaderCache::getBinaryPath(Uint64 key) const
+{
+    static const char digits[] = "0123456789abcdef";
+
+    std::string name(16, '0');
+    for (int i = 15; i >= 0; --i)
+    {
+        name[i] = digits[key & 0xF];
+        key >>= 4;
+    }
+
+    std::string path = m_directory;
+    if ((path[path.size() - 1] != '/') && (path[path.size() - 1] != '\\'))
+        path += '/';
+
+    return path + name + ".bin";
+}
+
+} // namespace priv
+
+} // namespace sf
+
+#endif // SFML_OPENGL_ES
@@ -0,0 +1,212 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2014 Laurent Gomila (laurent.gom@gmail.com)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+
+#ifndef SFML_SHADERCACHE_HPP
+#define SFML_SHADERCACHE_HPP
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Graphics/Shader.hpp>
+#include <SFML/System/Mutex.hpp>
+#include <SFML/System/NonCopyable.hpp>
+#include <map>
+#include <string>
+
+
+namespace sf
+{
+namespace priv
+{
+////////////////////////////////////////////////////////////
+/// \brief Cache of linked shader programs, shared in-process
+///        and optionally persisted to disk as program binaries
+///
+////////////////////////////////////////////////////////////
+class ShaderCache : NonCopyable
+{
+public :
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the unique instance of the class
+    ///
+    /// \return Reference to the ShaderCache instance
+    ///
+    ////////////////////////////////////////////////////////////
+    static ShaderCache& getInstance();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Enable or disable the sharing of identical programs
+    ///
+    /// \param enabled True to share programs between shaders
+    ///
+    ////////////////////////////////////////////////////////////
+    void setEnabled(bool enabled);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Set the directory where program binaries are stored
+    ///
+    /// \param directory Existing directory, or empty to disable persistence
+    ///
+    ////////////////////////////////////////////////////////////
+    void setDirectory(const std::string& directory);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Find an existing program built from the given sources
+    ///
+    /// The program is first searched in memory, then on disk.
+    /// A program returned by this function must be given back
+    /// with release().
+    ///
+    /// \param vertexShaderCode   Source code of the vertex shader, or NULL
+    /// \param fragmentShaderCode Source code of the fragment shader, or NULL
+    ///
+    /// \return OpenGL identifier of the program, or 0 if not found
+    ///
+    ////////////////////////////////////////////////////////////
+    unsigned int acquire(const char* vertexShaderCode, const char* fragmentShaderCode);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Prepare a program that is about to be linked
+    ///
+    /// This makes the program binary retrievable when
+    /// persistence is enabled.
+    ///
+    /// \param program OpenGL identifier of the program
+    ///
+    ////////////////////////////////////////////////////////////
+    void prepare(unsigned int program);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Register a program freshly compiled from source
+    ///
+    /// \param vertexShaderCode   Source code of the vertex shader, or NULL
+    /// \param fragmentShaderCode Source code of the fragment shader, or NULL
+    /// \param program            OpenGL identifier of the linked program
+    ///
+    ////////////////////////////////////////////////////////////
+    void store(const char* vertexShaderCode, const char* fragmentShaderCode, unsigned int program);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Give back a program
+    ///
+    /// The program is destroyed when it is no longer used.
+    ///
+    /// \param program OpenGL identifier of the program
+    ///
+    ////////////////////////////////////////////////////////////
+    void release(unsigned int program);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Add the duration of a program creation to the statistics
+    ///
+    /// \param duration Time spent creating the program
+    ///
+    ////////////////////////////////////////////////////////////
+    void addCompileTime(Time duration);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the statistics of the cache
+    ///
+    /// \return Copy of the current statistics
+    ///
+    ////////////////////////////////////////////////////////////
+    Shader::Statistics getStatistics();
+
+private :
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Default constructor
+    ///
+    ////////////////////////////////////////////////////////////
+    ShaderCache();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Load a program binary from the cache directory
+    ///
+    /// \param key Hash of the program sources
+    ///
+    /// \return OpenGL identifier of the program, or 0 on failure
+    ///
+    ////////////////////////////////////////////////////////////
+    unsigned int loadBinary(Uint64 key);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Save a program binary to the cache directory
+    ///
+    /// \param key     Hash of the program sources
+    /// \param program OpenGL identifier of the program
+    ///
+    ////////////////////////////////////////////////////////////
+    void saveBinary(Uint64 key, unsigned int program);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Tell whether program binaries can be persisted
+    ///
+    /// \return True if a directory is set and the driver supports binaries
+    ///
+    ////////////////////////////////////////////////////////////
+    bool usesBinaries();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the name of the binary file of a program
+    ///
+    /// \param key Hash of the program sources
+    ///
+    /// \return Full path of the file
+    ///
+    ////////////////////////////////////////////////////////////
+    std::string getBinaryPath(Uint64 key) const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Entry of the in-process cache
+    ///
+    ////////////////////////////////////////////////////////////
+    struct Entry
+    {
+        std::string  sources;  ///< Sources the program was built from, to resolve hash collisions
+        unsigned int program;  ///< OpenGL identifier of the program
+        unsigned int refCount; ///< Number of shaders using the program
+    };
+
+    typedef std::multimap<Uint64, Entry> EntryTable;
+
+    ////////////////////////////////////////////////////////////
+    // Member data
+    ////////////////////////////////////////////////////////////
+    Mutex              m_mutex;      ///< Mutex protecting the cache
+    bool               m_enabled;    ///< Are identical programs shared?
+    std::string        m_directory;  ///< Directory of the program binaries
+    Uint64             m_driverHash; ///< Identifies the driver that produced the binaries
+    EntryTable         m_entries;    ///< Programs shared in-process
+    Shader::Statistics m_statistics; ///< Cache statistics
+};
+
+} // namespace priv
+
+} // namespace sf
+
+
+#endif // SFML_SHADERCACHE_HPP
@@ -0,0 +1,222 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2014 Laurent Gomila (laurent.gom@gmail.com)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Graphics/StaticVertexArray.hpp>
+#include <SFML/Graphics/RenderTarget.hpp>
+#include <SFML/Graphics/GLCheck.hpp>
+#include <SFML/System/Err.hpp>
+
+
+namespace sf
+{
+////////////////////////////////////////////////////////////
+StaticVertexArray::StaticVertexArray() :
+m_vertices(),
+m_buffer  (0),
+m_isBaked (false)
+{
+}
+
+
+////////////////////////////////////////////////////////////
+StaticVertexArray::StaticVertexArray(PrimitiveType type) :
+m_vertices(type),
+m_buffer  (0),
+m_isBaked (false)
+{
+}
+
+
+////////////////////////////////////////////////////////////
+StaticVertexArray::~StaticVertexArray()
+{
+    if (m_buffer)
+    {
+        ensureGlContext();
+
+        GLuint buffer = static_cast<GLuint>(m_buffer);
+        glCheck(GLEXT_glDeleteBuffers(1, &buffer));
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+unsigned int StaticVertexArray::getVertexCount() const
+{
+    return m_vertices.getVertexCount();
+}
+
+
+////////////////////////////////////////////////////////////
+const Vertex& StaticVertexArray::operator [](unsigned int index) const
+{
+    return m_vertices[index];
+}
+
+
+////////////////////////////////////////////////////////////
+void StaticVertexArray::clear()
+{
+    if (checkMutable())
+        m_vertices.clear();
+}
+
+
+////////////////////////////////////////////////////////////
+void StaticVertexArray::resize(unsigned int vertexCount)
+{
+    if (checkMutable())
+        m_vertices.resize(vertexCount);
+}
+
+
+////////////////////////////////////////////////////////////
+void StaticVertexArray::append(const Vertex& vertex)
+{
+    if (checkMutable())
+        m_vertices.append(vertex);
+}
+
+
+////////////////////////////////////////////////////////////
+void StaticVertexArray::append(const Vertex* vertices, unsigned int vertexCount)
+{
+    if (vertices && checkMutable())
+    {
+        for (unsigned int i = 0; i < vertexCount; ++i)
+            m_vertices.append(vertices[i]);
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+void StaticVertexArray::setPrimitiveType(PrimitiveType type)
+{
+    if (checkMutable())
+        m_vertices.setPrimitiveType(type);
+}
+
+
+////////////////////////////////////////////////////////////
+PrimitiveType StaticVertexArray::getPrimitiveType() const
+{
+    return m_vertices.getPrimitiveType();
+}
+
+
+////////////////////////////////////////////////////////////
+FloatRect StaticVertexArray::getBounds() const
+{
+    return m_vertices.getBounds();
+}
+
+
+////////////////////////////////////////////////////////////
+bool StaticVertexArray::bake()
+{
+    if (m_isBaked)
+        return m_buffer != 0;
+
+    m_isBaked = true;
+
+    // Nothing to upload?
+    if (m_vertices.getVertexCount() == 0)
+        return false;
+
+    // Fall back to client-side arrays if vertex buffers are not supported
+    if (!isAvailable())
+        return false;
+
+    ensureGlContext();
+
+    // Create the vertex buffer
+    GLuint buffer = 0;
+    glCheck(GLEXT_glGenBuffers(1, &buffer));
+    m_buffer = static_cast<unsigned int>(buffer);
+    if (!m_buffer)
+    {
+        err() << "Failed to bake vertex array (failed to create the vertex buffer)" << std::endl;
+        return false;
+    }
+
+    // Upload the vertices, they will never change again
+    const Vertex* vertices = &m_vertices[0];
+    glCheck(GLEXT_glBindBuffer(GLEXT_GL_ARRAY_BUFFER, m_buffer));
+    glCheck(GLEXT_glBufferData(GLEXT_GL_ARRAY_BUFFER, sizeof(Vertex) * m_vertices.getVertexCount(), vertices, GLEXT_GL_STATIC_DRAW));
+    glCheck(GLEXT_glBindBuffer(GLEXT_GL_ARRAY_BUFFER, 0));
+
+    // Force an OpenGL flush, so that the buffer will appear updated
+    // in all contexts immediately (solves problems in multi-threaded apps)
+    glCheck(glFlush());
+
+    return true;
+}
+
+
+////////////////////////////////////////////////////////////
+bool StaticVertexArray::isBaked() const
+{
+    return m_isBaked;
+}
+
+
+////////////////////////////////////////////////////////////
+bool StaticVertexArray::isAvailable()
+{
+    ensureGlContext();
+
+    // Make sure that extensions are initialized
+    priv::ensureExtensionsInit();
+
+    return GLEXT_vertex_buffer_object != 0;
+}
+
+
+////////////////////////////////////////////////////////////
+void StaticVertexArray::draw(RenderTarget& target, RenderStates states) const
+{
+    if (m_buffer)
+        target.drawBuffer(m_buffer, m_vertices.getVertexCount(), m_vertices.getPrimitiveType(), states);
+    else
+        target.draw(m_vertices, states);
+}
+
+
+////////////////////////////////////////////////////////////
+bool StaticVertexArray::checkMutable() const
+{
+    if (m_isBaked)
+    {
+        err() << "Cannot modify a baked vertex array" << std::endl;
+        return false;
+    }
+
+    return true;
+}
+
+} // namespace sf
@@ -33,16 +33,20 @@ namespace sf
 {
 ////////////////////////////////////////////////////////////
 VertexArray::VertexArray() :
-m_vertices     (),
-m_primitiveType(Points)
+m_vertices         (),
+m_primitiveType    (Points),
+m_bounds           (),
+m_boundsNeedUpdate (false)
 {
 }
 
 
 ////////////////////////////////////////////////////////////
 VertexArray::VertexArray(PrimitiveType type, unsigned int vertexCount) :
-m_vertices     (vertexCount),
-m_primitiveType(type)
+m_vertices         (vertexCount),
+m_primitiveType    (type),
+m_bounds           (),
+m_boundsNeedUpdate (vertexCount > 0)
 {
 }
 
@@ -57,6 +61,9 @@ unsigned int VertexArray::getVertexCount() const
 ////////////////////////////////////////////////////////////
 Vertex& VertexArray::operator [](unsigned int index)
 {
+    // The vertex may be modified through the returned reference
+    m_boundsNeedUpdate = true;
+
     return m_vertices[index];
 }
 
@@ -72,13 +79,27 @@ const Vertex& VertexArray::operator [](unsigned int index) const
 void VertexArray::clear()
 {
     m_vertices.clear();
+    m_bounds = FloatRect();
+    m_boundsNeedUpdate = false;
 }
 
 
 ////////////////////////////////////////////////////////////
 void VertexArray::resize(unsigned int vertexCount)
 {
+    std::size_t previousCount = m_vertices.size();
     m_vertices.resize(vertexCount);
+
+    if (vertexCount < previousCount)
+    {
+        // Removed vertices may have defined the bounds
+        m_boundsNeedUpdate = true;
+    }
+    else if (vertexCount > previousCount)
+    {
+        // New vertices are all located at the origin
+        extendBounds(Vector2f(0, 0), previousCount == 0);
+    }
 }
 
 
@@ -86,6 +107,8 @@ void VertexArray::resize(unsigned int vertexCount)
 void VertexArray::append(const Vertex& vertex)
 {
     m_vertices.push_back(vertex);
+
+    extendBounds(vertex.position, m_vertices.size() == 1);
 }
 
 
@@ -105,6 +128,56 @@ PrimitiveType VertexArray::getPrimitiveType() const
 
 ////////////////////////////////////////////////////////////
 FloatRect VertexArray::getBounds() const
+{
+    if (m_boundsNeedUpdate)
+        updateBounds();
+
+    return m_bounds;
+}
+
+
+////////////////////////////////////////////////////////////
+void VertexArray::draw(RenderTarget& target, RenderStates states) const
+{
+    if (!m_vertices.empty())
+        target.draw(&m_vertices[0], static_cast<unsigned int>(m_vertices.size()), m_primitiveType, states);
+}
+
+
+////////////////////////////////////////////////////////////
+void VertexArray::extendBounds(const Vector2f& position, bool first)
+{
+    // Nothing to do if the bounds will be recomputed anyway
+    if (m_boundsNeedUpdate)
+        return;
+
+    if (first)
+    {
+        m_bounds = FloatRect(position.x, position.y, 0, 0);
+        return;
+    }
+
+    float left   = m_bounds.left;
+    float top    = m_bounds.top;
+    float right  = m_bounds.left + m_bounds.width;
+    float bottom = m_bounds.top + m_bounds.height;
+
+    if (position.x < left)
+        left = position.x;
+    else if (position.x > right)
+        right = position.x;
+
+    if (position.y < top)
+        top = position.y;
+    else if (position.y > bottom)
+        bottom = position.y;
+
+    m_bounds = FloatRect(left, top, right - left, bottom - top);
+}
+
+
+////////////////////////////////////////////////////////////
+void VertexArray::updateBounds() const
 {
     if (!m_vertices.empty())
     {
@@ -130,21 +203,15 @@ FloatRect VertexArray::getBounds() const
                 bottom = position.y;
         }
 
-        return FloatRect(left, top, right - left, bottom - top);
+        m_bounds = FloatRect(left, top, right - left, bottom - top);
     }
     else
     {
         // Array is empty
-        return FloatRect();
+        m_bounds = FloatRect();
     }
-}
-
 
-////////////////////////////////////////////////////////////
-void VertexArray::draw(RenderTarget& target, RenderStates states) const
-{
-    if (!m_vertices.empty())
-        target.draw(&m_vertices[0], static_cast<unsigned int>(m_vertices.size()), m_primitiveType, states);
+    m_boundsNeedUpdate = false;
 }
 
 } // namespace sf
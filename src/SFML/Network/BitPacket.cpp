@@ -0,0 +1,372 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2014 Laurent Gomila (laurent.gom@gmail.com)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Network/BitPacket.hpp>
+#include <algorithm>
+#include <cstring>
+
+
+namespace
+{
+    // Maximum value of an unsigned integer of the given number of bits
+    sf::Uint32 maxValue(unsigned int bits)
+    {
+        return bits >= 32 ? 0xFFFFFFFF : (static_cast<sf::Uint32>(1) << bits) - 1;
+    }
+}
+
+
+namespace sf
+{
+////////////////////////////////////////////////////////////
+BitPacket::BitPacket() :
+m_bits       (),
+m_bitWritePos(0),
+m_bitReadPos (0),
+m_bitsValid  (true),
+m_sendBuffer ()
+{
+
+}
+
+
+////////////////////////////////////////////////////////////
+void BitPacket::clear()
+{
+    Packet::clear();
+
+    m_bits.clear();
+    m_bitWritePos = 0;
+    m_bitReadPos = 0;
+    m_bitsValid = true;
+}
+
+
+////////////////////////////////////////////////////////////
+BitPacket::operator BoolType() const
+{
+    return m_bitsValid ? Packet::operator BoolType() : NULL;
+}
+
+
+////////////////////////////////////////////////////////////
+BitPacket& BitPacket::writeBits(Uint32 value, unsigned int count)
+{
+    count = std::min(count, 32u);
+    value &= maxValue(count);
+
+    while (count > 0)
+    {
+        // Fill the free bits of the last byte, or start a new one
+        unsigned int offset = static_cast<unsigned int>(m_bitWritePos % 8);
+        if (offset == 0)
+            m_bits.push_back(0);
+
+        unsigned int chunk = std::min(8 - offset, count);
+        m_bits.back() |= static_cast<Uint8>((value & maxValue(chunk)) << offset);
+
+        value >>= chunk;
+        count -= chunk;
+        m_bitWritePos += chunk;
+    }
+
+    return *this;
+}
+
+
+////////////////////////////////////////////////////////////
+BitPacket& BitPacket::writeBool(bool value)
+{
+    return writeBits(value ? 1 : 0, 1);
+}
+
+
+////////////////////////////////////////////////////////////
+BitPacket& BitPacket::writeVarint(Uint32 value)
+{
+    writeVarint64(value);
+    return *this;
+}
+
+
+////////////////////////////////////////////////////////////
+BitPacket& BitPacket::writeVarint(Uint64 value)
+{
+    writeVarint64(value);
+    return *this;
+}
+
+
+////////////////////////////////////////////////////////////
+BitPacket& BitPacket::writeVarint(Int32 value)
+{
+    // Zigzag encoding: 0, -1, 1, -2, 2... become 0, 1, 2, 3, 4...
+    Uint32 encoded = (static_cast<Uint32>(value) << 1) ^ static_cast<Uint32>(value >> 31);
+    writeVarint64(encoded);
+    return *this;
+}
+
+
+////////////////////////////////////////////////////////////
+BitPacket& BitPacket::writeVarint(Int64 value)
+{
+    Uint64 encoded = (static_cast<Uint64>(value) << 1) ^ static_cast<Uint64>(value >> 63);
+    writeVarint64(encoded);
+    return *this;
+}
+
+
+////////////////////////////////////////////////////////////
+BitPacket& BitPacket::writeFloat(float value, float min, float max, unsigned int bits)
+{
+    bits = std::max(1u, std::min(bits, 32u));
+
+    double range = static_cast<double>(max) - min;
+    double normalized = range > 0 ? (value - static_cast<double>(min)) / range : 0.0;
+    normalized = std::max(0.0, std::min(normalized, 1.0));
+
+    return writeBits(static_cast<Uint32>(normalized * maxValue(bits) + 0.5), bits);
+}
+
+
+////////////////////////////////////////////////////////////
+BitPacket& BitPacket::readBits(Uint32& value, unsigned int count)
+{
+    count = std::min(count, 32u);
+
+    if (!m_bitsValid || (m_bitReadPos + count > m_bitWritePos))
+    {
+        m_bitsValid = false;
+        return *this;
+    }
+
+    value = 0;
+    unsigned int shift = 0;
+    while (count > 0)
+    {
+        unsigned int offset = static_cast<unsigned int>(m_bitReadPos % 8);
+        unsigned int chunk = std::min(8 - offset, count);
+        Uint32 bits = (m_bits[m_bitReadPos / 8] >> offset) & maxValue(chunk);
+
+        value |= bits << shift;
+        shift += chunk;
+        count -= chunk;
+        m_bitReadPos += chunk;
+    }
+
+    return *this;
+}
+
+
+////////////////////////////////////////////////////////////
+BitPacket& BitPacket::readBool(bool& value)
+{
+    Uint32 bit = 0;
+    if (readBits(bit, 1))
+        value = (bit != 0);
+
+    return *this;
+}
+
+
+////////////////////////////////////////////////////////////
+BitPacket& BitPacket::readVarint(Uint32& value)
+{
+    Uint64 result = 0;
+    if (readVarint64(result, 32))
+        value = static_cast<Uint32>(result);
+
+    return *this;
+}
+
+
+////////////////////////////////////////////////////////////
+BitPacket& BitPacket::readVarint(Uint64& value)
+{
+    Uint64 result = 0;
+    if (readVarint64(result, 64))
+        value = result;
+
+    return *this;
+}
+
+
+////////////////////////////////////////////////////////////
+BitPacket& BitPacket::readVarint(Int32& value)
+{
+    Uint64 result = 0;
+    if (readVarint64(result, 32))
+    {
+        Uint32 encoded = static_cast<Uint32>(result);
+        value = static_cast<Int32>((encoded >> 1) ^ (0 - (encoded & 1)));
+    }
+
+    return *this;
+}
+
+
+////////////////////////////////////////////////////////////
+BitPacket& BitPacket::readVarint(Int64& value)
+{
+    Uint64 encoded = 0;
+    if (readVarint64(encoded, 64))
+        value = static_cast<Int64>((encoded >> 1) ^ (0 - (encoded & 1)));
+
+    return *this;
+}
+
+
+////////////////////////////////////////////////////////////
+BitPacket& BitPacket::readFloat(float& value, float min, float max, unsigned int bits)
+{
+    bits = std::max(1u, std::min(bits, 32u));
+
+    Uint32 quantized = 0;
+    if (readBits(quantized, bits))
+        value = static_cast<float>(min + (static_cast<double>(max) - min) * quantized / maxValue(bits));
+
+    return *this;
+}
+
+
+////////////////////////////////////////////////////////////
+std::size_t BitPacket::getBitCount() const
+{
+    return m_bitWritePos;
+}
+
+
+////////////////////////////////////////////////////////////
+const void* BitPacket::onSend(std::size_t& size)
+{
+    // Layout: varint byte count of the bit-packed data, bit-packed data, regular data
+    m_sendBuffer.clear();
+
+    std::size_t count = m_bits.size();
+    do
+    {
+        char byte = static_cast<char>(count & 0x7F);
+        count >>= 7;
+        if (count > 0)
+            byte |= static_cast<char>(0x80);
+        m_sendBuffer.push_back(byte);
+    }
+    while (count > 0);
+
+    std::size_t header = m_sendBuffer.size();
+    m_sendBuffer.resize(header + m_bits.size() + getDataSize());
+    if (!m_bits.empty())
+        std::memcpy(&m_sendBuffer[header], &m_bits[0], m_bits.size());
+    if (getDataSize() > 0)
+        std::memcpy(&m_sendBuffer[header + m_bits.size()], getData(), getDataSize());
+
+    size = m_sendBuffer.size();
+    return &m_sendBuffer[0];
+}
+
+
+////////////////////////////////////////////////////////////
+void BitPacket::onReceive(const void* data, std::size_t size)
+{
+    // The sockets only clear the regular data before calling onReceive
+    m_bits.clear();
+    m_bitWritePos = 0;
+    m_bitReadPos = 0;
+    m_bitsValid = true;
+
+    const Uint8* bytes = static_cast<const Uint8*>(data);
+
+    // Decode the size of the bit-packed data
+    std::size_t count = 0;
+    std::size_t position = 0;
+    for (unsigned int shift = 0; ; shift += 7)
+    {
+        if ((position >= size) || (shift >= sizeof(std::size_t) * 8))
+        {
+            // Malformed packet: leave it empty and invalid
+            m_bitsValid = false;
+            return;
+        }
+
+        Uint8 byte = bytes[position++];
+        count |= static_cast<std::size_t>(byte & 0x7F) << shift;
+        if (!(byte & 0x80))
+            break;
+    }
+
+    if (count > size - position)
+    {
+        m_bitsValid = false;
+        return;
+    }
+
+    m_bits.assign(bytes + position, bytes + position + count);
+    m_bitWritePos = count * 8;
+    position += count;
+
+    if (position < size)
+        append(bytes + position, size - position);
+}
+
+
+////////////////////////////////////////////////////////////
+void BitPacket::writeVarint64(Uint64 value)
+{
+    do
+    {
+        Uint32 byte = static_cast<Uint32>(value & 0x7F);
+        value >>= 7;
+        if (value > 0)
+            byte |= 0x80;
+        writeBits(byte, 8);
+    }
+    while (value > 0);
+}
+
+
+////////////////////////////////////////////////////////////
+bool BitPacket::readVarint64(Uint64& value, unsigned int maxBits)
+{
+    value = 0;
+    for (unsigned int shift = 0; shift < maxBits; shift += 7)
+    {
+        Uint32 byte = 0;
+        if (!readBits(byte, 8))
+            return false;
+
+        value |= static_cast<Uint64>(byte & 0x7F) << shift;
+        if (!(byte & 0x80))
+            return true;
+    }
+
+    // Too many bytes for the destination type
+    m_bitsValid = false;
+    return false;
+}
+
+} // namespace sf
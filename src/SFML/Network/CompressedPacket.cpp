@@ -0,0 +1,412 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2014 Laurent Gomila (laurent.gom@gmail.com)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Network/CompressedPacket.hpp>
+#include <algorithm>
+#include <cstring>
+
+
+namespace
+{
+    // Header flags
+    const sf::Uint8 flagCompressed = 0x01;
+    const sf::Uint8 flagStreaming  = 0x80;
+
+    // Size of the header of compressed packets: flags + uncompressed size
+    const std::size_t headerSize = 5;
+
+    // LZ4 block format constants
+    const unsigned int hashBits     = 12;
+    const unsigned int minMatch     = 4;
+    const std::size_t  maxOffset    = 65535;
+    const std::size_t  lastLiterals = 5;
+    const std::size_t  matchLimit   = 12;
+
+    // Size of the history kept in streaming mode; it is trimmed
+    // to maxOffset bytes only when it reaches twice this size
+    const std::size_t historySize = maxOffset;
+
+    sf::Uint32 read32(const sf::Uint8* data)
+    {
+        sf::Uint32 value;
+        std::memcpy(&value, data, sizeof(value));
+        return value;
+    }
+
+    sf::Uint32 hash(sf::Uint32 sequence)
+    {
+        return (sequence * 2654435761U) >> (32 - hashBits);
+    }
+
+    void writeLength(std::vector<char>& output, std::size_t length)
+    {
+        for (; length >= 255; length -= 255)
+            output.push_back(static_cast<char>(255));
+        output.push_back(static_cast<char>(length));
+    }
+
+    bool readLength(const sf::Uint8* input, std::size_t size, std::size_t& position, std::size_t& length)
+    {
+        sf::Uint8 byte;
+        do
+        {
+            if (position >= size)
+                return false;
+            byte = input[position++];
+            length += byte;
+        }
+        while (byte == 255);
+
+        return true;
+    }
+
+    ////////////////////////////////////////////////////////////
+    // Compress window[start, end) to the LZ4 block format,
+    // using window[0, start) as a dictionary. base is the stream
+    // position of window[0], used to store and validate positions
+    // in the hash table. Returns false if the output would be
+    // bigger than maxSize bytes.
+    ////////////////////////////////////////////////////////////
+    bool compress(const sf::Uint8* window, std::size_t start, std::size_t end, sf::Uint32 base,
+                  std::vector<sf::Uint32>& table, std::vector<char>& output, std::size_t maxSize)
+    {
+        std::size_t outputStart = output.size();
+        std::size_t anchor = start;
+        std::size_t position = start;
+
+        if (end - start > matchLimit)
+        {
+            std::size_t limit = end - matchLimit;
+            while (position < limit)
+            {
+                sf::Uint32 sequence = read32(window + position);
+                sf::Uint32& entry = table[hash(sequence)];
+                sf::Uint32 candidate = entry;
+                entry = static_cast<sf::Uint32>(base + position);
+
+                // The candidate must be inside the window, and close enough
+                std::size_t match = candidate - base;
+                if ((candidate < base) || (match >= position) || (position - match > maxOffset) ||
+                    (read32(window + match) != sequence))
+                {
+                    // Skip faster through data which doesn't compress
+                    position += 1 + ((position - anchor) >> 6);
+                    continue;
+                }
+
+                // Extend the match
+                std::size_t length = minMatch;
+                while ((position + length < end - lastLiterals) && (window[match + length] == window[position + length]))
+                    ++length;
+
+                // Write the sequence: token, literals, offset, match length
+                std::size_t literals = position - anchor;
+                if (output.size() - outputStart + literals + 8 + literals / 255 + length / 255 > maxSize)
+                    return false;
+
+                std::size_t high = std::min<std::size_t>(literals, 15);
+                std::size_t low  = std::min<std::size_t>(length - minMatch, 15);
+                output.push_back(static_cast<char>((high << 4) | low));
+                if (literals >= 15)
+                    writeLength(output, literals - 15);
+                output.insert(output.end(), window + anchor, window + position);
+
+                std::size_t offset = position - match;
+                output.push_back(static_cast<char>(offset & 0xFF));
+                output.push_back(static_cast<char>(offset >> 8));
+                if (length - minMatch >= 15)
+                    writeLength(output, length - minMatch - 15);
+
+                position += length;
+                anchor = position;
+            }
+        }
+
+        // Write the last literals
+        std::size_t literals = end - anchor;
+        if (output.size() - outputStart + literals + 1 + literals / 255 + 1 > maxSize)
+            return false;
+
+        output.push_back(static_cast<char>(std::min<std::size_t>(literals, 15) << 4));
+        if (literals >= 15)
+            writeLength(output, literals - 15);
+        output.insert(output.end(), window + anchor, window + end);
+
+        return true;
+    }
+
+    ////////////////////////////////////////////////////////////
+    // Uncompress a LZ4 block at the end of output, whose
+    // current contents are used as a dictionary
+    ////////////////////////////////////////////////////////////
+    bool uncompress(const sf::Uint8* input, std::size_t size, std::vector<char>& output, std::size_t uncompressedSize)
+    {
+        std::size_t position = output.size();
+        std::size_t end = position + uncompressedSize;
+        output.resize(end);
+
+        std::size_t in = 0;
+        while (in < size)
+        {
+            sf::Uint8 token = input[in++];
+
+            // Literals
+            std::size_t literals = token >> 4;
+            if ((literals == 15) && !readLength(input, size, in, literals))
+                return false;
+            if ((literals > size - in) || (literals > end - position))
+                return false;
+            if (literals > 0)
+                std::memcpy(&output[position], input + in, literals);
+            in += literals;
+            position += literals;
+
+            // The last sequence has no match
+            if (in == size)
+                break;
+
+            // Match
+            if (size - in < 2)
+                return false;
+            std::size_t offset = input[in] | (input[in + 1] << 8);
+            in += 2;
+
+            std::size_t length = token & 0x0F;
+            if ((length == 15) && !readLength(input, size, in, length))
+                return false;
+            length += minMatch;
+
+            if ((offset == 0) || (offset > position) || (length > end - position))
+                return false;
+
+            // The match can overlap the bytes being written, so copy forward
+            char* destination = &output[position];
+            const char* source = destination - offset;
+            if (offset >= length)
+            {
+                std::memcpy(destination, source, length);
+            }
+            else
+            {
+                for (std::size_t i = 0; i < length; ++i)
+                    destination[i] = source[i];
+            }
+            position += length;
+        }
+
+        return position == end;
+    }
+}
+
+
+namespace sf
+{
+////////////////////////////////////////////////////////////
+CompressedPacket::CompressedPacket(Codec codec, std::size_t threshold, bool streaming) :
+m_codec        (codec),
+m_threshold    (threshold),
+m_streaming    (streaming),
+m_output       (),
+m_hashTable    (),
+m_sendHistory  (),
+m_sendPosition (1),
+m_receiveBuffer()
+{
+
+}
+
+
+////////////////////////////////////////////////////////////
+void CompressedPacket::setCodec(Codec codec)
+{
+    m_codec = codec;
+}
+
+
+////////////////////////////////////////////////////////////
+CompressedPacket::Codec CompressedPacket::getCodec() const
+{
+    return m_codec;
+}
+
+
+////////////////////////////////////////////////////////////
+void CompressedPacket::setThreshold(std::size_t threshold)
+{
+    m_threshold = threshold;
+}
+
+
+////////////////////////////////////////////////////////////
+std::size_t CompressedPacket::getThreshold() const
+{
+    return m_threshold;
+}
+
+
+////////////////////////////////////////////////////////////
+void CompressedPacket::setStreaming(bool streaming)
+{
+    m_streaming = streaming;
+    resetStream();
+}
+
+
+////////////////////////////////////////////////////////////
+bool CompressedPacket::isStreaming() const
+{
+    return m_streaming;
+}
+
+
+////////////////////////////////////////////////////////////
+void CompressedPacket::resetStream()
+{
+    m_sendHistory.clear();
+    m_receiveBuffer.clear();
+
+    // Positions stored in the hash table are now outside of the window
+    // and will be ignored; the table is cleared if they could wrap around
+    m_sendPosition += static_cast<Uint32>(maxOffset + 1);
+}
+
+
+////////////////////////////////////////////////////////////
+const void* CompressedPacket::onSend(std::size_t& size)
+{
+    std::size_t dataSize = getDataSize();
+    const Uint8* data = static_cast<const Uint8*>(getData());
+
+    // Build the window to compress: the history (if any) followed by the packet data
+    const Uint8* window = data;
+    std::size_t start = 0;
+    if (m_streaming)
+    {
+        start = m_sendHistory.size();
+        m_sendHistory.insert(m_sendHistory.end(), data, data + dataSize);
+        window = m_sendHistory.empty() ? NULL : reinterpret_cast<const Uint8*>(&m_sendHistory[0]);
+    }
+
+    // Reset the stream positions long before they overflow
+    if (m_sendPosition > 0x7FFFFFFF - dataSize - start)
+    {
+        m_hashTable.clear();
+        m_sendPosition = 1 + static_cast<Uint32>(start);
+    }
+
+    m_output.clear();
+    Uint8 flags = m_streaming ? flagStreaming : 0;
+    bool compressed = false;
+
+    if ((m_codec == Lz4) && (dataSize > headerSize) && (dataSize >= m_threshold))
+    {
+        if (m_hashTable.empty())
+            m_hashTable.resize(1 << hashBits, 0);
+
+        m_output.reserve(headerSize + dataSize);
+        m_output.push_back(static_cast<char>(flags | flagCompressed));
+        m_output.push_back(static_cast<char>(dataSize >> 24));
+        m_output.push_back(static_cast<char>(dataSize >> 16));
+        m_output.push_back(static_cast<char>(dataSize >> 8));
+        m_output.push_back(static_cast<char>(dataSize));
+
+        Uint32 base = m_sendPosition - static_cast<Uint32>(start);
+        compressed = compress(window, start, start + dataSize, base, m_hashTable, m_output, dataSize - headerSize);
+    }
+
+    if (!compressed)
+    {
+        // Send the data as is
+        m_output.resize(1 + dataSize);
+        m_output[0] = static_cast<char>(flags);
+        if (dataSize > 0)
+            std::memcpy(&m_output[1], data, dataSize);
+    }
+
+    // Advance the stream, so that positions of this packet are ignored by the next
+    // one if it doesn't use the history
+    m_sendPosition += static_cast<Uint32>(dataSize);
+    if (m_streaming && (m_sendHistory.size() > 2 * historySize))
+        m_sendHistory.erase(m_sendHistory.begin(), m_sendHistory.end() - historySize);
+
+    size = m_output.size();
+    return &m_output[0];
+}
+
+
+////////////////////////////////////////////////////////////
+void CompressedPacket::onReceive(const void* data, std::size_t size)
+{
+    const Uint8* bytes = static_cast<const Uint8*>(data);
+    if (size == 0)
+        return;
+
+    // The receiver must use the same mode as the sender
+    Uint8 flags = bytes[0];
+    if (((flags & flagStreaming) != 0) != m_streaming)
+        return;
+
+    if (!m_streaming)
+        m_receiveBuffer.clear();
+    std::size_t start = m_receiveBuffer.size();
+
+    if (flags & flagCompressed)
+    {
+        if (size < headerSize)
+            return;
+
+        std::size_t uncompressedSize = (static_cast<std::size_t>(bytes[1]) << 24) |
+                                       (static_cast<std::size_t>(bytes[2]) << 16) |
+                                       (static_cast<std::size_t>(bytes[3]) << 8)  |
+                                       (static_cast<std::size_t>(bytes[4]));
+
+        // LZ4 can't expand a byte to more than 255 bytes, which bounds the
+        // size to allocate even if the header is corrupted
+        if (uncompressedSize / 255 > size)
+            return;
+
+        if (!uncompress(bytes + headerSize, size - headerSize, m_receiveBuffer, uncompressedSize))
+        {
+            // Corrupted data: the history is not usable anymore
+            m_receiveBuffer.resize(start);
+            return;
+        }
+    }
+    else
+    {
+        m_receiveBuffer.insert(m_receiveBuffer.end(), bytes + 1, bytes + size);
+    }
+
+    if (m_receiveBuffer.size() > start)
+        append(&m_receiveBuffer[start], m_receiveBuffer.size() - start);
+
+    if (m_streaming && (m_receiveBuffer.size() > 2 * historySize))
+        m_receiveBuffer.erase(m_receiveBuffer.begin(), m_receiveBuffer.end() - historySize);
+}
+
+} // namespace sf
@@ -29,11 +29,132 @@
 #include <SFML/Network/IpAddress.hpp>
 #include <algorithm>
 #include <cctype>
+#include <cstdio>
 #include <fstream>
-#include <iterator>
 #include <sstream>
 
 
+namespace
+{
+    // Minimum (and default) size of the buffer used for file transfers
+    const std::size_t minBufferSize = 65536;
+
+    // Output stream writing to a local file, which is created on the first write
+    class FileOutputStream : public sf::OutputStream
+    {
+    public :
+
+        FileOutputStream(const std::string& filename) :
+        m_filename(filename)
+        {
+        }
+
+        bool open()
+        {
+            if (!m_file.is_open())
+                m_file.open(m_filename.c_str(), std::ios_base::binary);
+
+            return m_file.good();
+        }
+
+        bool close()
+        {
+            m_file.close();
+            return !m_file.fail();
+        }
+
+        void discard()
+        {
+            // Only remove the file if it was created by this stream
+            if (m_file.is_open())
+            {
+                m_file.close();
+                std::remove(m_filename.c_str());
+            }
+        }
+
+        virtual sf::Int64 write(const void* data, sf::Int64 size)
+        {
+            if (!open())
+                return -1;
+
+            m_file.write(static_cast<const char*>(data), static_cast<std::streamsize>(size));
+            return m_file ? size : -1;
+        }
+
+    private :
+
+        std::string   m_filename;
+        std::ofstream m_file;
+    };
+
+    // Input stream reading from a local file
+    class FileInputStream : public sf::InputStream
+    {
+    public :
+
+        bool open(const std::string& filename)
+        {
+            m_file.open(filename.c_str(), std::ios_base::binary);
+            return m_file.is_open();
+        }
+
+        virtual sf::Int64 read(void* data, sf::Int64 size)
+        {
+            m_file.read(static_cast<char*>(data), static_cast<std::streamsize>(size));
+            return m_file.bad() ? -1 : static_cast<sf::Int64>(m_file.gcount());
+        }
+
+        virtual sf::Int64 seek(sf::Int64 position)
+        {
+            m_file.clear();
+            m_file.seekg(static_cast<std::streamoff>(position));
+            return m_file ? position : -1;
+        }
+
+        virtual sf::Int64 tell()
+        {
+            return static_cast<sf::Int64>(m_file.tellg());
+        }
+
+        virtual sf::Int64 getSize()
+        {
+            std::streampos position = m_file.tellg();
+            m_file.seekg(0, std::ios_base::end);
+            sf::Int64 size = static_cast<sf::Int64>(m_file.tellg());
+            m_file.seekg(position);
+            return size;
+        }
+
+    private :
+
+        std::ifstream m_file;
+    };
+
+    // Output stream appending to an array of bytes
+    class MemoryOutputStream : public sf::OutputStream
+    {
+    public :
+
+        MemoryOutputStream(std::vector<char>& data) :
+        m_data(data)
+        {
+        }
+
+        virtual sf::Int64 write(const void* data, sf::Int64 size)
+        {
+            const char* begin = static_cast<const char*>(data);
+            m_data.insert(m_data.end(), begin, begin + size);
+            return size;
+        }
+
+    private :
+
+        std::vector<char>& m_data;
+    };
+}
+
+
 namespace sf
 {
 ////////////////////////////////////////////////////////////
@@ -48,10 +169,10 @@ public :
     Ftp::Response open(Ftp::TransferMode mode);
 
     ////////////////////////////////////////////////////////////
-    void send(const std::vector<char>& data);
+    Ftp::Response::Status send(InputStream& stream, Uint64 total, ProgressListener* listener);
 
     ////////////////////////////////////////////////////////////
-    void receive(std::vector<char>& data);
+    Ftp::Response::Status receive(OutputStream& stream, Uint64 total, ProgressListener* listener);
 
 private :
 
@@ -139,6 +260,20 @@ const std::vector<std::string>& Ftp::ListingResponse::getListing() const
 }
 
 
+////////////////////////////////////////////////////////////
+Ftp::ProgressListener::~ProgressListener()
+{
+}
+
+
+////////////////////////////////////////////////////////////
+Ftp::Ftp() :
+m_bufferSize(minBufferSize)
+{
+
+}
+
+
 ////////////////////////////////////////////////////////////
 Ftp::~Ftp()
 {
@@ -207,6 +342,7 @@ Ftp::ListingResponse Ftp::getDirectoryListing(const std::string& directory)
 {
     // Open a data channel on default port (20) using ASCII transfer mode
     std::vector<char> directoryData;
+    MemoryOutputStream stream(directoryData);
     DataChannel data(*this);
     Response response = data.open(Ascii);
     if (response.isOk())
@@ -216,7 +352,7 @@ Ftp::ListingResponse Ftp::getDirectoryListing(const std::string& directory)
         if (response.isOk())
         {
             // Receive the listing
-            data.receive(directoryData);
+            data.receive(stream, 0, NULL);
 
             // Get the response from the server
             response = getResponse();
@@ -274,44 +410,77 @@ Ftp::Response Ftp::deleteFile(const std::string& name)
 
 
 ////////////////////////////////////////////////////////////
-Ftp::Response Ftp::download(const std::string& remoteFile, const std::string& localPath, TransferMode mode)
+Ftp::Response Ftp::download(const std::string& remoteFile, const std::string& localPath, TransferMode mode, ProgressListener* listener)
+{
+    // Extract the filename from the file path
+    std::string filename = remoteFile;
+    std::string::size_type pos = filename.find_last_of("/\\");
+    if (pos != std::string::npos)
+        filename = filename.substr(pos + 1);
+
+    // Make sure the destination path ends with a slash
+    std::string path = localPath;
+    if (!path.empty() && (path[path.size() - 1] != '\\') && (path[path.size() - 1] != '/'))
+        path += "/";
+
+    // Write the received data directly into the file
+    FileOutputStream file(path + filename);
+    Response response = download(remoteFile, file, mode, listener);
+
+    // Don't leave an incomplete file behind
+    if (!response.isOk())
+    {
+        file.discard();
+        return response;
+    }
+
+    // Create the file even if it's empty
+    if (!file.open())
+        return Response(Response::InvalidFile);
+
+    // Writing the end of the file may still fail
+    if (!file.close())
+    {
+        std::remove((path + filename).c_str());
+        return Response(Response::InvalidFile);
+    }
+
+    return response;
+}
+
+
+////////////////////////////////////////////////////////////
+Ftp::Response Ftp::download(const std::string& remoteFile, OutputStream& stream, TransferMode mode, ProgressListener* listener)
 {
     // Open a data channel using the given transfer mode
     DataChannel data(*this);
     Response response = data.open(mode);
     if (response.isOk())
     {
+        // Get the size of the file, to report the progress
+        Uint64 total = 0;
+        if (listener)
+        {
+            Response size = sendCommand("SIZE", remoteFile);
+            if (size.isOk())
+            {
+                std::istringstream in(size.getMessage());
+                if (!(in >> total))
+                    total = 0;
+            }
+        }
+
         // Tell the server to start the transfer
         response = sendCommand("RETR", remoteFile);
         if (response.isOk())
         {
             // Receive the file data
-            std::vector<char> fileData;
-            data.receive(fileData);
+            Response::Status status = data.receive(stream, total, listener);
 
             // Get the response from the server
             response = getResponse();
-            if (response.isOk())
-            {
-                // Extract the filename from the file path
-                std::string filename = remoteFile;
-                std::string::size_type pos = filename.find_last_of("/\\");
-                if (pos != std::string::npos)
-                    filename = filename.substr(pos + 1);
-
-                // Make sure the destination path ends with a slash
-                std::string path = localPath;
-                if (!path.empty() && (path[path.size() - 1] != '\\') && (path[path.size() - 1] != '/'))
-                    path += "/";
-
-                // Create the file and copy the received data into it
-                std::ofstream file((path + filename).c_str(), std::ios_base::binary);
-                if (!file)
-                    return Response(Response::InvalidFile);
-
-                if (!fileData.empty())
-                    file.write(&fileData[0], static_cast<std::streamsize>(fileData.size()));
-            }
+            if (status != Response::Ok)
+                response = Response(status);
         }
     }
 
@@ -320,20 +489,13 @@ Ftp::Response Ftp::download(const std::string& remoteFile, const std::string& lo
 
 
 ////////////////////////////////////////////////////////////
-Ftp::Response Ftp::upload(const std::string& localFile, const std::string& remotePath, TransferMode mode)
+Ftp::Response Ftp::upload(const std::string& localFile, const std::string& remotePath, TransferMode mode, ProgressListener* listener)
 {
-    // Get the contents of the file to send
-    std::ifstream file(localFile.c_str(), std::ios_base::binary);
-    if (!file)
+    // Open the file to send
+    FileInputStream file;
+    if (!file.open(localFile))
         return Response(Response::InvalidFile);
 
-    file.seekg(0, std::ios::end);
-    std::size_t length = static_cast<std::size_t>(file.tellg());
-    file.seekg(0, std::ios::beg);
-    std::vector<char> fileData(length);
-    if (length > 0)
-        file.read(&fileData[0], static_cast<std::streamsize>(length));
-
     // Extract the filename from the file path
     std::string filename = localFile;
     std::string::size_type pos = filename.find_last_of("/\\");
@@ -345,20 +507,36 @@ Ftp::Response Ftp::upload(const std::string& localFile, const std::string& remot
     if (!path.empty() && (path[path.size() - 1] != '\\') && (path[path.size() - 1] != '/'))
         path += "/";
 
+    return upload(file, path + filename, mode, listener);
+}
+
+
+////////////////////////////////////////////////////////////
+Ftp::Response Ftp::upload(InputStream& stream, const std::string& remoteFile, TransferMode mode, ProgressListener* listener)
+{
+    // Get the number of bytes to send, to report the progress
+    Uint64 total = 0;
+    Int64 size = stream.getSize();
+    Int64 position = stream.tell();
+    if ((size >= 0) && (position >= 0) && (size > position))
+        total = static_cast<Uint64>(size - position);
+
     // Open a data channel using the given transfer mode
     DataChannel data(*this);
     Response response = data.open(mode);
     if (response.isOk())
     {
         // Tell the server to start the transfer
-        response = sendCommand("STOR", path + filename);
+        response = sendCommand("STOR", remoteFile);
         if (response.isOk())
         {
             // Send the file data
-            data.send(fileData);
+            Response::Status status = data.send(stream, total, listener);
 
             // Get the response from the server
             response = getResponse();
+            if (status != Response::Ok)
+                response = Response(status);
         }
     }
 
@@ -366,6 +544,13 @@ Ftp::Response Ftp::upload(const std::string& localFile, const std::string& remot
 }
 
 
+////////////////////////////////////////////////////////////
+void Ftp::setTransferBufferSize(std::size_t size)
+{
+    m_bufferSize = std::max(size, minBufferSize);
+}
+
+
 ////////////////////////////////////////////////////////////
 Ftp::Response Ftp::sendCommand(const std::string& command, const std::string& parameter)
 {
@@ -584,31 +769,89 @@ Ftp::Response Ftp::DataChannel::open(Ftp::TransferMode mode)
 
 
 ////////////////////////////////////////////////////////////
-void Ftp::DataChannel::receive(std::vector<char>& data)
+Ftp::Response::Status Ftp::DataChannel::receive(OutputStream& stream, Uint64 total, ProgressListener* listener)
 {
-    // Receive data
-    data.clear();
-    char buffer[1024];
-    std::size_t received;
-    while (m_dataSocket.receive(buffer, sizeof(buffer), received) == Socket::Done)
+    Ftp::Response::Status status = Ftp::Response::Ok;
+    std::vector<char> buffer(m_ftp.m_bufferSize);
+    Uint64 transferred = 0;
+
+    bool connected = true;
+    while (connected)
     {
-        std::copy(buffer, buffer + received, std::back_inserter(data));
+        // Fill the buffer, so that the stream receives big chunks
+        std::size_t size = 0;
+        while (size < buffer.size())
+        {
+            std::size_t received = 0;
+            if (m_dataSocket.receive(&buffer[size], buffer.size() - size, received) != Socket::Done)
+            {
+                connected = false;
+                break;
+            }
+            size += received;
+        }
+
+        if (size == 0)
+            break;
+
+        // Write it to the stream
+        if (stream.write(&buffer[0], size) != static_cast<Int64>(size))
+        {
+            status = Ftp::Response::InvalidFile;
+            break;
+        }
+
+        transferred += size;
+        if (listener && !listener->onProgress(transferred, total))
+        {
+            status = Ftp::Response::TransferAborted;
+            break;
+        }
     }
 
     // Close the data socket
     m_dataSocket.disconnect();
+
+    return status;
 }
 
 
 ////////////////////////////////////////////////////////////
-void Ftp::DataChannel::send(const std::vector<char>& data)
+Ftp::Response::Status Ftp::DataChannel::send(InputStream& stream, Uint64 total, ProgressListener* listener)
 {
-    // Send data
-    if (!data.empty())
-        m_dataSocket.send(&data[0], data.size());
+    Ftp::Response::Status status = Ftp::Response::Ok;
+    std::vector<char> buffer(m_ftp.m_bufferSize);
+    Uint64 transferred = 0;
+
+    for (;;)
+    {
+        // Read the next chunk from the stream
+        Int64 count = stream.read(&buffer[0], static_cast<Int64>(buffer.size()));
+        if (count < 0)
+        {
+            status = Ftp::Response::InvalidFile;
+            break;
+        }
+
+        if (count == 0)
+            break;
+
+        // Send it; if this fails, the response of the server will tell why
+        if (m_dataSocket.send(&buffer[0], static_cast<std::size_t>(count)) != Socket::Done)
+            break;
+
+        transferred += count;
+        if (listener && !listener->onProgress(transferred, total))
+        {
+            status = Ftp::Response::TransferAborted;
+            break;
+        }
+    }
 
     // Close the data socket
     m_dataSocket.disconnect();
+
+    return status;
 }
 
 } // namespace sf
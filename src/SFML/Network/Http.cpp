@@ -29,13 +29,41 @@
 #include <SFML/System/Err.hpp>
 #include <cctype>
 #include <algorithm>
-#include <iterator>
 #include <sstream>
 #include <limits>
 
 
 namespace
 {
+    // Number of bytes requested from the connection at once
+    const std::size_t receiveSize = 16384;
+
+    // Response handler which writes the body to a stream
+    class StreamHandler : public sf::Http::ResponseHandler
+    {
+    public :
+
+        StreamHandler(sf::OutputStream& stream) :
+        m_stream(stream)
+        {
+        }
+
+        virtual bool onHeader(const sf::Http::Response& response)
+        {
+            // Don't write error pages to the stream
+            return (response.getStatus() >= 200) && (response.getStatus() < 300);
+        }
+
+        virtual bool onBody(const char* data, std::size_t size)
+        {
+            return m_stream.write(data, size) == static_cast<sf::Int64>(size);
+        }
+
+    private :
+
+        sf::OutputStream& m_stream;
+    };
+
     // Convert a string to lower case
     std::string toLower(std::string str)
     {
@@ -240,36 +268,6 @@ void Http::Response::parse(const std::string& data)
     parseFields(in);
 
     m_body.clear();
-
-    // Determine whether the transfer is chunked
-    if (toLower(getField("transfer-encoding")) != "chunked")
-    {
-        // Not chunked - just read everything at once
-        std::copy(std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>(), std::back_inserter(m_body));
-    }
-    else
-    {
-        // Chunked - have to read chunk by chunk
-        std::size_t length;
-
-        // Read all chunks, identified by a chunk-size not being 0
-        while (in >> std::hex >> length)
-        {
-            // Drop the rest of the line (chunk-extension)
-            in.ignore(std::numeric_limits<std::streamsize>::max(), '\n');
-
-            // Copy the actual content data
-            std::istreambuf_iterator<char> it(in);
-            for (std::size_t i = 0; i < length; i++)
-                m_body.push_back(*it++);
-        }
-
-        // Drop the rest of the line (chunk-extension)
-        in.ignore(std::numeric_limits<std::streamsize>::max(), '\n');
-
-        // Read all trailers (if present)
-        parseFields(in);
-    }
 }
 
 
@@ -297,17 +295,38 @@ void Http::Response::parseFields(std::istream &in)
 }
 
 
+////////////////////////////////////////////////////////////
+Http::ResponseHandler::~ResponseHandler()
+{
+}
+
+
+////////////////////////////////////////////////////////////
+bool Http::ResponseHandler::onHeader(const Response&)
+{
+    return true;
+}
+
+
 ////////////////////////////////////////////////////////////
 Http::Http() :
-m_host(),
-m_port(0)
+m_host     (),
+m_port     (0),
+m_keepAlive(false),
+m_connected(false),
+m_buffer   (),
+m_position (0)
 {
 
 }
 
 
 ////////////////////////////////////////////////////////////
-Http::Http(const std::string& host, unsigned short port)
+Http::Http(const std::string& host, unsigned short port) :
+m_keepAlive(false),
+m_connected(false),
+m_buffer   (),
+m_position (0)
 {
     setHost(host, port);
 }
@@ -316,6 +335,9 @@ Http::Http(const std::string& host, unsigned short port)
 ////////////////////////////////////////////////////////////
 void Http::setHost(const std::string& host, unsigned short port)
 {
+    // The current connection, if any, is to the previous host
+    disconnect();
+
     // Check the protocol
     if (toLower(host.substr(0, 7)) == "http://")
     {
@@ -347,6 +369,114 @@ void Http::setHost(const std::string& host, unsigned short port)
 
 ////////////////////////////////////////////////////////////
 Http::Response Http::sendRequest(const Http::Request& request, Time timeout)
+{
+    std::vector<Request> requests(1, request);
+    std::vector<Response> responses;
+    send(requests, responses, timeout, NULL);
+
+    return responses[0];
+}
+
+
+////////////////////////////////////////////////////////////
+Http::Response Http::sendRequest(const Http::Request& request, ResponseHandler& handler, Time timeout)
+{
+    std::vector<Request> requests(1, request);
+    std::vector<Response> responses;
+    send(requests, responses, timeout, &handler);
+
+    return responses[0];
+}
+
+
+////////////////////////////////////////////////////////////
+Http::Response Http::sendRequest(const Http::Request& request, OutputStream& body, Time timeout)
+{
+    StreamHandler handler(body);
+    return sendRequest(request, handler, timeout);
+}
+
+
+////////////////////////////////////////////////////////////
+void Http::sendRequests(const std::vector<Request>& requests, std::vector<Response>& responses, Time timeout)
+{
+    send(requests, responses, timeout, NULL);
+}
+
+
+////////////////////////////////////////////////////////////
+void Http::send(const std::vector<Request>& requests, std::vector<Response>& responses, Time timeout, ResponseHandler* handler)
+{
+    responses.assign(requests.size(), Response());
+
+    std::size_t next = 0;
+    while (next < requests.size())
+    {
+        // Connect the socket to the host, unless the previous connection is still open
+        bool reused = m_connected;
+        if (!m_connected)
+        {
+            if (m_connection.connect(m_host, m_port, timeout) != Socket::Done)
+                return;
+            m_connected = true;
+        }
+
+        // On a persistent connection, pipeline the following requests as long as they are idempotent
+        std::size_t count = 1;
+        if (m_keepAlive)
+        {
+            while ((next + count < requests.size()) &&
+                   (requests[next + count - 1].m_method != Request::Post) &&
+                   (requests[next + count].m_method != Request::Post))
+                ++count;
+        }
+
+        // Convert the requests to string and send them through the connected socket
+        std::string requestStr;
+        for (std::size_t i = next; i < next + count; ++i)
+            requestStr += prepare(requests[i]);
+
+        bool sent = (m_connection.send(requestStr.c_str(), requestStr.size()) == Socket::Done);
+
+        // Wait for the server's responses
+        std::size_t first = next;
+        bool keepAlive = false;
+        for (std::size_t i = next; sent && (i < next + count); ++i)
+        {
+            if (!receiveResponse(responses[i], requests[i].m_method == Request::Head, keepAlive, handler))
+                break;
+
+            first = i + 1;
+            if (!keepAlive)
+                break;
+        }
+
+        // Close the connection if it can't be reused, or if some responses are missing
+        if ((first < next + count) || !keepAlive || !m_keepAlive)
+            disconnect();
+
+        // Nothing received on a new connection: the host doesn't answer, give up
+        if ((first == next) && !reused)
+            return;
+
+        // Continue with the requests that were not answered, on a new connection if needed
+        next = first;
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+void Http::setKeepAlive(bool enabled)
+{
+    m_keepAlive = enabled;
+
+    if (!m_keepAlive)
+        disconnect();
+}
+
+
+////////////////////////////////////////////////////////////
+std::string Http::prepare(const Request& request) const
 {
     // First make sure that the request is valid -- add missing mandatory fields
     Request toSend(request);
@@ -372,44 +502,218 @@ Http::Response Http::sendRequest(const Http::Request& request, Time timeout)
     {
         toSend.setField("Content-Type", "application/x-www-form-urlencoded");
     }
-    if ((toSend.m_majorVersion * 10 + toSend.m_minorVersion >= 11) && !toSend.hasField("Connection"))
+    if (!toSend.hasField("Connection"))
+    {
+        if (m_keepAlive)
+            toSend.setField("Connection", "keep-alive");
+        else if (toSend.m_majorVersion * 10 + toSend.m_minorVersion >= 11)
+            toSend.setField("Connection", "close");
+    }
+
+    return toSend.prepare();
+}
+
+
+////////////////////////////////////////////////////////////
+bool Http::receiveResponse(Response& response, bool isHead, bool& keepAlive, ResponseHandler* handler)
+{
+    keepAlive = false;
+
+    // Read the header, skipping the informational (1xx) responses
+    do
     {
-        toSend.setField("Connection", "close");
+        response.m_fields.clear();
+
+        std::string header;
+        std::string line;
+        do
+        {
+            if (!receiveLine(line))
+                return false;
+            header += line;
+            header += "\n";
+        }
+        while (!line.empty() || (header.size() == 1));
+
+        response.parse(header);
+        if (response.m_status == Response::InvalidResponse)
+            return true;
     }
+    while (response.m_status / 100 == 1);
 
-    // Prepare the response
-    Response received;
+    // Check whether the server will keep the connection open
+    std::string connection = toLower(response.getField("connection"));
+    if (response.m_majorVersion * 10 + response.m_minorVersion >= 11)
+        keepAlive = (connection != "close");
+    else
+        keepAlive = (connection == "keep-alive");
 
-    // Connect the socket to the host
-    if (m_connection.connect(m_host, m_port, timeout) == Socket::Done)
+    // Let the handler see the header, and possibly refuse the body
+    if (handler && !handler->onHeader(response))
     {
-        // Convert the request to string and send it through the connected socket
-        std::string requestStr = toSend.prepare();
+        keepAlive = false;
+        return true;
+    }
+
+    // Responses to HEAD requests, 204 and 304 responses have no body
+    if (isHead || (response.m_status == Response::NoContent) || (response.m_status == Response::NotModified))
+        return true;
 
-        if (!requestStr.empty())
+    bool complete = true;
+    if (toLower(response.getField("transfer-encoding")) == "chunked")
+    {
+        // Chunked - have to read chunk by chunk, until a chunk-size of 0
+        std::string line;
+        while (complete)
         {
-            // Send it through the socket
-            if (m_connection.send(requestStr.c_str(), requestStr.size()) == Socket::Done)
+            // Read the chunk-size, ignoring the chunk-extension
+            if (!receiveLine(line))
             {
-                // Wait for the server's response
-                std::string receivedStr;
-                std::size_t size = 0;
-                char buffer[1024];
-                while (m_connection.receive(buffer, sizeof(buffer), size) == Socket::Done)
-                {
-                    receivedStr.append(buffer, buffer + size);
-                }
-
-                // Build the Response object from the received data
-                received.parse(receivedStr);
+                complete = false;
+                break;
             }
+
+            std::size_t length = 0;
+            std::istringstream in(line);
+            if (!(in >> std::hex >> length))
+            {
+                complete = false;
+                break;
+            }
+
+            if (length == 0)
+                break;
+
+            // Read the chunk data, followed by an empty line
+            complete = receiveBody(length, false, response, handler) && receiveLine(line);
         }
 
-        // Close the connection
+        // Read all trailers (if present)
+        if (complete)
+        {
+            std::string trailers;
+            while (receiveLine(line) && !line.empty())
+            {
+                trailers += line;
+                trailers += "\n";
+            }
+            std::istringstream in(trailers);
+            response.parseFields(in);
+        }
+    }
+    else if (response.m_fields.find("content-length") != response.m_fields.end())
+    {
+        // The length of the body is known
+        std::size_t length = 0;
+        std::istringstream in(response.getField("content-length"));
+        complete = (in >> length) && receiveBody(length, false, response, handler);
+    }
+    else
+    {
+        // The body ends when the server closes the connection
+        keepAlive = false;
+        complete = receiveBody(0, true, response, handler);
+    }
+
+    // A truncated or aborted body must not be mistaken for a complete one
+    if (!complete)
+    {
+        keepAlive = false;
+        response.m_status = Response::ConnectionFailed;
+    }
+
+    return true;
+}
+
+
+////////////////////////////////////////////////////////////
+bool Http::receiveLine(std::string& line)
+{
+    for (;;)
+    {
+        std::vector<char>::iterator begin = m_buffer.begin() + m_position;
+        std::vector<char>::iterator end = std::find(begin, m_buffer.end(), '\n');
+        if (end != m_buffer.end())
+        {
+            line.assign(begin, end);
+            m_position = (end - m_buffer.begin()) + 1;
+
+            // Remove the trailing \r
+            if (!line.empty() && (*line.rbegin() == '\r'))
+                line.erase(line.size() - 1);
+
+            return true;
+        }
+
+        if (!receiveMore())
+            return false;
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+bool Http::receiveBody(std::size_t size, bool untilClosed, Response& response, ResponseHandler* handler)
+{
+    while (untilClosed || (size > 0))
+    {
+        if ((m_position == m_buffer.size()) && !receiveMore())
+            return untilClosed;
+
+        // Pass the received bytes directly from the buffer
+        std::size_t count = m_buffer.size() - m_position;
+        if (!untilClosed)
+            count = std::min(size, count);
+
+        if (handler)
+        {
+            if (!handler->onBody(&m_buffer[m_position], count))
+                return false;
+        }
+        else
+        {
+            response.m_body.append(&m_buffer[m_position], count);
+        }
+
+        m_position += count;
+        size -= count;
+    }
+
+    return true;
+}
+
+
+////////////////////////////////////////////////////////////
+bool Http::receiveMore()
+{
+    // Drop the data that was already read
+    if (m_position > 0)
+    {
+        m_buffer.erase(m_buffer.begin(), m_buffer.begin() + m_position);
+        m_position = 0;
+    }
+
+    std::size_t size = m_buffer.size();
+    m_buffer.resize(size + receiveSize);
+
+    std::size_t received = 0;
+    Socket::Status status = m_connection.receive(&m_buffer[size], receiveSize, received);
+    m_buffer.resize(size + received);
+
+    return (status == Socket::Done) && (received > 0);
+}
+
+
+////////////////////////////////////////////////////////////
+void Http::disconnect()
+{
+    if (m_connected)
+    {
         m_connection.disconnect();
+        m_connected = false;
     }
 
-    return received;
+    m_buffer.clear();
+    m_position = 0;
 }
 
 } // namespace sf
@@ -27,45 +27,16 @@
 ////////////////////////////////////////////////////////////
 #include <SFML/Network/IpAddress.hpp>
 #include <SFML/Network/Http.hpp>
+#include <SFML/Network/Resolver.hpp>
 #include <SFML/Network/SocketImpl.hpp>
-#include <cstring>
 
 
 namespace
 {
     sf::Uint32 resolve(const std::string& address)
     {
-        if (address == "255.255.255.255")
-        {
-            // The broadcast address needs to be handled explicitely,
-            // because it is also the value returned by inet_addr on error
-            return INADDR_BROADCAST;
-        }
-        else
-        {
-            // Try to convert the address as a byte representation ("xxx.xxx.xxx.xxx")
-            sf::Uint32 ip = inet_addr(address.c_str());
-            if (ip != INADDR_NONE)
-                return ip;
-
-            // Not a valid address, try to convert it as a host name
-            addrinfo hints;
-            std::memset(&hints, 0, sizeof(hints));
-            hints.ai_family = AF_INET;
-            addrinfo* result = NULL;
-            if (getaddrinfo(address.c_str(), NULL, &hints, &result) == 0)
-            {
-                if (result)
-                {
-                    ip = reinterpret_cast<sockaddr_in*>(result->ai_addr)->sin_addr.s_addr;
-                    freeaddrinfo(result);
-                    return ip;
-                }
-            }
-
-            // Not a valid address nor a host name
-            return 0;
-        }
+        // Host names go through the cache of the resolver
+        return htonl(sf::Resolver::resolve(address).toInteger());
     }
 }
 
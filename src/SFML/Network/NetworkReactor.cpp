@@ -0,0 +1,740 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2014 Laurent Gomila (laurent.gom@gmail.com)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Network/NetworkReactor.hpp>
+#include <SFML/Network/IpAddress.hpp>
+#include <SFML/Network/Packet.hpp>
+#include <SFML/Network/SocketSelector.hpp>
+#include <SFML/Network/TcpListener.hpp>
+#include <SFML/Network/TcpSocket.hpp>
+#include <SFML/Network/UdpSocket.hpp>
+#include <SFML/System/Lock.hpp>
+#include <SFML/System/Sleep.hpp>
+#include <SFML/System/Thread.hpp>
+#include <SFML/System/ThreadLocalPtr.hpp>
+
+
+namespace
+{
+    // Maximum time a thread of the reactor waits before it checks the
+    // operations requested by other threads (new sockets, queued data);
+    // the threads are woken up as soon as an operation is requested, so
+    // this only matters if the wake-up socket can't be used
+    const sf::Time threadWaitTimeout = sf::milliseconds(100);
+
+    // Maximum number of packets or connections handled per socket and wake-up,
+    // so that a busy socket doesn't starve the others
+    const int maxBatch = 64;
+
+    // Shard run by the current thread, if any
+    sf::ThreadLocalPtr<sf::priv::ReactorShard> currentShard(NULL);
+}
+
+
+namespace sf
+{
+namespace priv
+{
+////////////////////////////////////////////////////////////
+/// \brief Share of the sockets of a reactor, run by one thread
+///
+////////////////////////////////////////////////////////////
+class ReactorShard
+{
+public :
+
+    struct Registration
+    {
+        NetworkReactor::SocketKind kind;         ///< Kind of the socket
+        bool                       owned;        ///< Was the socket created by the reactor?
+        bool                       watchingSend; ///< Is the socket watched for write readiness?
+    };
+
+    struct Operation
+    {
+        enum Type
+        {
+            Add,       ///< Start watching a socket
+            WatchSend, ///< Watch a socket for write readiness
+            Close,     ///< Disconnect a TCP socket
+            Remove     ///< Stop watching a socket
+        };
+
+        Type         type;         ///< Type of the operation
+        Socket*      socket;       ///< Socket concerned by the operation
+        Registration registration; ///< Registration of the socket (Add only)
+    };
+
+    typedef std::map<Socket*, Registration> RegistrationTable;
+
+    explicit ReactorShard(NetworkReactor& owner) :
+    reactor      (owner),
+    wakeUpPending(false),
+    thread       (NULL),
+    running      (false),
+    load         (0)
+    {
+        // Datagrams sent to this socket interrupt the wait of the selector
+        wakeUpSocket.setBlocking(false);
+        if (wakeUpSocket.bind(Socket::AnyPort) == Socket::Done)
+            selector.add(wakeUpSocket);
+    }
+
+    ~ReactorShard()
+    {
+        // Destroy the sockets created by the reactor, including the ones not added yet
+        for (RegistrationTable::iterator it = registrations.begin(); it != registrations.end(); ++it)
+        {
+            if (it->second.owned)
+                delete static_cast<TcpSocket*>(it->first);
+        }
+        for (std::vector<Operation>::iterator it = pending.begin(); it != pending.end(); ++it)
+        {
+            if ((it->type == Operation::Add) && it->registration.owned)
+                delete static_cast<TcpSocket*>(it->socket);
+        }
+    }
+
+    ////////////////////////////////////////////////////////////
+    static void run(ReactorShard* shard)
+    {
+        for (;;)
+        {
+            {
+                Lock lock(shard->mutex);
+                if (!shard->running)
+                    break;
+            }
+
+            shard->process(threadWaitTimeout);
+        }
+    }
+
+    ////////////////////////////////////////////////////////////
+    bool process(Time timeout)
+    {
+        // Mark the calling thread as the one that runs the shard while it dispatches
+        currentShard = this;
+        bool dispatched = dispatch(timeout);
+        currentShard = NULL;
+
+        return dispatched;
+    }
+
+    ////////////////////////////////////////////////////////////
+    bool dispatch(Time timeout)
+    {
+        {
+            Lock lock(mutex);
+            applyPending();
+
+            // Some systems fail right away when waiting without sockets
+            if (registrations.empty() && (wakeUpSocket.getLocalPort() == 0))
+            {
+                if (timeout != Time::Zero)
+                    sleep(timeout);
+                return false;
+            }
+        }
+
+        // Wait without holding the mutex, so that other threads can send meanwhile
+        if (!selector.wait(timeout))
+            return false;
+
+        Lock lock(mutex);
+
+        // Drain the wake-up datagrams, the pending operations are applied below
+        if (selector.isReady(wakeUpSocket))
+        {
+            char buffer[16];
+            std::size_t received;
+            IpAddress sender;
+            unsigned short port;
+            while (wakeUpSocket.receive(buffer, sizeof(buffer), received, sender, port) == Socket::Done)
+            {
+            }
+        }
+
+        // The callbacks may change the list of the selector, so iterate a copy;
+        // sockets removed meanwhile are no longer in the registration table
+        ready = selector.getReadySockets();
+        for (std::vector<Socket*>::const_iterator it = ready.begin(); it != ready.end(); ++it)
+        {
+            RegistrationTable::const_iterator registration = registrations.find(*it);
+            if (registration == registrations.end())
+                continue;
+
+            switch (registration->second.kind)
+            {
+                case NetworkReactor::Listener :
+                    accept(static_cast<TcpListener&>(**it));
+                    break;
+
+                case NetworkReactor::Datagram :
+                    receive(static_cast<UdpSocket&>(**it));
+                    break;
+
+                case NetworkReactor::Connection :
+                {
+                    TcpSocket& socket = static_cast<TcpSocket&>(**it);
+                    if (selector.isReadyToSend(socket) && !write(socket))
+                        break;
+                    if (selector.isReady(socket))
+                        receive(socket);
+                    break;
+                }
+            }
+        }
+
+        // Start watching the connections accepted for this shard
+        applyPending();
+
+        return true;
+    }
+
+    ////////////////////////////////////////////////////////////
+    void execute(const Operation& operation)
+    {
+        Lock lock(mutex);
+
+        // The selector can only be changed by the thread that waits on it:
+        // apply the operation now if we are that thread, post it otherwise
+        if (!thread || (currentShard == this))
+            apply(operation);
+        else
+            post(operation);
+    }
+
+    ////////////////////////////////////////////////////////////
+    void post(const Operation& operation)
+    {
+        Lock lock(pendingMutex);
+        pending.push_back(operation);
+        wakeUp();
+    }
+
+    ////////////////////////////////////////////////////////////
+    void wakeUp()
+    {
+        Lock lock(pendingMutex);
+
+        // One datagram is enough until the thread wakes up
+        if (!wakeUpPending && (wakeUpSocket.getLocalPort() != 0))
+        {
+            char signal = 0;
+            wakeUpSocket.send(&signal, sizeof(signal), IpAddress::LocalHost, wakeUpSocket.getLocalPort());
+            wakeUpPending = true;
+        }
+    }
+
+    ////////////////////////////////////////////////////////////
+    void applyPending()
+    {
+        {
+            Lock lock(pendingMutex);
+            applying.swap(pending);
+            wakeUpPending = false;
+        }
+
+        for (std::vector<Operation>::const_iterator it = applying.begin(); it != applying.end(); ++it)
+            apply(*it);
+        applying.clear();
+    }
+
+    ////////////////////////////////////////////////////////////
+    void apply(const Operation& operation)
+    {
+        if (operation.type == Operation::Add)
+        {
+            registrations[operation.socket] = operation.registration;
+            selector.add(*operation.socket);
+
+            if (operation.registration.kind == NetworkReactor::Connection)
+            {
+                TcpSocket& socket = static_cast<TcpSocket&>(*operation.socket);
+
+                // The connection may have been closed before it was added
+                if (socket.getLocalPort() == 0)
+                {
+                    close(socket);
+                    return;
+                }
+
+                // Data may have been queued before it was added
+                if (socket.getQueuedBytes() > 0)
+                    watchSend(socket);
+            }
+
+            return;
+        }
+
+        RegistrationTable::iterator it = registrations.find(operation.socket);
+        if (it == registrations.end())
+            return;
+
+        switch (operation.type)
+        {
+            case Operation::WatchSend :
+                watchSend(static_cast<TcpSocket&>(*operation.socket));
+                break;
+
+            case Operation::Close :
+                close(static_cast<TcpSocket&>(*operation.socket));
+                break;
+
+            case Operation::Remove :
+                // The sockets created by the reactor are handed over to the caller of remove
+                registrations.erase(it);
+                selector.remove(*operation.socket);
+                reactor.forgetSocket(*operation.socket);
+                break;
+
+            default :
+                break;
+        }
+    }
+
+    ////////////////////////////////////////////////////////////
+    void watchSend(TcpSocket& socket)
+    {
+        Registration& registration = registrations[&socket];
+        if (!registration.watchingSend && (socket.getQueuedBytes() > 0))
+        {
+            selector.add(socket, SocketSelector::LevelTriggered, SocketSelector::Receive | SocketSelector::Send);
+            registration.watchingSend = true;
+        }
+    }
+
+    ////////////////////////////////////////////////////////////
+    void close(TcpSocket& socket)
+    {
+        bool owned = registrations[&socket].owned;
+        registrations.erase(&socket);
+        selector.remove(socket);
+        reactor.forgetSocket(socket);
+
+        mutex.unlock();
+        reactor.m_handler.onDisconnect(socket);
+        mutex.lock();
+
+        // Disconnecting writes what remains queued, if the socket can take it
+        socket.disconnect();
+        if (owned)
+            delete &socket;
+    }
+
+    ////////////////////////////////////////////////////////////
+    void accept(TcpListener& listener)
+    {
+        for (int i = 0; i < maxBatch; ++i)
+        {
+            TcpSocket* socket = new TcpSocket;
+            socket->setBlocking(false);
+            if (listener.accept(*socket) != Socket::Done)
+            {
+                delete socket;
+                break;
+            }
+
+            mutex.unlock();
+            reactor.m_handler.onAccept(listener, *socket);
+            mutex.lock();
+            reactor.addSocket(*socket, NetworkReactor::Connection, true, this);
+
+            if (!registrations.count(&listener))
+                break;
+        }
+    }
+
+    ////////////////////////////////////////////////////////////
+    bool write(TcpSocket& socket)
+    {
+        Socket::Status status = socket.flush();
+        if (status == Socket::Done)
+        {
+            // Everything was written: stop watching for write readiness
+            selector.add(socket);
+            registrations[&socket].watchingSend = false;
+            mutex.unlock();
+            reactor.m_handler.onWritable(socket);
+            mutex.lock();
+            return registrations.count(&socket) != 0;
+        }
+        else if (status != Socket::NotReady)
+        {
+            close(socket);
+            return false;
+        }
+
+        return true;
+    }
+
+    ////////////////////////////////////////////////////////////
+    void receive(TcpSocket& socket)
+    {
+        for (int i = 0; i < maxBatch; ++i)
+        {
+            Socket::Status status = socket.receive(packet);
+            if (status == Socket::NotReady)
+                return;
+
+            if (status != Socket::Done)
+            {
+                close(socket);
+                return;
+            }
+
+            mutex.unlock();
+            reactor.m_handler.onPacket(socket, packet);
+            mutex.lock();
+
+            // The callback may have closed or removed the socket
+            if (!registrations.count(&socket))
+                return;
+        }
+    }
+
+    ////////////////////////////////////////////////////////////
+    void receive(UdpSocket& socket)
+    {
+        IpAddress sender;
+        unsigned short port;
+        for (int i = 0; i < maxBatch; ++i)
+        {
+            if (socket.receive(packet, sender, port) != Socket::Done)
+                return;
+
+            mutex.unlock();
+            reactor.m_handler.onPacket(socket, packet, sender, port);
+            mutex.lock();
+
+            // The callback may have removed the socket
+            if (!registrations.count(&socket))
+                return;
+        }
+    }
+
+    ////////////////////////////////////////////////////////////
+    // Member data
+    ////////////////////////////////////////////////////////////
+    NetworkReactor&        reactor;       ///< Reactor that owns the shard
+    UdpSocket              wakeUpSocket;  ///< Socket that receives the wake-up signals of other threads
+    SocketSelector         selector;      ///< Selector waiting for the sockets of the shard
+    RegistrationTable      registrations; ///< Sockets run by the shard
+    std::vector<Operation> pending;       ///< Operations requested by other threads
+    std::vector<Operation> applying;      ///< Operations being applied
+    std::vector<Socket*>   ready;         ///< Copy of the sockets found ready by the last wait
+    Packet                 packet;        ///< Packet receiving the data of the sockets
+    Mutex                  mutex;         ///< Mutex protecting the sockets, released during the wait and the callbacks
+    Mutex                  pendingMutex;  ///< Mutex protecting the pending operations
+    bool                   wakeUpPending; ///< Was a wake-up signal sent since the pending operations were applied?
+    Thread*                thread;        ///< Thread running the shard, if any
+    bool                   running;       ///< Must the thread keep running?
+    std::size_t            load;          ///< Number of sockets assigned to the shard
+};
+
+} // namespace priv
+
+
+////////////////////////////////////////////////////////////
+NetworkReactor::Handler::~Handler()
+{
+}
+
+
+////////////////////////////////////////////////////////////
+void NetworkReactor::Handler::onAccept(TcpListener&, TcpSocket&)
+{
+}
+
+
+////////////////////////////////////////////////////////////
+void NetworkReactor::Handler::onPacket(TcpSocket&, Packet&)
+{
+}
+
+
+////////////////////////////////////////////////////////////
+void NetworkReactor::Handler::onPacket(UdpSocket&, Packet&, const IpAddress&, unsigned short)
+{
+}
+
+
+////////////////////////////////////////////////////////////
+void NetworkReactor::Handler::onDisconnect(TcpSocket&)
+{
+}
+
+
+////////////////////////////////////////////////////////////
+void NetworkReactor::Handler::onWritable(TcpSocket&)
+{
+}
+
+
+////////////////////////////////////////////////////////////
+NetworkReactor::NetworkReactor(Handler& handler) :
+m_handler(handler),
+m_running(false)
+{
+    m_shards.push_back(new priv::ReactorShard(*this));
+}
+
+
+////////////////////////////////////////////////////////////
+NetworkReactor::~NetworkReactor()
+{
+    stop();
+
+    for (std::vector<priv::ReactorShard*>::iterator it = m_shards.begin(); it != m_shards.end(); ++it)
+        delete *it;
+}
+
+
+////////////////////////////////////////////////////////////
+void NetworkReactor::add(TcpListener& listener)
+{
+    listener.setBlocking(false);
+    addSocket(listener, Listener, false, NULL);
+}
+
+
+////////////////////////////////////////////////////////////
+void NetworkReactor::add(TcpSocket& socket)
+{
+    socket.setBlocking(false);
+    addSocket(socket, Connection, false, NULL);
+}
+
+
+////////////////////////////////////////////////////////////
+void NetworkReactor::add(UdpSocket& socket)
+{
+    socket.setBlocking(false);
+    addSocket(socket, Datagram, false, NULL);
+}
+
+
+////////////////////////////////////////////////////////////
+void NetworkReactor::remove(Socket& socket)
+{
+    priv::ReactorShard* shard = findShard(socket);
+    if (!shard)
+        return;
+
+    priv::ReactorShard::Operation operation = {priv::ReactorShard::Operation::Remove, &socket, priv::ReactorShard::Registration()};
+    shard->execute(operation);
+
+    // If the operation was posted to the thread of the shard, wait until it's applied
+    while (findShard(socket) == shard)
+        sleep(milliseconds(1));
+}
+
+
+////////////////////////////////////////////////////////////
+Socket::Status NetworkReactor::send(TcpSocket& socket, Packet& packet)
+{
+    priv::ReactorShard* shard = findShard(socket);
+    if (!shard)
+        return socket.send(packet);
+
+    Lock lock(shard->mutex);
+
+    // The connection may have been closed by the shard meanwhile
+    if (!shard->registrations.count(&socket))
+        return Socket::Disconnected;
+
+    // Have the shard write what can't be sent now
+    Socket::Status status = socket.send(packet);
+    if ((status == Socket::Done) && (socket.getQueuedBytes() > 0) && !shard->registrations[&socket].watchingSend)
+    {
+        priv::ReactorShard::Operation operation = {priv::ReactorShard::Operation::WatchSend, &socket, priv::ReactorShard::Registration()};
+        shard->execute(operation);
+    }
+
+    return status;
+}
+
+
+////////////////////////////////////////////////////////////
+void NetworkReactor::disconnect(TcpSocket& socket)
+{
+    priv::ReactorShard* shard = findShard(socket);
+    if (!shard)
+    {
+        socket.disconnect();
+        return;
+    }
+
+    priv::ReactorShard::Operation operation = {priv::ReactorShard::Operation::Close, &socket, priv::ReactorShard::Registration()};
+    shard->execute(operation);
+}
+
+
+////////////////////////////////////////////////////////////
+bool NetworkReactor::update(Time timeout)
+{
+    std::vector<priv::ReactorShard*> shards;
+    {
+        Lock lock(m_mutex);
+        if (m_running)
+            return false;
+        shards = m_shards;
+    }
+
+    // Only the first shard waits, the others (left by a previous launch) are just polled
+    bool dispatched = false;
+    for (std::size_t i = 0; i < shards.size(); ++i)
+    {
+        if (shards[i]->process(i == 0 ? timeout : microseconds(1)))
+            dispatched = true;
+    }
+
+    return dispatched;
+}
+
+
+////////////////////////////////////////////////////////////
+void NetworkReactor::launch(unsigned int threadCount)
+{
+    Lock lock(m_mutex);
+
+    if (m_running)
+        return;
+
+    while (m_shards.size() < threadCount)
+        m_shards.push_back(new priv::ReactorShard(*this));
+
+    for (std::vector<priv::ReactorShard*>::iterator it = m_shards.begin(); it != m_shards.end(); ++it)
+    {
+        priv::ReactorShard& shard = **it;
+        Lock shardLock(shard.mutex);
+        shard.running = true;
+        shard.thread = new Thread(&priv::ReactorShard::run, &shard);
+        shard.thread->launch();
+    }
+
+    m_running = true;
+}
+
+
+////////////////////////////////////////////////////////////
+void NetworkReactor::stop()
+{
+    std::vector<priv::ReactorShard*> shards;
+    {
+        Lock lock(m_mutex);
+        if (!m_running)
+            return;
+        m_running = false;
+        shards = m_shards;
+    }
+
+    // The threads need the mutex of the reactor to finish, so don't hold it while waiting for them
+    for (std::vector<priv::ReactorShard*>::iterator it = shards.begin(); it != shards.end(); ++it)
+    {
+        priv::ReactorShard& shard = **it;
+        {
+            Lock lock(shard.mutex);
+            shard.running = false;
+        }
+
+        shard.wakeUp();
+        shard.thread->wait();
+
+        Lock lock(shard.mutex);
+        delete shard.thread;
+        shard.thread = NULL;
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+void NetworkReactor::addSocket(Socket& socket, SocketKind kind, bool owned, priv::ReactorShard* current)
+{
+    priv::ReactorShard* shard;
+    {
+        Lock lock(m_mutex);
+        shard = m_shards.front();
+
+        // Already watched: nothing to do
+        if (m_owners.count(&socket))
+            return;
+
+        // Spread the connections across the shards
+        if (kind == Connection)
+        {
+            for (std::vector<priv::ReactorShard*>::const_iterator it = m_shards.begin(); it != m_shards.end(); ++it)
+            {
+                if ((*it)->load < shard->load)
+                    shard = *it;
+            }
+        }
+
+        m_owners[&socket] = shard;
+        shard->load++;
+    }
+
+    priv::ReactorShard::Registration registration = {kind, owned, false};
+    priv::ReactorShard::Operation operation = {priv::ReactorShard::Operation::Add, &socket, registration};
+
+    // A shard adding a socket to another shard must not lock it while holding
+    // its own mutex: post the operation to the thread of the other shard
+    if (shard == current)
+        shard->apply(operation);
+    else if (current)
+        shard->post(operation);
+    else
+        shard->execute(operation);
+}
+
+
+////////////////////////////////////////////////////////////
+void NetworkReactor::forgetSocket(Socket& socket)
+{
+    Lock lock(m_mutex);
+
+    std::map<Socket*, priv::ReactorShard*>::iterator it = m_owners.find(&socket);
+    if (it != m_owners.end())
+    {
+        it->second->load--;
+        m_owners.erase(it);
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+priv::ReactorShard* NetworkReactor::findShard(Socket& socket) const
+{
+    Lock lock(m_mutex);
+
+    std::map<Socket*, priv::ReactorShard*>::const_iterator it = m_owners.find(&socket);
+    return it != m_owners.end() ? it->second : NULL;
+}
+
+} // namespace sf
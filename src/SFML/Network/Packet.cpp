@@ -32,12 +32,28 @@
 #include <cwchar>
 
 
+namespace
+{
+    // Conversions between host and network byte orders, overloaded
+    // so that the bulk serializers can be written once for all types
+    sf::Int16  toNetwork(sf::Int16 value)    {return htons(value);}
+    sf::Uint16 toNetwork(sf::Uint16 value)   {return htons(value);}
+    sf::Int32  toNetwork(sf::Int32 value)    {return htonl(value);}
+    sf::Uint32 toNetwork(sf::Uint32 value)   {return htonl(value);}
+    sf::Int16  fromNetwork(sf::Int16 value)  {return ntohs(value);}
+    sf::Uint16 fromNetwork(sf::Uint16 value) {return ntohs(value);}
+    sf::Int32  fromNetwork(sf::Int32 value)  {return ntohl(value);}
+    sf::Uint32 fromNetwork(sf::Uint32 value) {return ntohl(value);}
+}
+
+
 namespace sf
 {
 ////////////////////////////////////////////////////////////
 Packet::Packet() :
-m_readPos(0),
-m_isValid(true)
+m_readPos      (0),
+m_isValid      (true),
+m_receiveBuffer(NULL)
 {
 
 }
@@ -62,6 +78,13 @@ void Packet::append(const void* data, std::size_t sizeInBytes)
 }
 
 
+////////////////////////////////////////////////////////////
+void Packet::reserve(std::size_t sizeInBytes)
+{
+    m_data.reserve(sizeInBytes);
+}
+
+
 ////////////////////////////////////////////////////////////
 void Packet::clear()
 {
@@ -263,16 +286,20 @@ Packet& Packet::operator >>(wchar_t* data)
     Uint32 length = 0;
     *this >> length;
 
-    if ((length > 0) && checkSize(length * sizeof(Uint32)))
+    if ((length > 0) && checkCount(length, sizeof(Uint32)))
     {
         // Then extract characters
+        const char* begin = &m_data[m_readPos];
         for (Uint32 i = 0; i < length; ++i)
         {
-            Uint32 character = 0;
-            *this >> character;
-            data[i] = static_cast<wchar_t>(character);
+            Uint32 character;
+            std::memcpy(&character, begin + i * sizeof(Uint32), sizeof(Uint32));
+            data[i] = static_cast<wchar_t>(ntohl(character));
         }
         data[length] = L'\0';
+
+        // Update reading position
+        m_readPos += length * sizeof(Uint32);
     }
 
     return *this;
@@ -287,15 +314,20 @@ Packet& Packet::operator >>(std::wstring& data)
     *this >> length;
 
     data.clear();
-    if ((length > 0) && checkSize(length * sizeof(Uint32)))
+    if ((length > 0) && checkCount(length, sizeof(Uint32)))
     {
         // Then extract characters
+        data.resize(length);
+        const char* begin = &m_data[m_readPos];
         for (Uint32 i = 0; i < length; ++i)
         {
-            Uint32 character = 0;
-            *this >> character;
-            data += static_cast<wchar_t>(character);
+            Uint32 character;
+            std::memcpy(&character, begin + i * sizeof(Uint32), sizeof(Uint32));
+            data[i] = static_cast<wchar_t>(ntohl(character));
         }
+
+        // Update reading position
+        m_readPos += length * sizeof(Uint32);
     }
 
     return *this;
@@ -310,15 +342,12 @@ Packet& Packet::operator >>(String& data)
     *this >> length;
 
     data.clear();
-    if ((length > 0) && checkSize(length * sizeof(Uint32)))
+    if ((length > 0) && checkCount(length, sizeof(Uint32)))
     {
         // Then extract characters
-        for (Uint32 i = 0; i < length; ++i)
-        {
-            Uint32 character = 0;
-            *this >> character;
-            data += character;
-        }
+        std::basic_string<Uint32> characters(length, 0);
+        readSwapped(&characters[0], length);
+        data = characters;
     }
 
     return *this;
@@ -438,8 +467,12 @@ Packet& Packet::operator <<(const wchar_t* data)
     *this << length;
 
     // Then insert characters
-    for (const wchar_t* c = data; *c != L'\0'; ++c)
-        *this << static_cast<Uint32>(*c);
+    char* begin = grow(length * sizeof(Uint32));
+    for (Uint32 i = 0; i < length; ++i)
+    {
+        Uint32 character = htonl(static_cast<Uint32>(data[i]));
+        std::memcpy(begin + i * sizeof(Uint32), &character, sizeof(Uint32));
+    }
 
     return *this;
 }
@@ -455,8 +488,12 @@ Packet& Packet::operator <<(const std::wstring& data)
     // Then insert characters
     if (length > 0)
     {
-        for (std::wstring::const_iterator c = data.begin(); c != data.end(); ++c)
-            *this << static_cast<Uint32>(*c);
+        char* begin = grow(length * sizeof(Uint32));
+        for (Uint32 i = 0; i < length; ++i)
+        {
+            Uint32 character = htonl(static_cast<Uint32>(data[i]));
+            std::memcpy(begin + i * sizeof(Uint32), &character, sizeof(Uint32));
+        }
     }
 
     return *this;
@@ -472,9 +509,162 @@ Packet& Packet::operator <<(const String& data)
 
     // Then insert characters
     if (length > 0)
+        writeSwapped(data.getData(), length);
+
+    return *this;
+}
+
+
+////////////////////////////////////////////////////////////
+Packet& Packet::writeArray(const Int8* data, std::size_t count)
+{
+    append(data, count * sizeof(Int8));
+    return *this;
+}
+
+
+////////////////////////////////////////////////////////////
+Packet& Packet::writeArray(const Uint8* data, std::size_t count)
+{
+    append(data, count * sizeof(Uint8));
+    return *this;
+}
+
+
+////////////////////////////////////////////////////////////
+Packet& Packet::writeArray(const Int16* data, std::size_t count)
+{
+    writeSwapped(data, count);
+    return *this;
+}
+
+
+////////////////////////////////////////////////////////////
+Packet& Packet::writeArray(const Uint16* data, std::size_t count)
+{
+    writeSwapped(data, count);
+    return *this;
+}
+
+
+////////////////////////////////////////////////////////////
+Packet& Packet::writeArray(const Int32* data, std::size_t count)
+{
+    writeSwapped(data, count);
+    return *this;
+}
+
+
+////////////////////////////////////////////////////////////
+Packet& Packet::writeArray(const Uint32* data, std::size_t count)
+{
+    writeSwapped(data, count);
+    return *this;
+}
+
+
+////////////////////////////////////////////////////////////
+Packet& Packet::writeArray(const float* data, std::size_t count)
+{
+    append(data, count * sizeof(float));
+    return *this;
+}
+
+
+////////////////////////////////////////////////////////////
+Packet& Packet::writeArray(const double* data, std::size_t count)
+{
+    append(data, count * sizeof(double));
+    return *this;
+}
+
+
+////////////////////////////////////////////////////////////
+Packet& Packet::readArray(Int8* data, std::size_t count)
+{
+    if (checkCount(count, sizeof(Int8)) && (count > 0))
     {
-        for (String::ConstIterator c = data.begin(); c != data.end(); ++c)
-            *this << *c;
+        std::memcpy(data, &m_data[m_readPos], count * sizeof(Int8));
+        m_readPos += count * sizeof(Int8);
+    }
+
+    return *this;
+}
+
+
+////////////////////////////////////////////////////////////
+Packet& Packet::readArray(Uint8* data, std::size_t count)
+{
+    if (checkCount(count, sizeof(Uint8)) && (count > 0))
+    {
+        std::memcpy(data, &m_data[m_readPos], count * sizeof(Uint8));
+        m_readPos += count * sizeof(Uint8);
+    }
+
+    return *this;
+}
+
+
+////////////////////////////////////////////////////////////
+Packet& Packet::readArray(Int16* data, std::size_t count)
+{
+    if (checkCount(count, sizeof(Int16)))
+        readSwapped(data, count);
+
+    return *this;
+}
+
+
+////////////////////////////////////////////////////////////
+Packet& Packet::readArray(Uint16* data, std::size_t count)
+{
+    if (checkCount(count, sizeof(Uint16)))
+        readSwapped(data, count);
+
+    return *this;
+}
+
+
+////////////////////////////////////////////////////////////
+Packet& Packet::readArray(Int32* data, std::size_t count)
+{
+    if (checkCount(count, sizeof(Int32)))
+        readSwapped(data, count);
+
+    return *this;
+}
+
+
+////////////////////////////////////////////////////////////
+Packet& Packet::readArray(Uint32* data, std::size_t count)
+{
+    if (checkCount(count, sizeof(Uint32)))
+        readSwapped(data, count);
+
+    return *this;
+}
+
+
+////////////////////////////////////////////////////////////
+Packet& Packet::readArray(float* data, std::size_t count)
+{
+    if (checkCount(count, sizeof(float)) && (count > 0))
+    {
+        std::memcpy(data, &m_data[m_readPos], count * sizeof(float));
+        m_readPos += count * sizeof(float);
+    }
+
+    return *this;
+}
+
+
+////////////////////////////////////////////////////////////
+Packet& Packet::readArray(double* data, std::size_t count)
+{
+    if (checkCount(count, sizeof(double)) && (count > 0))
+    {
+        std::memcpy(data, &m_data[m_readPos], count * sizeof(double));
+        m_readPos += count * sizeof(double);
     }
 
     return *this;
@@ -484,12 +674,63 @@ Packet& Packet::operator <<(const String& data)
 ////////////////////////////////////////////////////////////
 bool Packet::checkSize(std::size_t size)
 {
-    m_isValid = m_isValid && (m_readPos + size <= m_data.size());
+    m_isValid = m_isValid && (size <= m_data.size() - m_readPos);
 
     return m_isValid;
 }
 
 
+////////////////////////////////////////////////////////////
+bool Packet::checkCount(std::size_t count, std::size_t size)
+{
+    m_isValid = m_isValid && (count <= (m_data.size() - m_readPos) / size);
+
+    return m_isValid;
+}
+
+
+////////////////////////////////////////////////////////////
+char* Packet::grow(std::size_t size)
+{
+    std::size_t start = m_data.size();
+    m_data.resize(start + size);
+
+    return size > 0 ? &m_data[start] : NULL;
+}
+
+
+////////////////////////////////////////////////////////////
+template <typename T>
+void Packet::writeSwapped(const T* data, std::size_t count)
+{
+    char* begin = grow(count * sizeof(T));
+    for (std::size_t i = 0; i < count; ++i)
+    {
+        T value = toNetwork(data[i]);
+        std::memcpy(begin + i * sizeof(T), &value, sizeof(T));
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+template <typename T>
+void Packet::readSwapped(T* data, std::size_t count)
+{
+    if (count == 0)
+        return;
+
+    const char* begin = &m_data[m_readPos];
+    for (std::size_t i = 0; i < count; ++i)
+    {
+        T value;
+        std::memcpy(&value, begin + i * sizeof(T), sizeof(T));
+        data[i] = fromNetwork(value);
+    }
+
+    m_readPos += count * sizeof(T);
+}
+
+
 ////////////////////////////////////////////////////////////
 const void* Packet::onSend(std::size_t& size)
 {
@@ -501,7 +742,20 @@ const void* Packet::onSend(std::size_t& size)
 ////////////////////////////////////////////////////////////
 void Packet::onReceive(const void* data, std::size_t size)
 {
-    append(data, size);
+    // If the data is a whole buffer handed over by a socket, take it instead of copying it
+    if (m_receiveBuffer && m_data.empty() && (size == m_receiveBuffer->size()) && (data == &(*m_receiveBuffer)[0]))
+        m_data.swap(*m_receiveBuffer);
+    else
+        append(data, size);
+}
+
+
+////////////////////////////////////////////////////////////
+void Packet::receiveBuffer(std::vector<char>& buffer)
+{
+    m_receiveBuffer = &buffer;
+    onReceive(&buffer[0], buffer.size());
+    m_receiveBuffer = NULL;
 }
 
 } // namespace sf
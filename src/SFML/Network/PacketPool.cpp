@@ -0,0 +1,130 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2014 Laurent Gomila (laurent.gom@gmail.com)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Network/PacketPool.hpp>
+#include <SFML/Network/Packet.hpp>
+#include <SFML/System/Lock.hpp>
+#include <algorithm>
+
+
+namespace sf
+{
+////////////////////////////////////////////////////////////
+PacketPool::PacketPool(std::size_t maxPackets, std::size_t initialCapacity) :
+m_idle           (),
+m_maxPackets     (maxPackets),
+m_initialCapacity(initialCapacity),
+m_mutex          ()
+{
+
+}
+
+
+////////////////////////////////////////////////////////////
+PacketPool::~PacketPool()
+{
+    for (std::vector<Packet*>::iterator it = m_idle.begin(); it != m_idle.end(); ++it)
+        delete *it;
+}
+
+
+////////////////////////////////////////////////////////////
+Packet* PacketPool::acquire()
+{
+    {
+        Lock lock(m_mutex);
+
+        if (!m_idle.empty())
+        {
+            Packet* packet = m_idle.back();
+            m_idle.pop_back();
+            return packet;
+        }
+    }
+
+    // No idle packet: allocate a new one, outside of the lock
+    return create();
+}
+
+
+////////////////////////////////////////////////////////////
+void PacketPool::release(Packet* packet)
+{
+    if (!packet)
+        return;
+
+    // Clearing keeps the memory of the packet
+    packet->clear();
+
+    {
+        Lock lock(m_mutex);
+
+        if (m_idle.size() < m_maxPackets)
+        {
+            m_idle.push_back(packet);
+            return;
+        }
+    }
+
+    // The pool is full
+    delete packet;
+}
+
+
+////////////////////////////////////////////////////////////
+void PacketPool::preallocate(std::size_t count)
+{
+    Lock lock(m_mutex);
+
+    count = std::min(count, m_maxPackets);
+    m_idle.reserve(count);
+    while (m_idle.size() < count)
+        m_idle.push_back(create());
+}
+
+
+////////////////////////////////////////////////////////////
+std::size_t PacketPool::getIdleCount() const
+{
+    Lock lock(m_mutex);
+
+    return m_idle.size();
+}
+
+
+////////////////////////////////////////////////////////////
+Packet* PacketPool::create() const
+{
+    Packet* packet = new Packet;
+    if (m_initialCapacity > 0)
+        packet->reserve(m_initialCapacity);
+
+    return packet;
+}
+
+} // namespace sf
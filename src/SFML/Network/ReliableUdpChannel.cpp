@@ -0,0 +1,722 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2014 Laurent Gomila (laurent.gom@gmail.com)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Network/ReliableUdpChannel.hpp>
+#include <SFML/Network/Packet.hpp>
+#include <SFML/Network/UdpSocket.hpp>
+#include <SFML/System/Err.hpp>
+#include <algorithm>
+
+
+namespace
+{
+    // Size of the header of a datagram: sequence, ack, ack bits and flags
+    const std::size_t datagramHeaderSize = 9;
+
+    // Maximum size of the header of a fragment: flags, stream, id, index, count and size
+    const std::size_t fragmentHeaderSize = 10;
+
+    // Flags of the header of a datagram
+    const sf::Uint8 hasAck = 0x01;
+
+    // Flags of the header of a fragment
+    const sf::Uint8 deliveryMask = 0x03;
+    const sf::Uint8 isFragmented = 0x04;
+
+    // Number of sent datagrams remembered until they are acknowledged
+    const std::size_t sentDatagramCount = 1024;
+
+    // Maximum number of unacknowledged reliable packets per stream; it keeps
+    // the sequence numbers of the receiver within half of their range
+    const sf::Uint16 maxUnackedPackets = 8192;
+
+    // Maximum distance of an unreliable packet being reassembled to the most recent one
+    const sf::Uint16 maxUnreliableAge = 64;
+
+    // Bounds of the retransmission timeout
+    const sf::Time minRetransmissionTimeout = sf::milliseconds(20);
+    const sf::Time maxRetransmissionTimeout = sf::seconds(1);
+
+    // Tell whether a sequence number is more recent than another, with wrap-around
+    bool isMoreRecent(sf::Uint16 a, sf::Uint16 b)
+    {
+        return (a != b) && (static_cast<sf::Uint16>(a - b) < 32768);
+    }
+
+    // Build the key identifying a reliable fragment
+    sf::Uint64 fragmentKey(sf::Uint8 stream, sf::Uint16 id, sf::Uint16 index)
+    {
+        return (static_cast<sf::Uint64>(stream) << 32) | (static_cast<sf::Uint64>(id) << 16) | index;
+    }
+
+    // Append integers in network byte order
+    void write16(std::vector<char>& buffer, sf::Uint16 value)
+    {
+        buffer.push_back(static_cast<char>(value >> 8));
+        buffer.push_back(static_cast<char>(value & 0xFF));
+    }
+
+    void write32(std::vector<char>& buffer, sf::Uint32 value)
+    {
+        write16(buffer, static_cast<sf::Uint16>(value >> 16));
+        write16(buffer, static_cast<sf::Uint16>(value & 0xFFFF));
+    }
+
+    // Read integers in network byte order
+    sf::Uint16 read16(const unsigned char* data)
+    {
+        return static_cast<sf::Uint16>((data[0] << 8) | data[1]);
+    }
+
+    sf::Uint32 read32(const unsigned char* data)
+    {
+        return (static_cast<sf::Uint32>(read16(data)) << 16) | read16(data + 2);
+    }
+}
+
+
+namespace sf
+{
+////////////////////////////////////////////////////////////
+ReliableUdpChannel::Simulator::Simulator() :
+m_state  (0x2545F491),
+m_loss   (0.f),
+m_latency(Time::Zero),
+m_jitter (Time::Zero)
+{
+
+}
+
+
+////////////////////////////////////////////////////////////
+ReliableUdpChannel::Simulator::~Simulator()
+{
+
+}
+
+
+////////////////////////////////////////////////////////////
+void ReliableUdpChannel::Simulator::setPacketLoss(float ratio)
+{
+    m_loss = ratio;
+}
+
+
+////////////////////////////////////////////////////////////
+void ReliableUdpChannel::Simulator::setLatency(Time latency, Time jitter)
+{
+    m_latency = latency;
+    m_jitter = jitter;
+}
+
+
+////////////////////////////////////////////////////////////
+void ReliableUdpChannel::Simulator::setSeed(Uint32 seed)
+{
+    // The generator never leaves the zero state
+    m_state = seed ? seed : 1;
+}
+
+
+////////////////////////////////////////////////////////////
+bool ReliableUdpChannel::Simulator::isLost(std::size_t)
+{
+    return (m_loss > 0.f) && (random() < m_loss);
+}
+
+
+////////////////////////////////////////////////////////////
+Time ReliableUdpChannel::Simulator::getDelay(std::size_t)
+{
+    if (m_jitter > Time::Zero)
+        return m_latency + m_jitter * random();
+    else
+        return m_latency;
+}
+
+
+////////////////////////////////////////////////////////////
+float ReliableUdpChannel::Simulator::random()
+{
+    // Xorshift generator
+    m_state ^= m_state << 13;
+    m_state ^= m_state >> 17;
+    m_state ^= m_state << 5;
+
+    return static_cast<float>(m_state >> 8) / 16777216.f;
+}
+
+
+////////////////////////////////////////////////////////////
+ReliableUdpChannel::ReliableUdpChannel(UdpSocket& socket, const IpAddress& remoteAddress, unsigned short remotePort) :
+m_socket         (socket),
+m_remoteAddress  (remoteAddress),
+m_remotePort     (remotePort),
+m_maxDatagramSize(1200),
+m_simulator      (NULL),
+m_sentDatagrams  (sentDatagramCount),
+m_localSequence  (0),
+m_remoteSequence (0),
+m_receivedBits   (0),
+m_ackPending     (false),
+m_hasReceived    (false),
+m_lastReceive    (Time::Zero),
+m_smoothedRtt    (milliseconds(100)),
+m_rttVariation   (milliseconds(50)),
+m_buffer         (UdpSocket::MaxDatagramSize)
+{
+    m_socket.setBlocking(false);
+
+    for (std::vector<SentDatagram>::iterator it = m_sentDatagrams.begin(); it != m_sentDatagrams.end(); ++it)
+        it->valid = false;
+}
+
+
+////////////////////////////////////////////////////////////
+Socket::Status ReliableUdpChannel::send(Packet& packet, Delivery delivery, Uint8 stream)
+{
+    // Get the data to send from the packet
+    std::size_t size = 0;
+    const char* data = static_cast<const char*>(packet.onSend(size));
+
+    // Split the packet so that each fragment fits in a datagram
+    std::size_t fragmentSize = m_maxDatagramSize - datagramHeaderSize - fragmentHeaderSize;
+    std::size_t count = std::max<std::size_t>((size + fragmentSize - 1) / fragmentSize, 1);
+    if (count > 65535)
+    {
+        err() << "Cannot send packet over the reliable channel: the packet is too big ("
+              << size << " bytes)" << std::endl;
+        return Socket::Error;
+    }
+
+    Stream& state = m_streams[stream];
+    Uint16 id;
+    if (delivery == Unreliable)
+    {
+        id = state.nextUnreliableId++;
+    }
+    else
+    {
+        // Don't let the reliable packets get too far ahead of the acknowledged ones
+        while ((state.oldestUnacked != state.nextSendId) && !state.unacked.count(state.oldestUnacked))
+            ++state.oldestUnacked;
+        if (static_cast<Uint16>(state.nextSendId - state.oldestUnacked) >= maxUnackedPackets)
+            return Socket::NotReady;
+
+        id = state.nextSendId++;
+        state.unacked[id] = static_cast<Uint16>(count);
+    }
+
+    // Queue the fragments; they are sent by the next update
+    for (std::size_t i = 0; i < count; ++i)
+    {
+        m_outgoing.push_back(Fragment());
+        Fragment& fragment = m_outgoing.back();
+        fragment.delivery = static_cast<Uint8>(delivery);
+        fragment.stream   = stream;
+        fragment.id       = id;
+        fragment.index    = static_cast<Uint16>(i);
+        fragment.count    = static_cast<Uint16>(count);
+        fragment.sentTime = Time::Zero;
+
+        std::size_t begin = i * fragmentSize;
+        std::size_t end = std::min(begin + fragmentSize, size);
+        fragment.data.assign(data + begin, data + end);
+    }
+
+    return Socket::Done;
+}
+
+
+////////////////////////////////////////////////////////////
+bool ReliableUdpChannel::receive(Packet& packet)
+{
+    if (m_received.empty())
+        return false;
+
+    // Hand the data over to the packet
+    std::vector<char>& data = m_received.front();
+    packet.clear();
+    if (!data.empty())
+        packet.onReceive(&data[0], data.size());
+    m_received.pop_front();
+
+    return true;
+}
+
+
+////////////////////////////////////////////////////////////
+Socket::Status ReliableUdpChannel::update(bool receiveDatagrams)
+{
+    Socket::Status status = Socket::Done;
+
+    // Receive the pending datagrams of the remote peer
+    if (receiveDatagrams)
+    {
+        for (;;)
+        {
+            std::size_t received = 0;
+            IpAddress sender;
+            unsigned short port = 0;
+            Socket::Status receiveStatus = m_socket.receive(&m_buffer[0], m_buffer.size(), received, sender, port);
+            if (receiveStatus != Socket::Done)
+            {
+                if (receiveStatus != Socket::NotReady)
+                    status = receiveStatus;
+                break;
+            }
+
+            // Ignore the datagrams of other peers
+            if ((sender == m_remoteAddress) && (port == m_remotePort))
+                processDatagram(&m_buffer[0], received);
+        }
+    }
+
+    Time now = m_clock.getElapsedTime();
+
+    // Resend the reliable fragments that were not acknowledged in time
+    Time timeout = std::min(std::max(m_smoothedRtt + m_rttVariation * 4.f, minRetransmissionTimeout), maxRetransmissionTimeout);
+    std::vector<Fragment*> fragments;
+    for (std::map<Uint64, Fragment>::iterator it = m_unacked.begin(); it != m_unacked.end(); ++it)
+    {
+        if (now - it->second.sentTime >= timeout)
+            fragments.push_back(&it->second);
+    }
+
+    // Send the new fragments; the reliable ones are kept until they are acknowledged
+    std::vector<Fragment> unreliable;
+    unreliable.reserve(m_outgoing.size());
+    for (std::deque<Fragment>::iterator it = m_outgoing.begin(); it != m_outgoing.end(); ++it)
+    {
+        if (it->delivery == Unreliable)
+        {
+            unreliable.push_back(Fragment());
+            unreliable.back() = *it;
+        }
+        else
+        {
+            Fragment& fragment = m_unacked[fragmentKey(it->stream, it->id, it->index)];
+            fragment = *it;
+            fragments.push_back(&fragment);
+        }
+    }
+    m_outgoing.clear();
+    for (std::vector<Fragment>::iterator it = unreliable.begin(); it != unreliable.end(); ++it)
+        fragments.push_back(&*it);
+
+    // Send the fragments, or at least the acknowledgements
+    if (!fragments.empty() || m_ackPending)
+    {
+        Socket::Status sendStatus = sendFragments(fragments, now);
+        if (sendStatus != Socket::Done)
+            status = sendStatus;
+    }
+
+    // Send the datagrams held back by the simulator whose delay is over
+    while (!m_delayed.empty() && (m_delayed.front().sendTime <= now))
+    {
+        const std::vector<char>& data = m_delayed.front().data;
+        m_socket.send(&data[0], data.size(), m_remoteAddress, m_remotePort);
+        m_delayed.pop_front();
+    }
+
+    return status;
+}
+
+
+////////////////////////////////////////////////////////////
+void ReliableUdpChannel::processDatagram(const void* data, std::size_t size)
+{
+    const unsigned char* bytes = static_cast<const unsigned char*>(data);
+    if (size < datagramHeaderSize)
+        return;
+
+    Time now = m_clock.getElapsedTime();
+    m_lastReceive = now;
+
+    // Record the reception of the datagram, to acknowledge it
+    Uint16 sequence = read16(bytes);
+    if (!m_hasReceived || isMoreRecent(sequence, m_remoteSequence))
+    {
+        Uint16 shift = static_cast<Uint16>(sequence - m_remoteSequence);
+        if (!m_hasReceived || (shift > 32))
+            m_receivedBits = 0;
+        else
+            m_receivedBits = ((shift < 32) ? (m_receivedBits << shift) : 0) | (1u << (shift - 1));
+        m_remoteSequence = sequence;
+        m_hasReceived = true;
+    }
+    else
+    {
+        Uint16 distance = static_cast<Uint16>(m_remoteSequence - sequence);
+        if ((distance >= 1) && (distance <= 32))
+            m_receivedBits |= 1u << (distance - 1);
+    }
+
+    // Only datagrams carrying fragments need to be acknowledged, otherwise
+    // two idle peers would keep acknowledging each other's acknowledgements
+    if (size >= datagramHeaderSize + 6)
+        m_ackPending = true;
+
+    // Handle the acknowledgements of our datagrams
+    if (bytes[8] & hasAck)
+    {
+        Uint16 ack = read16(bytes + 2);
+        Uint32 ackBits = read32(bytes + 4);
+        acknowledge(ack, now);
+        for (Uint16 i = 0; i < 32; ++i)
+        {
+            if (ackBits & (1u << i))
+                acknowledge(static_cast<Uint16>(ack - 1 - i), now);
+        }
+    }
+
+    // Handle the fragments
+    std::size_t position = datagramHeaderSize;
+    while (position + 6 <= size)
+    {
+        Fragment fragment;
+        Uint8 flags = bytes[position];
+        fragment.delivery = flags & deliveryMask;
+        fragment.stream   = bytes[position + 1];
+        fragment.id       = read16(bytes + position + 2);
+        fragment.index    = 0;
+        fragment.count    = 1;
+        position += 4;
+
+        if (flags & isFragmented)
+        {
+            if (position + 6 > size)
+                return;
+            fragment.index = read16(bytes + position);
+            fragment.count = read16(bytes + position + 2);
+            position += 4;
+        }
+
+        std::size_t fragmentSize = read16(bytes + position);
+        position += 2;
+
+        // Ignore malformed datagrams
+        if ((position + fragmentSize > size) || (fragment.delivery > ReliableOrdered) || (fragment.index >= fragment.count))
+            return;
+
+        fragment.data.assign(bytes + position, bytes + position + fragmentSize);
+        position += fragmentSize;
+
+        receiveFragment(fragment);
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+void ReliableUdpChannel::setMaximumDatagramSize(std::size_t size)
+{
+    m_maxDatagramSize = std::min<std::size_t>(std::max<std::size_t>(size, 64), UdpSocket::MaxDatagramSize);
+}
+
+
+////////////////////////////////////////////////////////////
+void ReliableUdpChannel::setSimulator(Simulator* simulator)
+{
+    m_simulator = simulator;
+}
+
+
+////////////////////////////////////////////////////////////
+Time ReliableUdpChannel::getRoundTripTime() const
+{
+    return m_smoothedRtt;
+}
+
+
+////////////////////////////////////////////////////////////
+std::size_t ReliableUdpChannel::getUnacknowledgedCount() const
+{
+    return m_unacked.size();
+}
+
+
+////////////////////////////////////////////////////////////
+Time ReliableUdpChannel::getTimeSinceLastReceive() const
+{
+    return m_clock.getElapsedTime() - m_lastReceive;
+}
+
+
+////////////////////////////////////////////////////////////
+Socket::Status ReliableUdpChannel::sendDatagram(const std::vector<char>& data)
+{
+    if (m_simulator)
+    {
+        if (m_simulator->isLost(data.size()))
+            return Socket::Done;
+
+        // Hold the datagram back, keeping the queue sorted by send time
+        Time delay = m_simulator->getDelay(data.size());
+        if (delay > Time::Zero)
+        {
+            DelayedDatagram delayed;
+            delayed.sendTime = m_clock.getElapsedTime() + delay;
+            std::deque<DelayedDatagram>::iterator it = m_delayed.end();
+            while ((it != m_delayed.begin()) && ((it - 1)->sendTime > delayed.sendTime))
+                --it;
+            it = m_delayed.insert(it, delayed);
+            it->data = data;
+            return Socket::Done;
+        }
+    }
+
+    return m_socket.send(&data[0], data.size(), m_remoteAddress, m_remotePort);
+}
+
+
+////////////////////////////////////////////////////////////
+Socket::Status ReliableUdpChannel::sendFragments(const std::vector<Fragment*>& fragments, Time now)
+{
+    Socket::Status status = Socket::Done;
+    std::vector<char> datagram;
+    datagram.reserve(m_maxDatagramSize);
+
+    std::size_t next = 0;
+    do
+    {
+        // Write the header, with the acknowledgements of the remote datagrams
+        datagram.clear();
+        write16(datagram, m_localSequence);
+        write16(datagram, m_remoteSequence);
+        write32(datagram, m_receivedBits);
+        datagram.push_back(static_cast<char>(m_hasReceived ? hasAck : 0));
+
+        SentDatagram& record = m_sentDatagrams[m_localSequence % sentDatagramCount];
+        record.sequence = m_localSequence;
+        record.valid = true;
+        record.sentTime = now;
+        record.fragments.clear();
+
+        // Add as many fragments as fit; a datagram always carries at least one
+        for (; next < fragments.size(); ++next)
+        {
+            Fragment& fragment = *fragments[next];
+            bool fragmented = fragment.count > 1;
+            std::size_t size = (fragmented ? 10 : 6) + fragment.data.size();
+            if ((datagram.size() + size > m_maxDatagramSize) && (datagram.size() > datagramHeaderSize))
+                break;
+
+            datagram.push_back(static_cast<char>(fragment.delivery | (fragmented ? isFragmented : 0)));
+            datagram.push_back(static_cast<char>(fragment.stream));
+            write16(datagram, fragment.id);
+            if (fragmented)
+            {
+                write16(datagram, fragment.index);
+                write16(datagram, fragment.count);
+            }
+            write16(datagram, static_cast<Uint16>(fragment.data.size()));
+            datagram.insert(datagram.end(), fragment.data.begin(), fragment.data.end());
+
+            if (fragment.delivery != Unreliable)
+            {
+                fragment.sentTime = now;
+                record.fragments.push_back(fragmentKey(fragment.stream, fragment.id, fragment.index));
+            }
+        }
+
+        Socket::Status sendStatus = sendDatagram(datagram);
+        if (sendStatus != Socket::Done)
+            status = sendStatus;
+
+        ++m_localSequence;
+    }
+    while (next < fragments.size());
+
+    m_ackPending = false;
+
+    return status;
+}
+
+
+////////////////////////////////////////////////////////////
+void ReliableUdpChannel::acknowledge(Uint16 sequence, Time now)
+{
+    SentDatagram& record = m_sentDatagrams[sequence % sentDatagramCount];
+    if (!record.valid || (record.sequence != sequence))
+        return;
+    record.valid = false;
+
+    // Update the round-trip time estimation (RFC 6298)
+    Time sample = now - record.sentTime;
+    Time difference = sample > m_smoothedRtt ? sample - m_smoothedRtt : m_smoothedRtt - sample;
+    m_rttVariation = m_rttVariation * 0.75f + difference * 0.25f;
+    m_smoothedRtt = m_smoothedRtt * 0.875f + sample * 0.125f;
+
+    // Forget the reliable fragments that the datagram carried
+    for (std::vector<Uint64>::const_iterator it = record.fragments.begin(); it != record.fragments.end(); ++it)
+    {
+        std::map<Uint64, Fragment>::iterator fragment = m_unacked.find(*it);
+        if (fragment == m_unacked.end())
+            continue;
+
+        Stream& stream = m_streams[fragment->second.stream];
+        std::map<Uint16, Uint16>::iterator packet = stream.unacked.find(fragment->second.id);
+        if ((packet != stream.unacked.end()) && (--packet->second == 0))
+            stream.unacked.erase(packet);
+
+        m_unacked.erase(fragment);
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+void ReliableUdpChannel::receiveFragment(Fragment& fragment)
+{
+    Stream& stream = m_streams[fragment.stream];
+
+    // Unreliable packets are received as soon as they are complete
+    if (fragment.delivery == Unreliable)
+    {
+        if (fragment.count == 1)
+        {
+            m_received.push_back(std::vector<char>());
+            m_received.back().swap(fragment.data);
+            return;
+        }
+
+        // Drop the packets that are too old to be completed; a fragment
+        // that arrives late must not evict the newer packets
+        for (std::map<Uint16, Assembly>::iterator it = stream.unreliable.begin(); it != stream.unreliable.end(); )
+        {
+            if (isMoreRecent(fragment.id, it->first) && (static_cast<Uint16>(fragment.id - it->first) > maxUnreliableAge))
+                stream.unreliable.erase(it++);
+            else
+                ++it;
+        }
+
+        Assembly& assembly = stream.unreliable[fragment.id];
+        if (assembly.fragments.empty())
+        {
+            assembly.fragments.resize(fragment.count);
+            assembly.present.resize(fragment.count, false);
+        }
+        if ((fragment.count != assembly.fragments.size()) || assembly.present[fragment.index])
+            return;
+
+        assembly.fragments[fragment.index].swap(fragment.data);
+        assembly.present[fragment.index] = true;
+        if (++assembly.received == assembly.fragments.size())
+        {
+            deliver(assembly);
+            stream.unreliable.erase(fragment.id);
+        }
+
+        return;
+    }
+
+    // Ignore the reliable packets that were already received in order
+    if (isMoreRecent(stream.nextReceiveId, fragment.id))
+        return;
+
+    Assembly& assembly = stream.incoming[fragment.id];
+    if (assembly.fragments.empty())
+    {
+        assembly.fragments.resize(fragment.count);
+        assembly.present.resize(fragment.count, false);
+        assembly.ordered = fragment.delivery == ReliableOrdered;
+    }
+    if ((fragment.count != assembly.fragments.size()) || assembly.present[fragment.index])
+        return;
+
+    assembly.fragments[fragment.index].swap(fragment.data);
+    assembly.present[fragment.index] = true;
+
+    // Unordered packets are received as soon as they are complete
+    if ((++assembly.received == assembly.fragments.size()) && !assembly.ordered)
+        deliver(assembly);
+
+    // Receive the complete packets that are next in order
+    for (;;)
+    {
+        std::map<Uint16, Assembly>::iterator it = stream.incoming.find(stream.nextReceiveId);
+        if ((it == stream.incoming.end()) || (it->second.received != it->second.fragments.size()))
+            break;
+
+        if (!it->second.delivered)
+            deliver(it->second);
+        stream.incoming.erase(it);
+        ++stream.nextReceiveId;
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+void ReliableUdpChannel::deliver(Assembly& assembly)
+{
+    m_received.push_back(std::vector<char>());
+    std::vector<char>& data = m_received.back();
+
+    if (assembly.fragments.size() == 1)
+    {
+        data.swap(assembly.fragments[0]);
+    }
+    else
+    {
+        std::size_t size = 0;
+        for (std::size_t i = 0; i < assembly.fragments.size(); ++i)
+            size += assembly.fragments[i].size();
+
+        data.reserve(size);
+        for (std::size_t i = 0; i < assembly.fragments.size(); ++i)
+        {
+            data.insert(data.end(), assembly.fragments[i].begin(), assembly.fragments[i].end());
+            std::vector<char>().swap(assembly.fragments[i]);
+        }
+    }
+
+    assembly.delivered = true;
+}
+
+
+////////////////////////////////////////////////////////////
+ReliableUdpChannel::Assembly::Assembly() :
+received (0),
+ordered  (false),
+delivered(false)
+{
+
+}
+
+
+////////////////////////////////////////////////////////////
+ReliableUdpChannel::Stream::Stream() :
+nextSendId      (0),
+nextUnreliableId(0),
+oldestUnacked   (0),
+nextReceiveId   (0)
+{
+
+}
+
+} // namespace sf
@@ -0,0 +1,499 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2014 Laurent Gomila (laurent.gom@gmail.com)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Network/Resolver.hpp>
+#include <SFML/Network/SocketImpl.hpp>
+#include <SFML/System/Clock.hpp>
+#include <SFML/System/Lock.hpp>
+#include <SFML/System/Mutex.hpp>
+#include <SFML/System/Sleep.hpp>
+#include <SFML/System/Thread.hpp>
+#include <cstring>
+#include <deque>
+#include <map>
+#include <vector>
+
+
+namespace sf
+{
+namespace priv
+{
+////////////////////////////////////////////////////////////
+/// \brief Shared state of an asynchronous resolution
+///
+////////////////////////////////////////////////////////////
+class ResolveRequest
+{
+public :
+
+    ResolveRequest(const std::string& requestedHost, bool isReady = false, IpAddress resolvedAddress = IpAddress()) :
+    host      (requestedHost),
+    address   (resolvedAddress),
+    ready     (isReady),
+    references(1)
+    {
+    }
+
+    std::string  host;       ///< Host to resolve
+    IpAddress    address;    ///< Resolved address
+    bool         ready;      ///< Is the address available?
+    unsigned int references; ///< Number of results and workers sharing the request
+};
+}
+}
+
+
+namespace
+{
+    // Maximum number of hosts kept in the cache
+    const std::size_t maxCacheSize = 256;
+
+    // Cached resolution
+    struct CacheEntry
+    {
+        sf::IpAddress address;
+        sf::Time      expiration;
+    };
+
+    // Global state of the resolver
+    struct Context
+    {
+        Context() :
+        positiveDuration(sf::seconds(300)),
+        negativeDuration(sf::seconds(10)),
+        function        (NULL),
+        maxWorkers      (4)
+        {
+        }
+
+        ~Context()
+        {
+            // Wait for the running workers
+            for (std::vector<sf::Thread*>::iterator it = workers.begin(); it != workers.end(); ++it)
+                delete *it;
+        }
+
+        sf::Mutex                                        mutex;            // Protects all the members, and the requests
+        sf::Clock                                        clock;            // Reference time of the cache expirations
+        std::map<std::string, CacheEntry>                cache;            // Cached resolutions
+        sf::Time                                         positiveDuration; // Duration of the cache for resolved hosts
+        sf::Time                                         negativeDuration; // Duration of the cache for unresolved hosts
+        sf::Resolver::Function                           function;         // User resolve function, if any
+        std::deque<sf::priv::ResolveRequest*>            queue;            // Requests waiting for a worker
+        std::map<std::string, sf::priv::ResolveRequest*> pending;          // Requests queued or being resolved
+        std::vector<sf::Thread*>                         workers;          // Worker threads
+        std::vector<bool>                                running;          // Is each worker running?
+        unsigned int                                     maxWorkers;       // Maximum number of workers
+    };
+
+    Context& getContext()
+    {
+        static Context context;
+        return context;
+    }
+
+    // Resolve a host name with the system functions
+    sf::IpAddress systemResolve(const std::string& host)
+    {
+        addrinfo hints;
+        std::memset(&hints, 0, sizeof(hints));
+        hints.ai_family = AF_INET;
+        addrinfo* result = NULL;
+        if (getaddrinfo(host.c_str(), NULL, &hints, &result) == 0)
+        {
+            if (result)
+            {
+                sf::Uint32 ip = reinterpret_cast<sockaddr_in*>(result->ai_addr)->sin_addr.s_addr;
+                freeaddrinfo(result);
+                return sf::IpAddress(ntohl(ip));
+            }
+        }
+
+        // Not a valid host name
+        return sf::IpAddress();
+    }
+
+    // Convert an address in decimal notation; return false if it's a host name.
+    // The static addresses of sf::IpAddress are not used here: this function is
+    // called by the string constructors of sf::IpAddress, which may run before
+    // the statics are initialized (global addresses defined in other files)
+    bool parseAddress(const std::string& host, sf::IpAddress& address)
+    {
+        if (host == "255.255.255.255")
+        {
+            // The broadcast address needs to be handled explicitely,
+            // because it is also the value returned by inet_addr on error
+            address = sf::IpAddress(255, 255, 255, 255);
+            return true;
+        }
+
+        // Try to convert the address as a byte representation ("xxx.xxx.xxx.xxx")
+        sf::Uint32 ip = inet_addr(host.c_str());
+        if (ip != INADDR_NONE)
+        {
+            address = sf::IpAddress(ntohl(ip));
+            return true;
+        }
+
+        // An empty string is not a valid host name either
+        if (host.empty())
+        {
+            address = sf::IpAddress();
+            return true;
+        }
+
+        return false;
+    }
+
+    // Look up a host in the cache; must be called with the mutex locked
+    bool findInCache(Context& context, const std::string& host, sf::IpAddress& address)
+    {
+        std::map<std::string, CacheEntry>::iterator it = context.cache.find(host);
+        if (it == context.cache.end())
+            return false;
+
+        if (it->second.expiration <= context.clock.getElapsedTime())
+        {
+            context.cache.erase(it);
+            return false;
+        }
+
+        address = it->second.address;
+        return true;
+    }
+
+    // Add a host to the cache; must be called with the mutex locked
+    void addToCache(Context& context, const std::string& host, sf::IpAddress address)
+    {
+        sf::Time duration = (address != sf::IpAddress()) ? context.positiveDuration : context.negativeDuration;
+        if (duration <= sf::Time::Zero)
+            return;
+
+        sf::Time now = context.clock.getElapsedTime();
+
+        if ((context.cache.size() >= maxCacheSize) && (context.cache.find(host) == context.cache.end()))
+        {
+            // Remove the expired hosts, or else the one which expires first
+            std::map<std::string, CacheEntry>::iterator first = context.cache.begin();
+            for (std::map<std::string, CacheEntry>::iterator it = context.cache.begin(); it != context.cache.end();)
+            {
+                if (it->second.expiration <= now)
+                {
+                    context.cache.erase(it++);
+                    first = context.cache.end();
+                }
+                else
+                {
+                    if ((first != context.cache.end()) && (it->second.expiration < first->second.expiration))
+                        first = it;
+                    ++it;
+                }
+            }
+
+            if ((context.cache.size() >= maxCacheSize) && (first != context.cache.end()))
+                context.cache.erase(first);
+        }
+
+        CacheEntry& entry = context.cache[host];
+        entry.address = address;
+        entry.expiration = now + duration;
+    }
+
+    // Resolve a host name which is not in the cache, and cache the result
+    sf::IpAddress resolveAndCache(Context& context, const std::string& host)
+    {
+        sf::Resolver::Function function;
+        {
+            sf::Lock lock(context.mutex);
+            function = context.function ? context.function : &systemResolve;
+        }
+
+        // Don't keep the mutex locked while resolving, it can be very long
+        sf::IpAddress address = function(host);
+
+        {
+            sf::Lock lock(context.mutex);
+
+            // Don't cache the result of a function which was replaced in the meantime
+            if (function == (context.function ? context.function : &systemResolve))
+                addToCache(context, host, address);
+        }
+
+        return address;
+    }
+
+    // Release a reference to a request; must be called with the mutex locked
+    void releaseRequest(sf::priv::ResolveRequest* request)
+    {
+        if (request && (--request->references == 0))
+            delete request;
+    }
+
+    // Entry point of the worker threads
+    void runWorker(std::size_t index)
+    {
+        Context& context = getContext();
+
+        for (;;)
+        {
+            sf::priv::ResolveRequest* request;
+            {
+                sf::Lock lock(context.mutex);
+
+                if (context.queue.empty())
+                {
+                    // Nothing left to do: stop until new requests arrive
+                    context.running[index] = false;
+                    return;
+                }
+
+                request = context.queue.front();
+                context.queue.pop_front();
+            }
+
+            sf::IpAddress address = resolveAndCache(context, request->host);
+
+            {
+                sf::Lock lock(context.mutex);
+
+                request->address = address;
+                request->ready = true;
+                context.pending.erase(request->host);
+                releaseRequest(request);
+            }
+        }
+    }
+}
+
+
+namespace sf
+{
+////////////////////////////////////////////////////////////
+Resolver::Result::Result() :
+m_request(NULL)
+{
+}
+
+
+////////////////////////////////////////////////////////////
+Resolver::Result::Result(const Result& copy) :
+m_request(copy.m_request)
+{
+    if (m_request)
+    {
+        Lock lock(getContext().mutex);
+        ++m_request->references;
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+Resolver::Result::Result(priv::ResolveRequest* request) :
+m_request(request)
+{
+}
+
+
+////////////////////////////////////////////////////////////
+Resolver::Result::~Result()
+{
+    if (m_request)
+    {
+        Lock lock(getContext().mutex);
+        releaseRequest(m_request);
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+Resolver::Result& Resolver::Result::operator =(const Result& right)
+{
+    if (m_request != right.m_request)
+    {
+        Lock lock(getContext().mutex);
+
+        if (right.m_request)
+            ++right.m_request->references;
+        releaseRequest(m_request);
+        m_request = right.m_request;
+    }
+
+    return *this;
+}
+
+
+////////////////////////////////////////////////////////////
+bool Resolver::Result::isReady() const
+{
+    if (!m_request)
+        return true;
+
+    Lock lock(getContext().mutex);
+    return m_request->ready;
+}
+
+
+////////////////////////////////////////////////////////////
+bool Resolver::Result::wait(Time timeout) const
+{
+    Clock clock;
+    while (!isReady())
+    {
+        if ((timeout != Time::Zero) && (clock.getElapsedTime() >= timeout))
+            return false;
+
+        sleep(milliseconds(1));
+    }
+
+    return true;
+}
+
+
+////////////////////////////////////////////////////////////
+IpAddress Resolver::Result::getAddress() const
+{
+    if (!m_request)
+        return IpAddress();
+
+    wait();
+
+    Lock lock(getContext().mutex);
+    return m_request->address;
+}
+
+
+////////////////////////////////////////////////////////////
+IpAddress Resolver::resolve(const std::string& host)
+{
+    IpAddress address;
+    if (parseAddress(host, address))
+        return address;
+
+    Context& context = getContext();
+    {
+        Lock lock(context.mutex);
+        if (findInCache(context, host, address))
+            return address;
+    }
+
+    return resolveAndCache(context, host);
+}
+
+
+////////////////////////////////////////////////////////////
+Resolver::Result Resolver::resolveAsync(const std::string& host)
+{
+    IpAddress address;
+    if (parseAddress(host, address))
+        return Result(new priv::ResolveRequest(host, true, address));
+
+    Context& context = getContext();
+    Lock lock(context.mutex);
+
+    if (findInCache(context, host, address))
+        return Result(new priv::ResolveRequest(host, true, address));
+
+    // Share the resolution already in progress for this host, if any
+    std::map<std::string, priv::ResolveRequest*>::iterator it = context.pending.find(host);
+    if (it != context.pending.end())
+    {
+        ++it->second->references;
+        return Result(it->second);
+    }
+
+    // Queue a new request, referenced by both the result and the worker
+    priv::ResolveRequest* request = new priv::ResolveRequest(host);
+    request->references = 2;
+    context.pending[host] = request;
+    context.queue.push_back(request);
+
+    // Start a worker if they are all busy
+    for (std::size_t i = 0; i < context.maxWorkers; ++i)
+    {
+        if (i == context.workers.size())
+        {
+            context.workers.push_back(new Thread(&runWorker, i));
+            context.running.push_back(false);
+        }
+
+        if (!context.running[i])
+        {
+            // If the worker is still terminating, launch waits for it;
+            // this is quick since it doesn't need the mutex anymore
+            context.running[i] = true;
+            context.workers[i]->launch();
+            break;
+        }
+    }
+
+    return Result(request);
+}
+
+
+////////////////////////////////////////////////////////////
+void Resolver::setCacheDuration(Time positive, Time negative)
+{
+    Context& context = getContext();
+    Lock lock(context.mutex);
+
+    context.positiveDuration = positive;
+    context.negativeDuration = negative;
+}
+
+
+////////////////////////////////////////////////////////////
+void Resolver::clearCache()
+{
+    Context& context = getContext();
+    Lock lock(context.mutex);
+
+    context.cache.clear();
+}
+
+
+////////////////////////////////////////////////////////////
+void Resolver::setWorkerCount(unsigned int count)
+{
+    Context& context = getContext();
+    Lock lock(context.mutex);
+
+    context.maxWorkers = count > 0 ? count : 1;
+}
+
+
+////////////////////////////////////////////////////////////
+void Resolver::setFunction(Function function)
+{
+    Context& context = getContext();
+    Lock lock(context.mutex);
+
+    context.function = function;
+    context.cache.clear();
+}
+
+} // namespace sf
@@ -0,0 +1,202 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2014 Laurent Gomila (laurent.gom@gmail.com)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Network/Snapshot.hpp>
+#include <SFML/System/Err.hpp>
+#include <algorithm>
+#include <cstring>
+
+
+namespace
+{
+    // Maximum number of fields of an entity, so that their count fits in a byte
+    const std::size_t maxFieldCount = 255;
+
+    // Order entities by identifier
+    struct EntityLess
+    {
+        template <typename T>
+        bool operator ()(const T& entity, sf::Uint32 id) const
+        {
+            return entity.id < id;
+        }
+    };
+}
+
+
+namespace sf
+{
+////////////////////////////////////////////////////////////
+Snapshot::Snapshot() :
+m_sequence(0)
+{
+
+}
+
+
+////////////////////////////////////////////////////////////
+void Snapshot::clear()
+{
+    m_entities.clear();
+    m_sequence = 0;
+}
+
+
+////////////////////////////////////////////////////////////
+void Snapshot::setField(Uint32 entity, unsigned int field, Uint32 value)
+{
+    if (field >= maxFieldCount)
+    {
+        err() << "Failed to set field " << field << " of snapshot entity " << entity
+              << " (entities have at most " << maxFieldCount << " fields)" << std::endl;
+        return;
+    }
+
+    Entity& data = insertEntity(entity);
+    if (field >= data.fields.size())
+        data.fields.resize(field + 1, 0);
+    data.fields[field] = value;
+}
+
+
+////////////////////////////////////////////////////////////
+void Snapshot::setField(Uint32 entity, unsigned int field, Int32 value)
+{
+    setField(entity, field, static_cast<Uint32>(value));
+}
+
+
+////////////////////////////////////////////////////////////
+void Snapshot::setField(Uint32 entity, unsigned int field, float value)
+{
+    Uint32 bits;
+    std::memcpy(&bits, &value, sizeof(bits));
+    setField(entity, field, bits);
+}
+
+
+////////////////////////////////////////////////////////////
+Uint32 Snapshot::getField(Uint32 entity, unsigned int field) const
+{
+    const Entity* data = findEntity(entity);
+    return (data && (field < data->fields.size())) ? data->fields[field] : 0;
+}
+
+
+////////////////////////////////////////////////////////////
+Int32 Snapshot::getSignedField(Uint32 entity, unsigned int field) const
+{
+    return static_cast<Int32>(getField(entity, field));
+}
+
+
+////////////////////////////////////////////////////////////
+float Snapshot::getFloatField(Uint32 entity, unsigned int field) const
+{
+    Uint32 bits = getField(entity, field);
+    float value;
+    std::memcpy(&value, &bits, sizeof(value));
+    return value;
+}
+
+
+////////////////////////////////////////////////////////////
+void Snapshot::removeEntity(Uint32 entity)
+{
+    std::vector<Entity>::iterator it = std::lower_bound(m_entities.begin(), m_entities.end(), entity, EntityLess());
+    if ((it != m_entities.end()) && (it->id == entity))
+        m_entities.erase(it);
+}
+
+
+////////////////////////////////////////////////////////////
+bool Snapshot::hasEntity(Uint32 entity) const
+{
+    return findEntity(entity) != NULL;
+}
+
+
+////////////////////////////////////////////////////////////
+std::size_t Snapshot::getEntityCount() const
+{
+    return m_entities.size();
+}
+
+
+////////////////////////////////////////////////////////////
+Uint32 Snapshot::getEntityId(std::size_t index) const
+{
+    return m_entities[index].id;
+}
+
+
+////////////////////////////////////////////////////////////
+std::size_t Snapshot::getFieldCount(Uint32 entity) const
+{
+    const Entity* data = findEntity(entity);
+    return data ? data->fields.size() : 0;
+}
+
+
+////////////////////////////////////////////////////////////
+Uint32 Snapshot::getSequence() const
+{
+    return m_sequence;
+}
+
+
+////////////////////////////////////////////////////////////
+const Snapshot::Entity* Snapshot::findEntity(Uint32 entity) const
+{
+    std::vector<Entity>::const_iterator it = std::lower_bound(m_entities.begin(), m_entities.end(), entity, EntityLess());
+    return ((it != m_entities.end()) && (it->id == entity)) ? &*it : NULL;
+}
+
+
+////////////////////////////////////////////////////////////
+Snapshot::Entity& Snapshot::insertEntity(Uint32 entity)
+{
+    // Entities are usually added in increasing order
+    if (m_entities.empty() || (m_entities.back().id < entity))
+    {
+        m_entities.push_back(Entity());
+        m_entities.back().id = entity;
+        return m_entities.back();
+    }
+
+    std::vector<Entity>::iterator it = std::lower_bound(m_entities.begin(), m_entities.end(), entity, EntityLess());
+    if (it->id != entity)
+    {
+        it = m_entities.insert(it, Entity());
+        it->id = entity;
+    }
+
+    return *it;
+}
+
+} // namespace sf
@@ -0,0 +1,116 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2014 Laurent Gomila (laurent.gom@gmail.com)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Network/SnapshotDecoder.hpp>
+#include <SFML/Network/Packet.hpp>
+#include <algorithm>
+
+
+namespace sf
+{
+////////////////////////////////////////////////////////////
+SnapshotDecoder::SnapshotDecoder(std::size_t historySize) :
+m_history(std::min<std::size_t>(std::max<std::size_t>(historySize, 1), 65535))
+{
+
+}
+
+
+////////////////////////////////////////////////////////////
+bool SnapshotDecoder::decode(Packet& packet, Snapshot& snapshot)
+{
+    Uint32 sequence = 0;
+    Uint16 distance = 0;
+    if (!(packet >> sequence >> distance) || (sequence == 0))
+        return false;
+
+    // Start from the baseline, which must still be in the history
+    Snapshot& received = m_history[sequence % m_history.size()];
+    if (distance > 0)
+    {
+        const Snapshot& baseline = m_history[(sequence - distance) % m_history.size()];
+        if ((distance >= m_history.size()) || (baseline.m_sequence != sequence - distance))
+            return false;
+        received = baseline;
+    }
+    else
+    {
+        received.clear();
+    }
+
+    // Apply the changed entities
+    Uint32 count = 0;
+    packet >> count;
+    for (Uint32 i = 0; (i < count) && packet; ++i)
+    {
+        Uint32 id = 0;
+        Uint8 fieldCount = 0;
+        Uint8 mask[32] = {0};
+        if (!(packet >> id >> fieldCount) || !packet.readArray(mask, (fieldCount + 7) / 8))
+            break;
+
+        // Fields that don't exist in the baseline start at 0
+        std::vector<Uint32>& fields = received.insertEntity(id).fields;
+        fields.resize(fieldCount, 0);
+        for (std::size_t j = 0; j < fieldCount; ++j)
+        {
+            if (mask[j / 8] & (1 << (j % 8)))
+                packet >> fields[j];
+        }
+    }
+
+    // Apply the removed entities
+    packet >> count;
+    for (Uint32 i = 0; (i < count) && packet; ++i)
+    {
+        Uint32 id = 0;
+        if (packet >> id)
+            received.removeEntity(id);
+    }
+
+    if (!packet)
+    {
+        received.clear();
+        return false;
+    }
+
+    received.m_sequence = sequence;
+    snapshot = received;
+
+    return true;
+}
+
+
+////////////////////////////////////////////////////////////
+void SnapshotDecoder::reset()
+{
+    for (std::vector<Snapshot>::iterator it = m_history.begin(); it != m_history.end(); ++it)
+        it->clear();
+}
+
+} // namespace sf
@@ -0,0 +1,154 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2014 Laurent Gomila (laurent.gom@gmail.com)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Network/SnapshotEncoder.hpp>
+#include <SFML/Network/Packet.hpp>
+#include <algorithm>
+
+
+namespace sf
+{
+////////////////////////////////////////////////////////////
+SnapshotEncoder::SnapshotEncoder(std::size_t historySize) :
+m_history     (std::min<std::size_t>(std::max<std::size_t>(historySize, 1), 65535)),
+m_nextSequence(1),
+m_baseline    (0)
+{
+
+}
+
+
+////////////////////////////////////////////////////////////
+Uint32 SnapshotEncoder::encode(const Snapshot& snapshot, Packet& packet)
+{
+    Uint32 sequence = m_nextSequence++;
+    if (m_nextSequence == 0)
+        m_nextSequence = 1;
+
+    // Find the baseline, if the receiver acknowledged a snapshot that is still in the history
+    const Snapshot* baseline = NULL;
+    if ((m_baseline != 0) && (sequence - m_baseline < m_history.size()) && (m_history[m_baseline % m_history.size()].m_sequence == m_baseline))
+        baseline = &m_history[m_baseline % m_history.size()];
+
+    // Find the entities that changed and the ones that were removed, by merging both sorted lists
+    const std::vector<Snapshot::Entity>& entities = snapshot.m_entities;
+    m_changed.clear();
+    m_removed.clear();
+    if (baseline)
+    {
+        const std::vector<Snapshot::Entity>& previous = baseline->m_entities;
+        std::size_t j = 0;
+        for (std::size_t i = 0; i < entities.size(); ++i)
+        {
+            while ((j < previous.size()) && (previous[j].id < entities[i].id))
+                m_removed.push_back(previous[j++].id);
+
+            if ((j < previous.size()) && (previous[j].id == entities[i].id))
+            {
+                if (entities[i].fields != previous[j].fields)
+                    m_changed.push_back(std::make_pair(i, &previous[j]));
+                ++j;
+            }
+            else
+            {
+                m_changed.push_back(std::make_pair(i, static_cast<const Snapshot::Entity*>(NULL)));
+            }
+        }
+        for (; j < previous.size(); ++j)
+            m_removed.push_back(previous[j].id);
+    }
+    else
+    {
+        for (std::size_t i = 0; i < entities.size(); ++i)
+            m_changed.push_back(std::make_pair(i, static_cast<const Snapshot::Entity*>(NULL)));
+    }
+
+    // Write the header
+    packet << sequence << static_cast<Uint16>(baseline ? sequence - m_baseline : 0);
+
+    // Write the changed entities: a bitmask of the changed fields followed by their values;
+    // fields that don't exist in the baseline are compared to 0
+    packet << static_cast<Uint32>(m_changed.size());
+    for (std::vector<std::pair<std::size_t, const Snapshot::Entity*> >::const_iterator it = m_changed.begin(); it != m_changed.end(); ++it)
+    {
+        const std::vector<Uint32>& fields = entities[it->first].fields;
+        const std::vector<Uint32>* previous = it->second ? &it->second->fields : NULL;
+
+        Uint8 mask[32] = {0};
+        std::size_t maskSize = (fields.size() + 7) / 8;
+        for (std::size_t i = 0; i < fields.size(); ++i)
+        {
+            Uint32 old = (previous && (i < previous->size())) ? (*previous)[i] : 0;
+            if (fields[i] != old)
+                mask[i / 8] |= static_cast<Uint8>(1 << (i % 8));
+        }
+
+        packet << entities[it->first].id << static_cast<Uint8>(fields.size());
+        packet.writeArray(mask, maskSize);
+        for (std::size_t i = 0; i < fields.size(); ++i)
+        {
+            if (mask[i / 8] & (1 << (i % 8)))
+                packet << fields[i];
+        }
+    }
+
+    // Write the removed entities
+    packet << static_cast<Uint32>(m_removed.size());
+    if (!m_removed.empty())
+        packet.writeArray(&m_removed[0], m_removed.size());
+
+    // Keep the snapshot as a possible baseline
+    Snapshot& sent = m_history[sequence % m_history.size()];
+    sent = snapshot;
+    sent.m_sequence = sequence;
+
+    return sequence;
+}
+
+
+////////////////////////////////////////////////////////////
+void SnapshotEncoder::acknowledge(Uint32 sequence)
+{
+    // Only move forward, to snapshots that are still in the history
+    if ((sequence > m_baseline) && (sequence < m_nextSequence) && (m_nextSequence - sequence <= m_history.size()) &&
+        (m_history[sequence % m_history.size()].m_sequence == sequence))
+    {
+        m_baseline = sequence;
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+void SnapshotEncoder::reset()
+{
+    for (std::vector<Snapshot>::iterator it = m_history.begin(); it != m_history.end(); ++it)
+        it->clear();
+    m_baseline = 0;
+}
+
+} // namespace sf
@@ -28,17 +28,114 @@
 #include <SFML/Network/Socket.hpp>
 #include <SFML/Network/SocketImpl.hpp>
 #include <SFML/System/Err.hpp>
+#include <SFML/System/Lock.hpp>
+#include <SFML/System/Mutex.hpp>
+#include <algorithm>
+
+
+namespace
+{
+    // Sockets whose statistics are enabled, and the statistics of the ones that were disabled or reset
+    struct StatsRegistry
+    {
+        sf::Mutex                mutex;
+        std::vector<sf::Socket*> sockets;
+        sf::SocketStats          retired;
+    };
+
+    bool defaultStatsEnabled = false;
+
+    // The registry is allocated once and never destroyed, so that
+    // sockets which outlive static destruction can still be closed
+    StatsRegistry& getStatsRegistry()
+    {
+        static StatsRegistry* registry = new StatsRegistry;
+        return *registry;
+    }
+
+    // Atomically replace a counter if it still has the expected value
+    bool compareExchange(sf::Uint64* counter, sf::Uint64 expected, sf::Uint64 desired)
+    {
+    #if defined(SFML_SYSTEM_WINDOWS)
+        volatile LONGLONG* target = reinterpret_cast<volatile LONGLONG*>(counter);
+        return InterlockedCompareExchange64(target, static_cast<LONGLONG>(desired), static_cast<LONGLONG>(expected)) == static_cast<LONGLONG>(expected);
+    #else
+        return __sync_bool_compare_and_swap(counter, expected, desired);
+    #endif
+    }
+
+    // Atomically read a counter; 64-bit reads can tear on 32-bit systems
+    sf::Uint64 atomicLoad(sf::Uint64* counter)
+    {
+    #if defined(SFML_SYSTEM_WINDOWS)
+        return static_cast<sf::Uint64>(InterlockedCompareExchange64(reinterpret_cast<volatile LONGLONG*>(counter), 0, 0));
+    #else
+        return __sync_fetch_and_add(counter, 0);
+    #endif
+    }
+
+    // Atomically add a value to a counter
+    void atomicAdd(sf::Uint64* counter, sf::Uint64 value)
+    {
+    #if defined(SFML_SYSTEM_WINDOWS)
+        sf::Uint64 current = atomicLoad(counter);
+        while (!compareExchange(counter, current, current + value))
+            current = atomicLoad(counter);
+    #else
+        __sync_fetch_and_add(counter, value);
+    #endif
+    }
+
+    // Atomically raise a peak value
+    void atomicMax(sf::Uint64* peak, sf::Uint64 value)
+    {
+        sf::Uint64 current = atomicLoad(peak);
+        while ((value > current) && !compareExchange(peak, current, value))
+            current = atomicLoad(peak);
+    }
+
+    // Atomically read a counter, and set it to 0 if requested
+    sf::Uint64 take(sf::Uint64* counter, bool reset)
+    {
+        sf::Uint64 value = atomicLoad(counter);
+        while (reset && !compareExchange(counter, value, 0))
+            value = atomicLoad(counter);
+
+        return value;
+    }
+
+    // Add statistics to a total; other threads may be updating them meanwhile
+    void accumulate(sf::SocketStats& total, sf::SocketStats& stats, bool reset)
+    {
+        total.bytesSent         += take(&stats.bytesSent, reset);
+        total.bytesReceived     += take(&stats.bytesReceived, reset);
+        total.packetsSent       += take(&stats.packetsSent, reset);
+        total.packetsReceived   += take(&stats.packetsReceived, reset);
+        total.partialSends      += take(&stats.partialSends, reset);
+        total.notReady          += take(&stats.notReady, reset);
+        total.errors            += take(&stats.errors, reset);
+        total.sendQueuePeak     =  std::max(total.sendQueuePeak, take(&stats.sendQueuePeak, reset));
+        total.receiveBufferPeak =  std::max(total.receiveBufferPeak, take(&stats.receiveBufferPeak, reset));
+    }
+}
 
 
 namespace sf
 {
 ////////////////////////////////////////////////////////////
 Socket::Socket(Type type) :
-m_type      (type),
-m_socket    (priv::SocketImpl::invalidSocket()),
-m_isBlocking(true)
+m_type             (type),
+m_socket           (priv::SocketImpl::invalidSocket()),
+m_isBlocking       (true),
+m_sendBufferSize   (0),
+m_receiveBufferSize(0),
+m_noDelay          (true),
+m_cork             (false),
+m_statsEnabled     (false),
+m_stats            ()
 {
-
+    if (defaultStatsEnabled)
+        setStatsEnabled(true);
 }
 
 
@@ -47,6 +144,9 @@ Socket::~Socket()
 {
     // Close the socket before it gets destructed
     close();
+
+    // Keep the statistics in the global ones
+    setStatsEnabled(false);
 }
 
 
@@ -68,6 +168,36 @@ bool Socket::isBlocking() const
 }
 
 
+////////////////////////////////////////////////////////////
+void Socket::setSendBufferSize(std::size_t size)
+{
+    // Apply if the socket is already created
+    if ((m_socket != priv::SocketImpl::invalidSocket()) && (size > 0))
+    {
+        int value = static_cast<int>(size);
+        if (setsockopt(m_socket, SOL_SOCKET, SO_SNDBUF, reinterpret_cast<char*>(&value), sizeof(value)) == -1)
+            err() << "Failed to set socket option \"SO_SNDBUF\"" << std::endl;
+    }
+
+    m_sendBufferSize = size;
+}
+
+
+////////////////////////////////////////////////////////////
+void Socket::setReceiveBufferSize(std::size_t size)
+{
+    // Apply if the socket is already created
+    if ((m_socket != priv::SocketImpl::invalidSocket()) && (size > 0))
+    {
+        int value = static_cast<int>(size);
+        if (setsockopt(m_socket, SOL_SOCKET, SO_RCVBUF, reinterpret_cast<char*>(&value), sizeof(value)) == -1)
+            err() << "Failed to set socket option \"SO_RCVBUF\"" << std::endl;
+    }
+
+    m_receiveBufferSize = size;
+}
+
+
 ////////////////////////////////////////////////////////////
 SocketHandle Socket::getHandle() const
 {
@@ -96,21 +226,21 @@ void Socket::create(SocketHandle handle)
         // Assign the new handle
         m_socket = handle;
 
-        // Set the current blocking state
+        // Set the current blocking state and buffer sizes
         setBlocking(m_isBlocking);
+        setSendBufferSize(m_sendBufferSize);
+        setReceiveBufferSize(m_receiveBufferSize);
 
         if (m_type == Tcp)
         {
-            // Disable the Nagle algorithm (ie. removes buffering of TCP packets)
-            int yes = 1;
-            if (setsockopt(m_socket, IPPROTO_TCP, TCP_NODELAY, reinterpret_cast<char*>(&yes), sizeof(yes)) == -1)
-            {
-                err() << "Failed to set socket option \"TCP_NODELAY\" ; "
-                      << "all your TCP packets will be buffered" << std::endl;
-            }
+            // Disable the Nagle algorithm (ie. removes buffering of TCP packets), unless requested otherwise
+            setNoDelayOption(m_noDelay);
+            if (m_cork)
+                setCorkOption(true);
 
             // On Mac OS X, disable the SIGPIPE signal on disconnection
             #ifdef SFML_SYSTEM_MACOS
+                int yes = 1;
                 if (setsockopt(m_socket, SOL_SOCKET, SO_NOSIGPIPE, reinterpret_cast<char*>(&yes), sizeof(yes)) == -1)
                 {
                     err() << "Failed to set socket option \"SO_NOSIGPIPE\"" << std::endl;
@@ -141,4 +271,213 @@ void Socket::close()
     }
 }
 
+
+////////////////////////////////////////////////////////////
+void Socket::setStatsEnabled(bool enabled)
+{
+    if (enabled == m_statsEnabled)
+        return;
+
+#ifdef SFML_NO_NETWORK_STATS
+
+    if (enabled)
+    {
+        err() << "Failed to enable socket statistics (SFML was built without them)" << std::endl;
+        return;
+    }
+
+#endif
+
+    StatsRegistry& registry = getStatsRegistry();
+    Lock lock(registry.mutex);
+
+    if (enabled)
+    {
+        m_stats = SocketStats();
+        registry.sockets.push_back(this);
+    }
+    else
+    {
+        accumulate(registry.retired, m_stats, false);
+        registry.sockets.erase(std::find(registry.sockets.begin(), registry.sockets.end(), this));
+    }
+
+    m_statsEnabled = enabled;
+}
+
+
+////////////////////////////////////////////////////////////
+bool Socket::isStatsEnabled() const
+{
+    return m_statsEnabled;
+}
+
+
+////////////////////////////////////////////////////////////
+SocketStats Socket::getStats() const
+{
+    // Reading the counters doesn't modify them
+    SocketStats stats;
+    accumulate(stats, const_cast<SocketStats&>(m_stats), false);
+
+    return stats;
+}
+
+
+////////////////////////////////////////////////////////////
+void Socket::resetStats()
+{
+    StatsRegistry& registry = getStatsRegistry();
+    Lock lock(registry.mutex);
+
+    // The global statistics keep what was counted so far
+    SocketStats counted;
+    accumulate(counted, m_stats, true);
+    if (m_statsEnabled)
+        accumulate(registry.retired, counted, false);
+}
+
+
+////////////////////////////////////////////////////////////
+void Socket::setDefaultStatsEnabled(bool enabled)
+{
+#ifdef SFML_NO_NETWORK_STATS
+
+    // Report the error once, rather than for every new socket
+    if (enabled)
+    {
+        err() << "Failed to enable socket statistics (SFML was built without them)" << std::endl;
+        return;
+    }
+
+#endif
+
+    defaultStatsEnabled = enabled;
+}
+
+
+////////////////////////////////////////////////////////////
+SocketStats Socket::getGlobalStats()
+{
+    StatsRegistry& registry = getStatsRegistry();
+    Lock lock(registry.mutex);
+
+    SocketStats total = registry.retired;
+    for (std::vector<Socket*>::const_iterator it = registry.sockets.begin(); it != registry.sockets.end(); ++it)
+        accumulate(total, (*it)->m_stats, false);
+
+    return total;
+}
+
+
+////////////////////////////////////////////////////////////
+void Socket::setNoDelayOption(bool noDelay)
+{
+    // Apply if the socket is already created
+    if (m_socket != priv::SocketImpl::invalidSocket())
+    {
+        int value = noDelay ? 1 : 0;
+        if (setsockopt(m_socket, IPPROTO_TCP, TCP_NODELAY, reinterpret_cast<char*>(&value), sizeof(value)) == -1)
+        {
+            err() << "Failed to set socket option \"TCP_NODELAY\" ; "
+                  << "all your TCP packets will be buffered" << std::endl;
+        }
+    }
+
+    m_noDelay = noDelay;
+}
+
+
+////////////////////////////////////////////////////////////
+bool Socket::setCorkOption(bool cork)
+{
+    m_cork = cork;
+
+    #if defined(TCP_CORK) || defined(TCP_NOPUSH)
+
+        // Apply if the socket is already created
+        if (m_socket != priv::SocketImpl::invalidSocket())
+        {
+            // TCP_CORK is Linux-specific, BSD systems provide the equivalent TCP_NOPUSH
+            #if defined(TCP_CORK)
+                const int option = TCP_CORK;
+            #else
+                const int option = TCP_NOPUSH;
+            #endif
+
+            int value = cork ? 1 : 0;
+            if (setsockopt(m_socket, IPPROTO_TCP, option, reinterpret_cast<char*>(&value), sizeof(value)) == -1)
+            {
+                err() << "Failed to set socket option \"TCP_CORK\"" << std::endl;
+                return false;
+            }
+        }
+
+        return true;
+
+    #else
+
+        // Not supported by the system
+        return false;
+
+    #endif
+}
+
+
+////////////////////////////////////////////////////////////
+void Socket::recordSend(std::size_t requested, std::size_t sent)
+{
+    if (m_statsEnabled)
+    {
+        atomicAdd(&m_stats.bytesSent, sent);
+        if (sent < requested)
+            atomicAdd(&m_stats.partialSends, 1);
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+void Socket::recordReceive(std::size_t received)
+{
+    if (m_statsEnabled)
+        atomicAdd(&m_stats.bytesReceived, received);
+}
+
+
+////////////////////////////////////////////////////////////
+void Socket::recordPackets(std::size_t sent, std::size_t received)
+{
+    if (m_statsEnabled)
+    {
+        atomicAdd(&m_stats.packetsSent, sent);
+        atomicAdd(&m_stats.packetsReceived, received);
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+Socket::Status Socket::recordStatus(Status status)
+{
+    if (m_statsEnabled)
+    {
+        if (status == NotReady)
+            atomicAdd(&m_stats.notReady, 1);
+        else if (status == Error)
+            atomicAdd(&m_stats.errors, 1);
+    }
+
+    return status;
+}
+
+
+////////////////////////////////////////////////////////////
+void Socket::recordBufferSizes(std::size_t sendQueue, std::size_t receiveBuffer)
+{
+    if (m_statsEnabled)
+    {
+        atomicMax(&m_stats.sendQueuePeak, sendQueue);
+        atomicMax(&m_stats.receiveBufferPeak, receiveBuffer);
+    }
+}
+
 } // namespace sf
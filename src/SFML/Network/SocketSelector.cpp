@@ -29,8 +29,16 @@
 #include <SFML/Network/Socket.hpp>
 #include <SFML/Network/SocketImpl.hpp>
 #include <SFML/System/Err.hpp>
+#include <algorithm>
+#include <map>
 #include <utility>
 
+#if defined(SFML_SYSTEM_LINUX) || defined(SFML_SYSTEM_ANDROID)
+    #include <sys/epoll.h>
+    #include <errno.h>
+    #define SFML_SELECTOR_EPOLL
+#endif
+
 #ifdef _MSC_VER
     #pragma warning(disable : 4127) // "conditional expression is constant" generated by the FD_SET macro
 #endif
@@ -41,9 +49,44 @@ namespace sf
 ////////////////////////////////////////////////////////////
 struct SocketSelector::SocketSelectorImpl
 {
-    fd_set AllSockets;   ///< Set containing all the sockets handles
-    fd_set SocketsReady; ///< Set containing handles of the sockets that are ready
-    int    MaxSocket;    ///< Maximum socket handle
+    struct Entry
+    {
+        Socket*      socket;   ///< Registered socket
+        Trigger      trigger;  ///< How readiness is reported for this socket
+        unsigned int interest; ///< Kinds of readiness watched for this socket
+    };
+
+    typedef std::map<SocketHandle, Entry> SocketTable;
+
+    SocketTable          Sockets;      ///< Table of all the registered sockets
+    std::vector<Socket*> Ready;        ///< Sockets found ready by the last wait
+    fd_set               AllSockets;   ///< Set containing the handles watched for Receive (select backend)
+    fd_set               SocketsReady; ///< Set containing handles of the sockets that are ready to receive (select backend)
+    fd_set               SendSockets;  ///< Set containing the handles watched for Send (select backend)
+    fd_set               SendReady;    ///< Set containing handles of the sockets that are ready to send (select backend)
+    int                  MaxSocket;    ///< Maximum socket handle (select backend)
+
+#ifdef SFML_SELECTOR_EPOLL
+    int                        EpollHandle;  ///< Epoll instance, or -1 if the select backend is used
+    std::vector<epoll_event>   Events;       ///< Buffer receiving the events of epoll_wait
+    std::vector<unsigned char> ReadyFlags;   ///< Per-handle Interest flags found ready by the last wait (epoll backend)
+    std::vector<SocketHandle>  ReadyHandles; ///< Handles flagged in ReadyFlags by the last wait (epoll backend)
+#endif
+
+    SocketSelectorImpl() :
+    MaxSocket(0)
+    {
+        FD_ZERO(&AllSockets);
+        FD_ZERO(&SocketsReady);
+        FD_ZERO(&SendSockets);
+        FD_ZERO(&SendReady);
+
+    #ifdef SFML_SELECTOR_EPOLL
+        EpollHandle = epoll_create1(EPOLL_CLOEXEC);
+        if (EpollHandle < 0)
+            err() << "Failed to create the epoll instance of a socket selector, falling back to select" << std::endl;
+    #endif
+    }
 };
 
 
@@ -51,71 +94,261 @@ struct SocketSelector::SocketSelectorImpl
 SocketSelector::SocketSelector() :
 m_impl(new SocketSelectorImpl)
 {
-    clear();
+
 }
 
 
 ////////////////////////////////////////////////////////////
 SocketSelector::SocketSelector(const SocketSelector& copy) :
-m_impl(new SocketSelectorImpl(*copy.m_impl))
+m_impl(new SocketSelectorImpl)
 {
-
+    // Register the same sockets, the OS-specific state can't be copied
+    for (SocketSelectorImpl::SocketTable::const_iterator it = copy.m_impl->Sockets.begin(); it != copy.m_impl->Sockets.end(); ++it)
+        add(*it->second.socket, it->second.trigger, it->second.interest);
 }
 
 
 ////////////////////////////////////////////////////////////
 SocketSelector::~SocketSelector()
 {
+#ifdef SFML_SELECTOR_EPOLL
+    if (m_impl->EpollHandle >= 0)
+        ::close(m_impl->EpollHandle);
+#endif
+
     delete m_impl;
 }
 
 
 ////////////////////////////////////////////////////////////
 void SocketSelector::add(Socket& socket)
+{
+    add(socket, LevelTriggered);
+}
+
+
+////////////////////////////////////////////////////////////
+void SocketSelector::add(Socket& socket, Trigger trigger, unsigned int interest)
 {
     SocketHandle handle = socket.getHandle();
-    if (handle != priv::SocketImpl::invalidSocket())
+    if (handle == priv::SocketImpl::invalidSocket())
+        return;
+
+#ifdef SFML_SELECTOR_EPOLL
+    if (m_impl->EpollHandle >= 0)
     {
-        FD_SET(handle, &m_impl->AllSockets);
+        epoll_event event;
+        event.events = 0;
+        if (interest & Receive)
+            event.events |= EPOLLIN;
+        if (interest & Send)
+            event.events |= EPOLLOUT;
+        if (trigger == EdgeTriggered)
+            event.events |= EPOLLET;
+        event.data.fd = handle;
+
+        // Update the registration if the socket was already added. The table may
+        // still hold a socket that was closed without being removed, and whose
+        // handle has been reused since: epoll has the final word in this case
+        int operation = m_impl->Sockets.count(handle) ? EPOLL_CTL_MOD : EPOLL_CTL_ADD;
+        int result = epoll_ctl(m_impl->EpollHandle, operation, handle, &event);
+        if ((result < 0) && (errno == ENOENT) && (operation == EPOLL_CTL_MOD))
+            result = epoll_ctl(m_impl->EpollHandle, EPOLL_CTL_ADD, handle, &event);
+        else if ((result < 0) && (errno == EEXIST) && (operation == EPOLL_CTL_ADD))
+            result = epoll_ctl(m_impl->EpollHandle, EPOLL_CTL_MOD, handle, &event);
+
+        if (result < 0)
+        {
+            err() << "Failed to add a socket to the selector (epoll_ctl error " << errno << ")" << std::endl;
+            return;
+        }
 
-        int size = static_cast<int>(handle);
-        if (size > m_impl->MaxSocket)
-            m_impl->MaxSocket = size;
+        // Forget the readiness of a stale socket that used the same handle
+        SocketSelectorImpl::SocketTable::iterator stale = m_impl->Sockets.find(handle);
+        if ((stale != m_impl->Sockets.end()) && (stale->second.socket != &socket))
+        {
+            std::vector<Socket*>::iterator it = std::find(m_impl->Ready.begin(), m_impl->Ready.end(), stale->second.socket);
+            if (it != m_impl->Ready.end())
+                m_impl->Ready.erase(it);
+            if (static_cast<std::size_t>(handle) < m_impl->ReadyFlags.size())
+                m_impl->ReadyFlags[handle] = 0;
+        }
+
+        SocketSelectorImpl::Entry entry = {&socket, trigger, interest};
+        m_impl->Sockets[handle] = entry;
+        return;
     }
+#endif
+
+    // select() can only watch a limited number of sockets
+#ifdef SFML_SYSTEM_WINDOWS
+    if (!m_impl->Sockets.count(handle) && (m_impl->Sockets.size() >= FD_SETSIZE))
+#else
+    if (handle >= FD_SETSIZE)
+#endif
+    {
+        err() << "The socket can't be added to the selector because its "
+              << "handle exceeds the limit of the select backend (FD_SETSIZE = " << FD_SETSIZE << ")" << std::endl;
+        return;
+    }
+
+    if (interest & Receive)
+        FD_SET(handle, &m_impl->AllSockets);
+    else
+        FD_CLR(handle, &m_impl->AllSockets);
+
+    if (interest & Send)
+        FD_SET(handle, &m_impl->SendSockets);
+    else
+        FD_CLR(handle, &m_impl->SendSockets);
+
+    int size = static_cast<int>(handle);
+    if (size > m_impl->MaxSocket)
+        m_impl->MaxSocket = size;
+
+    SocketSelectorImpl::Entry entry = {&socket, trigger, interest};
+    m_impl->Sockets[handle] = entry;
 }
 
 
 ////////////////////////////////////////////////////////////
 void SocketSelector::remove(Socket& socket)
 {
-    FD_CLR(socket.getHandle(), &m_impl->AllSockets);
-    FD_CLR(socket.getHandle(), &m_impl->SocketsReady);
+    SocketHandle handle = socket.getHandle();
+    if (!m_impl->Sockets.erase(handle))
+        return;
+
+    // Forget its readiness
+    std::vector<Socket*>::iterator it = std::find(m_impl->Ready.begin(), m_impl->Ready.end(), &socket);
+    if (it != m_impl->Ready.end())
+        m_impl->Ready.erase(it);
+
+#ifdef SFML_SELECTOR_EPOLL
+    if (m_impl->EpollHandle >= 0)
+    {
+        // The socket may already be closed, in which case epoll has forgotten it
+        epoll_event event = epoll_event();
+        epoll_ctl(m_impl->EpollHandle, EPOLL_CTL_DEL, handle, &event);
+        if (static_cast<std::size_t>(handle) < m_impl->ReadyFlags.size())
+            m_impl->ReadyFlags[handle] = 0;
+        return;
+    }
+#endif
+
+    FD_CLR(handle, &m_impl->AllSockets);
+    FD_CLR(handle, &m_impl->SocketsReady);
+    FD_CLR(handle, &m_impl->SendSockets);
+    FD_CLR(handle, &m_impl->SendReady);
 }
 
 
 ////////////////////////////////////////////////////////////
 void SocketSelector::clear()
 {
+#ifdef SFML_SELECTOR_EPOLL
+    if (m_impl->EpollHandle >= 0)
+    {
+        for (SocketSelectorImpl::SocketTable::const_iterator it = m_impl->Sockets.begin(); it != m_impl->Sockets.end(); ++it)
+        {
+            epoll_event event = epoll_event();
+            epoll_ctl(m_impl->EpollHandle, EPOLL_CTL_DEL, it->first, &event);
+        }
+        m_impl->ReadyFlags.clear();
+        m_impl->ReadyHandles.clear();
+    }
+#endif
+
     FD_ZERO(&m_impl->AllSockets);
     FD_ZERO(&m_impl->SocketsReady);
-
+    FD_ZERO(&m_impl->SendSockets);
+    FD_ZERO(&m_impl->SendReady);
     m_impl->MaxSocket = 0;
+
+    m_impl->Sockets.clear();
+    m_impl->Ready.clear();
 }
 
 
 ////////////////////////////////////////////////////////////
 bool SocketSelector::wait(Time timeout)
 {
+#ifdef SFML_SELECTOR_EPOLL
+    if (m_impl->EpollHandle >= 0)
+    {
+        // Forget the sockets that were ready on the previous wait; they are found by the
+        // handles saved at that time, as the sockets may have been closed or destroyed since
+        for (std::vector<SocketHandle>::const_iterator it = m_impl->ReadyHandles.begin(); it != m_impl->ReadyHandles.end(); ++it)
+        {
+            if (static_cast<std::size_t>(*it) < m_impl->ReadyFlags.size())
+                m_impl->ReadyFlags[*it] = 0;
+        }
+        m_impl->ReadyHandles.clear();
+        m_impl->Ready.clear();
+
+        // Round the timeout up to the next millisecond, so that a short timeout doesn't become a poll
+        int milliseconds = -1;
+        if (timeout != Time::Zero)
+            milliseconds = static_cast<int>((timeout.asMicroseconds() + 999) / 1000);
+
+        // The buffer only needs to hold the events of one wake-up; events
+        // that don't fit are kept by the kernel for the next wait
+        std::size_t capacity = std::min<std::size_t>(std::max<std::size_t>(m_impl->Sockets.size(), 1), 1024);
+        if (m_impl->Events.size() != capacity)
+            m_impl->Events.resize(capacity);
+
+        int count = epoll_wait(m_impl->EpollHandle, &m_impl->Events[0], static_cast<int>(capacity), milliseconds);
+
+        for (int i = 0; i < count; ++i)
+        {
+            SocketHandle handle = m_impl->Events[i].data.fd;
+            SocketSelectorImpl::SocketTable::const_iterator it = m_impl->Sockets.find(handle);
+            if (it == m_impl->Sockets.end())
+                continue;
+
+            // Errors and hang-ups are reported as every watched readiness,
+            // so that the next receive or send reports them
+            Uint32 events = m_impl->Events[i].events;
+            unsigned char flags = 0;
+            if (events & (EPOLLERR | EPOLLHUP))
+                flags = static_cast<unsigned char>(it->second.interest);
+            if (events & EPOLLIN)
+                flags |= Receive;
+            if (events & EPOLLOUT)
+                flags |= Send;
+
+            if (static_cast<std::size_t>(handle) >= m_impl->ReadyFlags.size())
+                m_impl->ReadyFlags.resize(handle + 1, 0);
+            m_impl->ReadyFlags[handle] = flags;
+            m_impl->ReadyHandles.push_back(handle);
+            m_impl->Ready.push_back(it->second.socket);
+        }
+
+        return !m_impl->Ready.empty();
+    }
+#endif
+
     // Setup the timeout
     timeval time;
     time.tv_sec  = static_cast<long>(timeout.asMicroseconds() / 1000000);
     time.tv_usec = static_cast<long>(timeout.asMicroseconds() % 1000000);
 
-    // Initialize the set that will contain the sockets that are ready
+    // Initialize the sets that will contain the sockets that are ready
     m_impl->SocketsReady = m_impl->AllSockets;
+    m_impl->SendReady = m_impl->SendSockets;
 
-    // Wait until one of the sockets is ready for reading, or timeout is reached
-    int count = select(m_impl->MaxSocket + 1, &m_impl->SocketsReady, NULL, NULL, timeout != Time::Zero ? &time : NULL);
+    // Wait until one of the sockets is ready for reading or writing, or timeout is reached
+    int count = select(m_impl->MaxSocket + 1, &m_impl->SocketsReady, &m_impl->SendReady, NULL, timeout != Time::Zero ? &time : NULL);
+
+    // Build the list of ready sockets
+    m_impl->Ready.clear();
+    if (count > 0)
+    {
+        for (SocketSelectorImpl::SocketTable::const_iterator it = m_impl->Sockets.begin(); it != m_impl->Sockets.end(); ++it)
+        {
+            if (FD_ISSET(it->first, &m_impl->SocketsReady) || FD_ISSET(it->first, &m_impl->SendReady))
+                m_impl->Ready.push_back(it->second.socket);
+        }
+    }
 
     return count > 0;
 }
@@ -124,10 +357,52 @@ bool SocketSelector::wait(Time timeout)
 ////////////////////////////////////////////////////////////
 bool SocketSelector::isReady(Socket& socket) const
 {
+#ifdef SFML_SELECTOR_EPOLL
+    if (m_impl->EpollHandle >= 0)
+    {
+        std::size_t handle = static_cast<std::size_t>(socket.getHandle());
+        return (handle < m_impl->ReadyFlags.size()) && (m_impl->ReadyFlags[handle] & Receive);
+    }
+#endif
+
     return FD_ISSET(socket.getHandle(), &m_impl->SocketsReady) != 0;
 }
 
 
+////////////////////////////////////////////////////////////
+bool SocketSelector::isReadyToSend(Socket& socket) const
+{
+#ifdef SFML_SELECTOR_EPOLL
+    if (m_impl->EpollHandle >= 0)
+    {
+        std::size_t handle = static_cast<std::size_t>(socket.getHandle());
+        return (handle < m_impl->ReadyFlags.size()) && (m_impl->ReadyFlags[handle] & Send);
+    }
+#endif
+
+    return FD_ISSET(socket.getHandle(), &m_impl->SendReady) != 0;
+}
+
+
+////////////////////////////////////////////////////////////
+const std::vector<Socket*>& SocketSelector::getReadySockets() const
+{
+    return m_impl->Ready;
+}
+
+
+////////////////////////////////////////////////////////////
+SocketSelector::Backend SocketSelector::getBackend() const
+{
+#ifdef SFML_SELECTOR_EPOLL
+    if (m_impl->EpollHandle >= 0)
+        return Epoll;
+#endif
+
+    return Select;
+}
+
+
 ////////////////////////////////////////////////////////////
 SocketSelector& SocketSelector::operator =(const SocketSelector& right)
 {
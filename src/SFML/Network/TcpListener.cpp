@@ -75,8 +75,8 @@ Socket::Status TcpListener::listen(unsigned short port)
         return Error;
     }
 
-    // Listen to the bound port
-    if (::listen(getHandle(), 0) == -1)
+    // Listen to the bound port, letting the system queue as many pending connections as it allows
+    if (::listen(getHandle(), SOMAXCONN) == -1)
     {
         // Oops, socket is deaf
         err() << "Failed to listen to port " << port << std::endl;
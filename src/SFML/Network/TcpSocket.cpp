@@ -46,13 +46,20 @@ namespace
     #else
         const int flags = 0;
     #endif
+
+    // Maximum number of bytes of packet data read by a single system call
+    const std::size_t maxReceiveChunk = 65536;
 }
 
 namespace sf
 {
 ////////////////////////////////////////////////////////////
 TcpSocket::TcpSocket() :
-Socket(Tcp)
+Socket        (Tcp),
+m_buffered    (false),
+m_flushSize   (16384),
+m_flushDelay  (Time::Zero),
+m_sendPosition(0)
 {
 
 }
@@ -208,7 +215,11 @@ Socket::Status TcpSocket::connect(const IpAddress& remoteAddress, unsigned short
 ////////////////////////////////////////////////////////////
 void TcpSocket::disconnect()
 {
-    // Close the socket
+    // Write what remains in the output buffer, then close the socket
+    if ((getQueuedBytes() > 0) && (getHandle() != priv::SocketImpl::invalidSocket()))
+        flush();
+    m_sendBuffer.clear();
+    m_sendPosition = 0;
     close();
 
     // Reset the pending packet data
@@ -226,6 +237,10 @@ Socket::Status TcpSocket::send(const void* data, std::size_t size)
         return Error;
     }
 
+    // In buffered mode, or if older data is still queued, append the data to the output queue
+    if (m_buffered || (getQueuedBytes() > 0))
+        return bufferData(NULL, 0, data, size);
+
     // Loop until every byte has been sent
     int sent = 0;
     int sizeToSend = static_cast<int>(size);
@@ -236,7 +251,21 @@ Socket::Status TcpSocket::send(const void* data, std::size_t size)
 
         // Check for errors
         if (sent < 0)
-            return priv::SocketImpl::getErrorStatus();
+        {
+            Status status = recordStatus(priv::SocketImpl::getErrorStatus());
+
+            // If the socket would block, queue what remains instead of dropping it
+            if (status == NotReady)
+            {
+                appendData(NULL, 0, data, size);
+                m_sendPosition = static_cast<std::size_t>(length);
+                return Done;
+            }
+
+            return status;
+        }
+
+        recordSend(static_cast<std::size_t>(sizeToSend - length), static_cast<std::size_t>(sent));
     }
 
     return Done;
@@ -263,6 +292,7 @@ Socket::Status TcpSocket::receive(void* data, std::size_t size, std::size_t& rec
     if (sizeReceived > 0)
     {
         received = static_cast<std::size_t>(sizeReceived);
+        recordReceive(received);
         return Done;
     }
     else if (sizeReceived == 0)
@@ -271,7 +301,7 @@ Socket::Status TcpSocket::receive(void* data, std::size_t size, std::size_t& rec
     }
     else
     {
-        return priv::SocketImpl::getErrorStatus();
+        return recordStatus(priv::SocketImpl::getErrorStatus());
     }
 }
 
@@ -283,28 +313,64 @@ Socket::Status TcpSocket::send(Packet& packet)
     // This means that we have to send the packet size first, so that the
     // receiver knows the actual end of the packet in the data stream.
 
-    // We allocate an extra memory block so that the size can be sent
-    // together with the data in a single call. This may seem inefficient,
-    // but it is actually required to avoid partial send, which could cause
-    // data corruption on the receiving end.
+    // The size and the data are sent together with a single gathering
+    // call, which avoids both copying them into a temporary block and
+    // sending a tiny segment for the size alone.
 
     // Get the data to send from the packet
     std::size_t size = 0;
-    const void* data = packet.onSend(size);
+    const char* data = static_cast<const char*>(packet.onSend(size));
 
     // First convert the packet size to network byte order
     Uint32 packetSize = htonl(static_cast<Uint32>(size));
- 
-    // Allocate memory for the data block to send
-    std::vector<char> blockToSend(sizeof(packetSize) + size);
- 
-    // Copy the packet size and data into the block to send
-    std::memcpy(&blockToSend[0], &packetSize, sizeof(packetSize));
-    if (size > 0)
-        std::memcpy(&blockToSend[0] + sizeof(packetSize), data, size);
-
-    // Send the data block
-    return send(&blockToSend[0], blockToSend.size());
+    const char* header = reinterpret_cast<const char*>(&packetSize);
+
+    // In buffered mode, or if older data is still queued, append the size and the data to the output queue
+    if (m_buffered || (getQueuedBytes() > 0))
+    {
+        Status status = bufferData(header, sizeof(packetSize), data, size);
+        if (status == Done)
+            recordPackets(1, 0);
+        return status;
+    }
+
+    // Loop until every byte has been sent
+    std::size_t total = sizeof(packetSize) + size;
+    std::size_t length = 0;
+    while (length < total)
+    {
+        // Send what remains of the size and the data
+        int sent;
+        if (length < sizeof(packetSize))
+            sent = priv::SocketImpl::sendGather(getHandle(), header + length, sizeof(packetSize) - length, data, size, flags);
+        else
+            sent = ::send(getHandle(), data + (length - sizeof(packetSize)), static_cast<int>(total - length), flags);
+
+        // Check for errors
+        if (sent < 0)
+        {
+            Status status = recordStatus(priv::SocketImpl::getErrorStatus());
+
+            // If the socket would block, queue what remains of the packet instead
+            // of dropping it: a half-sent packet would corrupt the stream
+            if (status == NotReady)
+            {
+                appendData(header, sizeof(packetSize), data, size);
+                m_sendPosition = length;
+                recordPackets(1, 0);
+                return Done;
+            }
+
+            return status;
+        }
+
+        recordSend(total - length, static_cast<std::size_t>(sent));
+        length += static_cast<std::size_t>(sent);
+    }
+
+    recordPackets(1, 0);
+
+    return Done;
 }
 
 
@@ -341,30 +407,137 @@ Socket::Status TcpSocket::receive(Packet& packet)
     }
 
     // Loop until we receive all the packet data
-    char buffer[1024];
-    while (m_pendingPacket.Data.size() < packetSize)
+    std::vector<char>& buffer = m_pendingPacket.Data;
+    while (buffer.size() < packetSize)
     {
-        // Receive a chunk of data
-        std::size_t sizeToGet = std::min(static_cast<std::size_t>(packetSize - m_pendingPacket.Data.size()), sizeof(buffer));
-        Status status = receive(buffer, sizeToGet, received);
+        // Receive a chunk of data directly at the end of the pending buffer
+        std::size_t start = buffer.size();
+        std::size_t sizeToGet = std::min(static_cast<std::size_t>(packetSize - start), maxReceiveChunk);
+        buffer.resize(start + sizeToGet);
+        Status status = receive(&buffer[start], sizeToGet, received);
+        buffer.resize(start + received);
         if (status != Done)
             return status;
+    }
+
+    // We have received all the packet data: hand it over to the user packet
+    recordPackets(0, 1);
+    recordBufferSizes(0, buffer.size());
+    if (!buffer.empty())
+        packet.receiveBuffer(buffer);
+
+    // Clear the pending packet data, but keep the buffer memory for the next packet
+    m_pendingPacket.Size = 0;
+    m_pendingPacket.SizeReceived = 0;
+    buffer.clear();
+
+    return Done;
+}
+
+
+////////////////////////////////////////////////////////////
+void TcpSocket::setNoDelay(bool noDelay)
+{
+    setNoDelayOption(noDelay);
+}
+
+
+////////////////////////////////////////////////////////////
+bool TcpSocket::setCork(bool cork)
+{
+    return setCorkOption(cork);
+}
+
+
+////////////////////////////////////////////////////////////
+void TcpSocket::setBuffered(bool buffered, std::size_t flushSize, Time flushDelay)
+{
+    // Don't leave data behind when leaving the buffered mode
+    if (m_buffered && !buffered && (getQueuedBytes() > 0))
+        flush();
+
+    m_buffered   = buffered;
+    m_flushSize  = flushSize;
+    m_flushDelay = flushDelay;
+}
+
+
+////////////////////////////////////////////////////////////
+bool TcpSocket::isBuffered() const
+{
+    return m_buffered;
+}
+
+
+////////////////////////////////////////////////////////////
+std::size_t TcpSocket::getQueuedBytes() const
+{
+    return m_sendBuffer.size() - m_sendPosition;
+}
+
+
+////////////////////////////////////////////////////////////
+Socket::Status TcpSocket::flush()
+{
+    // Loop until every queued byte has been sent
+    while (m_sendPosition < m_sendBuffer.size())
+    {
+        std::size_t remaining = m_sendBuffer.size() - m_sendPosition;
+        int sent = ::send(getHandle(), &m_sendBuffer[m_sendPosition], static_cast<int>(remaining), flags);
 
-        // Append it into the packet
-        if (received > 0)
+        // Check for errors, and remember what was sent for the next call
+        if (sent < 0)
         {
-            m_pendingPacket.Data.resize(m_pendingPacket.Data.size() + received);
-            char* begin = &m_pendingPacket.Data[0] + m_pendingPacket.Data.size() - received;
-            std::memcpy(begin, buffer, received);
+            // Drop the sent bytes once they make up most of the queue, so that
+            // partial sends don't move the whole queue every time
+            if (m_sendPosition > m_sendBuffer.size() / 2)
+            {
+                m_sendBuffer.erase(m_sendBuffer.begin(), m_sendBuffer.begin() + m_sendPosition);
+                m_sendPosition = 0;
+            }
+
+            return recordStatus(priv::SocketImpl::getErrorStatus());
         }
+
+        recordSend(remaining, static_cast<std::size_t>(sent));
+        m_sendPosition += static_cast<std::size_t>(sent);
     }
 
-    // We have received all the packet data: we can copy it to the user packet
-    if (!m_pendingPacket.Data.empty())
-        packet.onReceive(&m_pendingPacket.Data[0], m_pendingPacket.Data.size());
+    // Everything was sent: keep the memory for the next data
+    m_sendBuffer.clear();
+    m_sendPosition = 0;
 
-    // Clear the pending packet data
-    m_pendingPacket = PendingPacket();
+    return Done;
+}
+
+
+////////////////////////////////////////////////////////////
+void TcpSocket::appendData(const char* header, std::size_t headerSize, const void* data, std::size_t size)
+{
+    // Start measuring the age of the queued data with its first bytes
+    if (getQueuedBytes() == 0)
+        m_bufferClock.restart();
+
+    const char* begin = static_cast<const char*>(data);
+    m_sendBuffer.insert(m_sendBuffer.end(), header, header + headerSize);
+    m_sendBuffer.insert(m_sendBuffer.end(), begin, begin + size);
+
+    recordBufferSizes(getQueuedBytes(), 0);
+}
+
+
+////////////////////////////////////////////////////////////
+Socket::Status TcpSocket::bufferData(const char* header, std::size_t headerSize, const void* data, std::size_t size)
+{
+    appendData(header, headerSize, data, size);
+
+    // Write the queue right away if the socket is not buffered, or if the queue is big or old enough
+    if (!m_buffered || (getQueuedBytes() >= m_flushSize) || ((m_flushDelay > Time::Zero) && (m_bufferClock.getElapsedTime() >= m_flushDelay)))
+    {
+        // If the socket would block, the data stays queued and is sent by the next calls
+        Status status = flush();
+        return status == NotReady ? Done : status;
+    }
 
     return Done;
 }
@@ -32,6 +32,35 @@
 #include <SFML/System/Err.hpp>
 #include <algorithm>
 
+#ifdef SFML_SYSTEM_LINUX
+    #include <cstring>
+#endif
+
+
+namespace
+{
+    // Maximum number of datagrams passed to the system in a single batched call
+    const std::size_t maxBatchSize = 64;
+
+#ifndef SFML_SYSTEM_LINUX
+
+    // Check whether a datagram can be received without blocking
+    bool isReadyToReceive(sf::SocketHandle handle)
+    {
+        fd_set selector;
+        FD_ZERO(&selector);
+        FD_SET(handle, &selector);
+
+        timeval time;
+        time.tv_sec  = 0;
+        time.tv_usec = 0;
+
+        return select(static_cast<int>(handle + 1), &selector, NULL, NULL, &time) > 0;
+    }
+
+#endif
+}
+
 
 namespace sf
 {
@@ -111,7 +140,10 @@ Socket::Status UdpSocket::send(const void* data, std::size_t size, const IpAddre
 
     // Check for errors
     if (sent < 0)
-        return priv::SocketImpl::getErrorStatus();
+        return recordStatus(priv::SocketImpl::getErrorStatus());
+
+    recordSend(size, static_cast<std::size_t>(sent));
+    recordPackets(1, 0);
 
     return Done;
 }
@@ -141,10 +173,12 @@ Socket::Status UdpSocket::receive(void* data, std::size_t size, std::size_t& rec
 
     // Check for errors
     if (sizeReceived < 0)
-        return priv::SocketImpl::getErrorStatus();
+        return recordStatus(priv::SocketImpl::getErrorStatus());
 
     // Fill the sender informations
     received      = static_cast<std::size_t>(sizeReceived);
+    recordReceive(received);
+    recordPackets(0, 1);
     remoteAddress = IpAddress(ntohl(address.sin_addr.s_addr));
     remotePort    = ntohs(address.sin_port);
 
@@ -190,4 +224,292 @@ Socket::Status UdpSocket::receive(Packet& packet, IpAddress& remoteAddress, unsi
 }
 
 
+////////////////////////////////////////////////////////////
+Socket::Status UdpSocket::send(BatchEntry* entries, std::size_t count, std::size_t& sent)
+{
+    // First clear the variables to fill
+    sent = 0;
+
+    // Check the parameters
+    if (!entries || (count == 0))
+    {
+        err() << "Cannot send data over the network (no packet to send)" << std::endl;
+        return Error;
+    }
+
+#ifdef SFML_SYSTEM_LINUX
+
+    // Create the internal socket if it doesn't exist
+    create();
+
+    mmsghdr     messages[maxBatchSize];
+    iovec       buffers[maxBatchSize];
+    sockaddr_in addresses[maxBatchSize];
+
+    while (sent < count)
+    {
+        // Describe the next chunk of datagrams
+        std::size_t chunkSize = std::min(count - sent, maxBatchSize);
+        for (std::size_t i = 0; i < chunkSize; ++i)
+        {
+            BatchEntry& entry = entries[sent + i];
+            if (!entry.packet)
+            {
+                err() << "Cannot send data over the network (invalid packet in batch)" << std::endl;
+                chunkSize = i;
+                break;
+            }
+
+            std::size_t size = 0;
+            const void* data = entry.packet->onSend(size);
+            if (size > MaxDatagramSize)
+            {
+                err() << "Cannot send data over the network "
+                      << "(the number of bytes to send is greater than sf::UdpSocket::MaxDatagramSize)" << std::endl;
+                chunkSize = i;
+                break;
+            }
+
+            addresses[i] = priv::SocketImpl::createAddress(entry.remoteAddress.toInteger(), entry.remotePort);
+            buffers[i].iov_base = const_cast<void*>(data);
+            buffers[i].iov_len  = size;
+            std::memset(&messages[i], 0, sizeof(messages[i]));
+            messages[i].msg_hdr.msg_name    = &addresses[i];
+            messages[i].msg_hdr.msg_namelen = sizeof(addresses[i]);
+            messages[i].msg_hdr.msg_iov     = &buffers[i];
+            messages[i].msg_hdr.msg_iovlen  = 1;
+        }
+
+        // Stop at an invalid entry
+        if (chunkSize == 0)
+            return Error;
+
+        // Send them
+        int result = sendmmsg(getHandle(), messages, static_cast<unsigned int>(chunkSize), 0);
+        if (result < 0)
+            return recordStatus(priv::SocketImpl::getErrorStatus());
+
+        for (int i = 0; i < result; ++i)
+            recordSend(buffers[i].iov_len, messages[i].msg_len);
+        recordPackets(static_cast<std::size_t>(result), 0);
+        sent += static_cast<std::size_t>(result);
+    }
+
+#else
+
+    // No batched system call: send the packets one by one
+    for (; sent < count; ++sent)
+    {
+        BatchEntry& entry = entries[sent];
+        if (!entry.packet)
+        {
+            err() << "Cannot send data over the network (invalid packet in batch)" << std::endl;
+            return Error;
+        }
+
+        Status status = send(*entry.packet, entry.remoteAddress, entry.remotePort);
+        if (status != Done)
+            return status;
+    }
+
+#endif
+
+    return Done;
+}
+
+
+////////////////////////////////////////////////////////////
+Socket::Status UdpSocket::receive(BatchEntry* entries, std::size_t count, std::size_t& received)
+{
+    // First clear the variables to fill
+    received = 0;
+
+    // Check the parameters
+    if (!entries || (count == 0))
+    {
+        err() << "Cannot receive data from the network (no packet to fill)" << std::endl;
+        return Error;
+    }
+    for (std::size_t i = 0; i < count; ++i)
+    {
+        if (!entries[i].packet)
+        {
+            err() << "Cannot receive data from the network (invalid packet in batch)" << std::endl;
+            return Error;
+        }
+    }
+
+#ifdef SFML_SYSTEM_LINUX
+
+    // Allocate the ring of buffers once, datagrams are received directly into it
+    std::size_t ringSize = std::min(count, maxBatchSize);
+    if (m_batchBuffer.size() < ringSize * MaxDatagramSize)
+        m_batchBuffer.resize(ringSize * MaxDatagramSize);
+
+    mmsghdr     messages[maxBatchSize];
+    iovec       buffers[maxBatchSize];
+    sockaddr_in addresses[maxBatchSize];
+
+    while (received < count)
+    {
+        // Describe the next chunk of datagrams
+        std::size_t chunkSize = std::min(count - received, maxBatchSize);
+        for (std::size_t i = 0; i < chunkSize; ++i)
+        {
+            buffers[i].iov_base = &m_batchBuffer[i * MaxDatagramSize];
+            buffers[i].iov_len  = MaxDatagramSize;
+            std::memset(&messages[i], 0, sizeof(messages[i]));
+            messages[i].msg_hdr.msg_name    = &addresses[i];
+            messages[i].msg_hdr.msg_namelen = sizeof(addresses[i]);
+            messages[i].msg_hdr.msg_iov     = &buffers[i];
+            messages[i].msg_hdr.msg_iovlen  = 1;
+        }
+
+        // Only the very first datagram may be waited for (in blocking mode)
+        int flags = (received == 0) ? MSG_WAITFORONE : MSG_DONTWAIT;
+        int result = recvmmsg(getHandle(), messages, static_cast<unsigned int>(chunkSize), flags, NULL);
+        if (result < 0)
+        {
+            if (received == 0)
+                return recordStatus(priv::SocketImpl::getErrorStatus());
+            break;
+        }
+
+        // Fill the user packets
+        for (int i = 0; i < result; ++i)
+        {
+            BatchEntry& entry = entries[received + i];
+            entry.packet->clear();
+            if (messages[i].msg_len > 0)
+                entry.packet->onReceive(buffers[i].iov_base, messages[i].msg_len);
+            entry.remoteAddress = IpAddress(ntohl(addresses[i].sin_addr.s_addr));
+            entry.remotePort    = ntohs(addresses[i].sin_port);
+            recordReceive(messages[i].msg_len);
+        }
+        recordPackets(0, static_cast<std::size_t>(result));
+        received += static_cast<std::size_t>(result);
+
+        // No more datagrams are queued
+        if (static_cast<std::size_t>(result) < chunkSize)
+            break;
+    }
+
+#else
+
+    // No batched system call: receive the packets one by one, the first
+    // one with the socket's blocking mode and the others only if available
+    while (received < count)
+    {
+        if ((received > 0) && !isReadyToReceive(getHandle()))
+            break;
+
+        BatchEntry& entry = entries[received];
+        Status status = receive(*entry.packet, entry.remoteAddress, entry.remotePort);
+        if (status != Done)
+        {
+            if (received == 0)
+                return status;
+            break;
+        }
+
+        ++received;
+    }
+
+#endif
+
+    return Done;
+}
+
+
+////////////////////////////////////////////////////////////
+Socket::Status UdpSocket::joinMulticastGroup(const IpAddress& group, const IpAddress& interfaceAddress)
+{
+    // Create the internal socket if it doesn't exist
+    create();
+
+    ip_mreq request;
+    request.imr_multiaddr.s_addr = htonl(group.toInteger());
+    request.imr_interface.s_addr = htonl(interfaceAddress.toInteger());
+    if (setsockopt(getHandle(), IPPROTO_IP, IP_ADD_MEMBERSHIP, reinterpret_cast<char*>(&request), sizeof(request)) == -1)
+    {
+        err() << "Failed to join multicast group " << group.toString() << std::endl;
+        return Error;
+    }
+
+    return Done;
+}
+
+
+////////////////////////////////////////////////////////////
+Socket::Status UdpSocket::leaveMulticastGroup(const IpAddress& group, const IpAddress& interfaceAddress)
+{
+    if (getHandle() == priv::SocketImpl::invalidSocket())
+        return Error;
+
+    ip_mreq request;
+    request.imr_multiaddr.s_addr = htonl(group.toInteger());
+    request.imr_interface.s_addr = htonl(interfaceAddress.toInteger());
+    if (setsockopt(getHandle(), IPPROTO_IP, IP_DROP_MEMBERSHIP, reinterpret_cast<char*>(&request), sizeof(request)) == -1)
+    {
+        err() << "Failed to leave multicast group " << group.toString() << std::endl;
+        return Error;
+    }
+
+    return Done;
+}
+
+
+////////////////////////////////////////////////////////////
+Socket::Status UdpSocket::setMulticastTtl(unsigned int ttl)
+{
+    // Create the internal socket if it doesn't exist
+    create();
+
+    // Windows expects a DWORD, other systems (BSD and Mac OS X strictly) an unsigned char
+    #if defined(SFML_SYSTEM_WINDOWS)
+        DWORD value = std::min(ttl, 255u);
+    #else
+        unsigned char value = static_cast<unsigned char>(std::min(ttl, 255u));
+    #endif
+    if (setsockopt(getHandle(), IPPROTO_IP, IP_MULTICAST_TTL, reinterpret_cast<char*>(&value), sizeof(value)) == -1)
+    {
+        err() << "Failed to set socket option \"IP_MULTICAST_TTL\"" << std::endl;
+        return Error;
+    }
+
+    return Done;
+}
+
+
+////////////////////////////////////////////////////////////
+Socket::Status UdpSocket::setMulticastLoopback(bool enabled)
+{
+    // Create the internal socket if it doesn't exist
+    create();
+
+    #if defined(SFML_SYSTEM_WINDOWS)
+        DWORD value = enabled ? 1 : 0;
+    #else
+        unsigned char value = enabled ? 1 : 0;
+    #endif
+    if (setsockopt(getHandle(), IPPROTO_IP, IP_MULTICAST_LOOP, reinterpret_cast<char*>(&value), sizeof(value)) == -1)
+    {
+        err() << "Failed to set socket option \"IP_MULTICAST_LOOP\"" << std::endl;
+        return Error;
+    }
+
+    return Done;
+}
+
+
+////////////////////////////////////////////////////////////
+UdpSocket::BatchEntry::BatchEntry() :
+packet       (NULL),
+remoteAddress(),
+remotePort   (0)
+{
+
+}
+
+
 } // namespace sf
@@ -99,6 +99,25 @@ Socket::Status SocketImpl::getErrorStatus()
     }
 }
 
+
+////////////////////////////////////////////////////////////
+int SocketImpl::sendGather(SocketHandle sock, const void* first, std::size_t firstSize, const void* second, std::size_t secondSize, int flags)
+{
+    iovec buffers[2];
+    buffers[0].iov_base = const_cast<void*>(first);
+    buffers[0].iov_len  = firstSize;
+    buffers[1].iov_base = const_cast<void*>(second);
+    buffers[1].iov_len  = secondSize;
+
+    // Use sendmsg rather than writev, so that the flags (like MSG_NOSIGNAL) still apply
+    msghdr message;
+    std::memset(&message, 0, sizeof(message));
+    message.msg_iov    = buffers;
+    message.msg_iovlen = (second && (secondSize > 0)) ? 2 : 1;
+
+    return static_cast<int>(sendmsg(sock, &message, flags));
+}
+
 } // namespace priv
 
 } // namespace sf
@@ -86,6 +86,24 @@ Socket::Status SocketImpl::getErrorStatus()
 }
 
 
+////////////////////////////////////////////////////////////
+int SocketImpl::sendGather(SocketHandle sock, const void* first, std::size_t firstSize, const void* second, std::size_t secondSize, int flags)
+{
+    WSABUF buffers[2];
+    buffers[0].buf = static_cast<char*>(const_cast<void*>(first));
+    buffers[0].len = static_cast<ULONG>(firstSize);
+    buffers[1].buf = static_cast<char*>(const_cast<void*>(second));
+    buffers[1].len = static_cast<ULONG>(secondSize);
+
+    DWORD count = (second && (secondSize > 0)) ? 2 : 1;
+    DWORD sent = 0;
+    if (WSASend(sock, buffers, count, &sent, static_cast<DWORD>(flags), NULL, NULL) == SOCKET_ERROR)
+        return -1;
+
+    return static_cast<int>(sent);
+}
+
+
 ////////////////////////////////////////////////////////////
 // Windows needs some initialization and cleanup to get
 // sockets working properly... so let's create a class that will
@@ -102,6 +102,23 @@ public :
     ///
     ////////////////////////////////////////////////////////////
     static Socket::Status getErrorStatus();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Send two buffers with a single gathering system call
+    ///
+    /// Like send, the function may send only part of the data.
+    ///
+    /// \param sock       Handle of the socket
+    /// \param first      First buffer to send
+    /// \param firstSize  Size of the first buffer, in bytes
+    /// \param second     Second buffer to send (can be NULL)
+    /// \param secondSize Size of the second buffer, in bytes
+    /// \param flags      Flags of the send operation
+    ///
+    /// \return Number of bytes sent, or -1 on error
+    ///
+    ////////////////////////////////////////////////////////////
+    static int sendGather(SocketHandle sock, const void* first, std::size_t firstSize, const void* second, std::size_t secondSize, int flags);
 };
 
 } // namespace priv
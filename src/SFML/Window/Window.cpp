@@ -332,6 +332,9 @@ bool Window::setActive(bool active) const
 ////////////////////////////////////////////////////////////
 void Window::display()
 {
+    // Notify the derived class that the frame is complete
+    onDisplay();
+
     // Display the backbuffer on screen
     if (setActive())
         m_context->display();
@@ -366,6 +369,13 @@ void Window::onResize()
 }
 
 
+////////////////////////////////////////////////////////////
+void Window::onDisplay()
+{
+    // Nothing by default
+}
+
+
 ////////////////////////////////////////////////////////////
 bool Window::filterEvent(const Event& event)
 {